@@ -29,8 +29,10 @@
 #include <Python.h>
 #include <emu/emu.h>
 #include <emu/emu_shellcode.h>
+#include <emu/emu_pool.h>
 
 #include <stdio.h>
+#include <stdlib.h>
 
 
 typedef struct
@@ -40,6 +42,10 @@ typedef struct
 	struct emu * emulator;
 } libemu_EmulatorObject;
 
+/* Emulator objects are often created for a single buffer, reuse the emus */
+#define LIBEMU_POOL_SIZE 16
+static struct emu_pool * pool;
+
 
 
 static PyObject * libemu_Emulator_new(PyTypeObject * type, PyObject * args,
@@ -51,7 +57,7 @@ static PyObject * libemu_Emulator_new(PyTypeObject * type, PyObject * args,
 	
 	if(self)
 	{
-		self->emulator = emu_new();
+		self->emulator = emu_pool_get(pool);
 		
 		if(!self->emulator)
 		{
@@ -67,7 +73,7 @@ static void libemu_Emulator_dealloc(libemu_EmulatorObject * self)
 {
 	if(self->emulator)
 	{
-		emu_free(self->emulator);
+		emu_pool_put(pool, self->emulator);
 		self->emulator = 0;
 	}
 
@@ -94,11 +100,88 @@ static PyObject * libemu_Emulator_test(libemu_EmulatorObject * self,
 	return Py_BuildValue("i", result);
 }
 
+static PyObject * libemu_Emulator_test_batch(libemu_EmulatorObject * self,
+	PyObject * args, PyObject * kwds)
+{
+	PyObject * buffers, * seq, * list = NULL;
+	uint8_t ** bufs;
+	uint32_t * lens;
+	struct emu_shellcode_result * results;
+	Py_ssize_t n, i;
+	int32_t tested;
+
+	if(!PyArg_ParseTuple(args, "O", &buffers))
+		return NULL;
+
+	if(!self->emulator)
+		return NULL;
+
+	seq = PySequence_Fast(buffers, "expected a sequence of buffers");
+	if(!seq)
+		return NULL;
+
+	n = PySequence_Fast_GET_SIZE(seq);
+	bufs = malloc((n + 1) * sizeof(uint8_t *));
+	lens = malloc((n + 1) * sizeof(uint32_t));
+	results = malloc((n + 1) * sizeof(struct emu_shellcode_result));
+
+	if(!bufs || !lens || !results)
+	{
+		PyErr_NoMemory();
+		goto out;
+	}
+
+	for(i = 0; i < n; i++)
+	{
+		char * buffer;
+		Py_ssize_t length;
+
+		if(PyString_AsStringAndSize(PySequence_Fast_GET_ITEM(seq, i),
+			&buffer, &length) == -1)
+			goto out;
+
+		bufs[i] = (uint8_t *) buffer;
+		lens[i] = length;
+	}
+
+	tested = emu_shellcode_test_batch(self->emulator, bufs, lens, n, results);
+
+	list = PyList_New(n);
+	if(!list)
+		goto out;
+
+	for(i = 0; i < n; i++)
+	{
+		PyObject * item;
+
+		if(i < tested && results[i].offset != -1)
+			item = PyInt_FromLong(results[i].offset);
+		else
+		{
+			Py_INCREF(Py_None);
+			item = Py_None;
+		}
+
+		PyList_SET_ITEM(list, i, item);
+	}
+
+out:
+	free(bufs);
+	free(lens);
+	free(results);
+	Py_DECREF(seq);
+
+	return list;
+}
+
 
 
 static PyMethodDef libemu_EmulatorMethods[] = {
 	{ "test", (PyCFunction) libemu_Emulator_test, METH_VARARGS,
 		"Test a given buffer for presenced of a shellcode." },
+	{ "test_batch", (PyCFunction) libemu_Emulator_test_batch, METH_VARARGS,
+		"Test a sequence of buffers for shellcodes, returns a list of the "
+		"offsets, None for the buffers without a shellcode." },
 	{ NULL, NULL, 0, NULL },
 };
 
@@ -156,6 +239,10 @@ PyMODINIT_FUNC initlibemu()
 	if(PyType_Ready(&libemu_EmulatorType) < 0)
 		return;
 	
+	pool = emu_pool_new(LIBEMU_POOL_SIZE);
+	if(!pool)
+		return;
+	
 	module = Py_InitModule3("libemu", LibemuMethods,
 		"libemu x86 emulator wrapper module");
 	
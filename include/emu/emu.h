@@ -40,6 +40,9 @@
 #endif
 
 
+/* instructions between two checks for emu_cancel and the deadline */
+#define EMU_INTERRUPT_INTERVAL 1024
+
 struct emu;
 struct emu_logging;
 struct emu_cpu;
@@ -49,6 +52,10 @@ struct emu_fpu;
 /**
  * Create a new emu.
  * 
+ * libemu has no process-global mutable state, an emu and everything
+ * created from it may only be used by one thread at a time, different
+ * emus may be used from different threads concurrently.
+ * 
  * @return on success: the new emu
  *         on failure: NULL
  */
@@ -61,6 +68,56 @@ struct emu *emu_new(void);
  */
 void emu_free(struct emu *e);
 
+/**
+ * Put the emu back into the state emu_new leaves it in, without
+ * allocating anything again: the memory is unmapped, the breakpoints are
+ * removed, the cpu and the logging are reset and the error is cleared.
+ * Environments created for the emu have to be freed before.
+ * 
+ * @param e      the emu to reset
+ */
+void emu_reset(struct emu *e);
+
+/**
+ * Cancel the current and all later runs of the emu, until
+ * emu_interrupt_clear is called. This is the only function which may be
+ * called from another thread while the emu is in use.
+ * 
+ * The cpu checks emu_interrupted every EMU_INTERRUPT_INTERVAL
+ * instructions, emu_cpu_parse fails once the emu got interrupted.
+ * 
+ * @param e      the emu
+ */
+void emu_cancel(struct emu *e);
+
+/**
+ * Interrupt the runs of the emu once msec milliseconds have passed,
+ * measured on the monotonic clock.
+ * 
+ * @param e      the emu
+ * @param msec   the time from now, 0 removes the deadline
+ */
+void emu_deadline_set(struct emu *e, uint32_t msec);
+
+/**
+ * Remove the cancellation and the deadline.
+ * 
+ * @param e      the emu
+ */
+void emu_interrupt_clear(struct emu *e);
+
+/**
+ * Check if the emu got cancelled or ran past its deadline, set the errno
+ * and strerror if it did.
+ * 
+ * @param e      the emu
+ * 
+ * @return 0 if the run may go on,
+ *         ECANCELED if emu_cancel was called,
+ *         ETIMEDOUT if the deadline passed
+ */
+int emu_interrupted(struct emu *e);
+
 /**
  * Retrieve a pointer to the emu's emu_memory.
  * 
@@ -113,6 +170,19 @@ int emu_errno(struct emu *c);
  */
 void emu_strerror_set(struct emu *e, const char *format, ...);
 
+/**
+ * Set the emu's errno and strerror message, without formatting the message.
+ * Only the format and the argument are stored, the message is formatted by
+ * emu_strerror, so errors nobody asks about cost a few stores.
+ * 
+ * @param e      the emu
+ * @param err    the errno
+ * @param format the errormessage format, a string constant with at most
+ *               one integer conversion
+ * @param arg    the argument to the conversion
+ */
+void emu_error_set(struct emu *e, int err, const char *format, uint32_t arg);
+
 /**
  * Retrieve the emu's strerror
  * 
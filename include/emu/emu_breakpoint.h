@@ -55,5 +55,6 @@ struct emu_breakpoint *emu_breakpoint_get(struct emu_memory *m, uint32_t addr);
 void emu_breakpoint_check(struct emu_memory *m, uint32_t addr, uint8_t access);
 
 void emu_breakpoint_remove(struct emu_memory *m, uint32_t addr);
+void emu_breakpoint_clear(struct emu_memory *m);
 
 #endif /* HAVE_EMU_BREAKPOINT_H */
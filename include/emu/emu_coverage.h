@@ -0,0 +1,131 @@
+/********************************************************************************
+ *                               libemu
+ *
+ *                    - x86 shellcode emulation -
+ *
+ *
+ * Copyright (C) 2007  Paul Baecher & Markus Koetter
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *
+ *             contact nepenthesdev@users.sourceforge.net
+ *
+ *******************************************************************************/
+
+#ifndef HAVE_EMU_COVERAGE_H
+#define HAVE_EMU_COVERAGE_H
+
+#include <stdint.h>
+
+struct emu_cpu;
+
+/* number of edge counters, a power of two */
+#define EMU_COVERAGE_EDGES (1 << 16)
+
+/**
+ * Execution coverage.
+ *
+ * The bitmap has one bit per byte of [base, base + size), set if an
+ * instruction started at that address.
+ * The edges are the control transfers, every (from, to) pair of
+ * instruction addresses where to is not the instruction behind from.
+ * They are hashed into EMU_COVERAGE_EDGES saturating 8 bit counters,
+ * like the fuzzers do it, so distinct edges may share a counter.
+ */
+struct emu_coverage
+{
+	uint32_t base;
+	uint32_t size;
+	uint8_t *bitmap;
+
+	uint8_t *edges;
+
+	/* instructions parsed outside [base, base + size) */
+	uint32_t outside;
+
+	/* the instruction parsed last, and the address behind it */
+	uint32_t last_eip;
+	uint32_t last_next;
+	int has_last;
+};
+
+/**
+ * Create a coverage for the code in [base, base + size).
+ *
+ * @param base   the address of the code
+ * @param size   the length of the code
+ *
+ * @return on success: the coverage
+ *         on error  : NULL
+ */
+struct emu_coverage *emu_coverage_new(uint32_t base, uint32_t size);
+void emu_coverage_free(struct emu_coverage *cov);
+
+/**
+ * Clear the bitmap and the edges, to reuse the coverage for another run.
+ */
+void emu_coverage_clear(struct emu_coverage *cov);
+
+/**
+ * Record the execution of the cpu in cov, NULL stops recording.
+ * The cpu does not take ownership, a coverage may be shared by
+ * consecutive runs of different cpus to collect the union.
+ *
+ * @param c      the cpu
+ * @param cov    the coverage
+ */
+void emu_cpu_coverage_set(struct emu_cpu *c, struct emu_coverage *cov);
+
+/**
+ * Record an instruction, used by emu_cpu_parse.
+ *
+ * @param cov    the coverage
+ * @param eip    the address of the instruction
+ * @param next   the address behind the instruction
+ */
+void emu_coverage_hit(struct emu_coverage *cov, uint32_t eip, uint32_t next);
+
+/**
+ * The raw bitmap, bit (eip - base) & 7 of byte (eip - base) >> 3.
+ *
+ * @param cov    the coverage
+ * @param len    the length of the bitmap in bytes
+ *
+ * @return the bitmap
+ */
+const uint8_t *emu_coverage_bitmap_get(struct emu_coverage *cov, uint32_t *len);
+
+/**
+ * The raw edge counters.
+ *
+ * @param cov    the coverage
+ * @param len    the number of counters, EMU_COVERAGE_EDGES
+ *
+ * @return the counters
+ */
+const uint8_t *emu_coverage_edges_get(struct emu_coverage *cov, uint32_t *len);
+
+/**
+ * @return the number of addresses an instruction started at
+ */
+uint32_t emu_coverage_count(struct emu_coverage *cov);
+
+/**
+ * @return the number of non-zero edge counters
+ */
+uint32_t emu_coverage_edge_count(struct emu_coverage *cov);
+
+#endif
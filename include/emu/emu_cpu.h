@@ -103,7 +103,9 @@ uint32_t emu_cpu_eip_get(struct emu_cpu *c);
  * @param c      the cpu
  * 
  * @return on success: 0
- *         on errror : -1, check emu_errno and emu_strerror
+ *         on errror : -1, check emu_errno and emu_strerror,
+ *                     ECANCELED or ETIMEDOUT if the emu got interrupted,
+ *                     see emu_cancel and emu_deadline_set
  */
 int32_t emu_cpu_parse(struct emu_cpu *c);
 
@@ -119,12 +121,89 @@ int32_t emu_cpu_step(struct emu_cpu *c);
 
 int32_t emu_cpu_run(struct emu_cpu *c);
 
+/**
+ * The disassembly of the instruction parsed last, rendered when asked for.
+ * Requires the instruction_string debug flag to be set before parsing.
+ * 
+ * @param c      the cpu
+ * 
+ * @return the instruction, the cpu owns the string
+ */
+const char *emu_cpu_instruction_string(struct emu_cpu *c);
+
 void emu_cpu_free(struct emu_cpu *c);
 
+/**
+ * Put the cpu back into the state emu_cpu_new leaves it in: registers,
+ * debugflags and options cleared, no coverage, trace or tracking set.
+ * The allocations, like the block cache and the stats, are kept.
+ * 
+ * @param c      the cpu
+ */
+void emu_cpu_reset(struct emu_cpu *c);
+
 void emu_cpu_debug_print(struct emu_cpu *c);
 
 void emu_cpu_debugflag_set(struct emu_cpu *c, uint8_t flag);
 void emu_cpu_debugflag_unset(struct emu_cpu *c, uint8_t flag);
 
+/**
+ * enable/disable an optional cpu feature, see enum emu_cpu_option
+ * 
+ * @param c      the cpu
+ * @param option the option
+ */
+void emu_cpu_option_set(struct emu_cpu *c, uint8_t option);
+void emu_cpu_option_unset(struct emu_cpu *c, uint8_t option);
+
+/**
+ * The counters kept if the opcode_stats option is set.
+ * The fpu instructions are counted by their first byte.
+ */
+struct emu_cpu_stats
+{
+	uint64_t onebyte[0x100];
+	uint64_t twobyte[0x100];	/* 0x0f xx */
+
+	uint64_t steps;
+	uint64_t faults;			/* parse and step errors */
+	uint64_t hooks;				/* calls into the environment hooks */
+
+	/* opcode_stats_cycles: the timestamp counter ticks spent in every
+	 * 16th step, and the number of steps measured */
+	uint64_t onebyte_cycles[0x100];
+	uint64_t onebyte_samples[0x100];
+	uint64_t twobyte_cycles[0x100];
+	uint64_t twobyte_samples[0x100];
+};
+
+/**
+ * Get the execution counters.
+ * 
+ * @param c      the cpu
+ * 
+ * @return the counters, NULL if the opcode_stats option was never set
+ */
+const struct emu_cpu_stats *emu_cpu_stats_get(struct emu_cpu *c);
+
+/**
+ * Clear the execution counters.
+ */
+void emu_cpu_stats_reset(struct emu_cpu *c);
+
+/**
+ * The mnemonic of an opcode, for reporting the counters.
+ * 
+ * @param opcode the onebyte opcode, or 0x0fxx for the twobyte opcodes
+ * 
+ * @return the name, NULL if the opcode is not supported or an fpu opcode
+ */
+const char *emu_cpu_opcode_name(uint16_t opcode);
+
+/**
+ * Count a call into an environment hook, used by the environments.
+ */
+void emu_cpu_stats_hook(struct emu_cpu *c);
+
 
 #endif /* HAVEEMU_CPU_H */
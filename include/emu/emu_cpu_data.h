@@ -31,6 +31,8 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h> /* BYTE_ORDER, if the compiler does not tell */
 
 #include <emu/emu.h>
 #include <emu/emu_cpu_instruction.h>
@@ -46,7 +48,36 @@ enum emu_cpu_flag {
 #define CPU_FLAG_TOGGLE(cpu_p, fl) (cpu_p)->eflags ^= 1 << (fl)
 #define CPU_FLAG_ISSET(cpu_p, fl) ((cpu_p)->eflags & (1 << (fl)))
 
+/* the host byte order, this header is installed and <sys/types.h> leaves
+ * BYTE_ORDER undefined in the strict ISO modes, so ask the compiler first
+ * and refuse to guess */
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__)
+#define EMU_CPU_BIG_ENDIAN (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#elif defined(BYTE_ORDER) && defined(BIG_ENDIAN)
+#define EMU_CPU_BIG_ENDIAN (BYTE_ORDER == BIG_ENDIAN)
+#else
+#error "can not tell the byte order of the host"
+#endif
+
+/* position of ax/al and ah within the register file */
+#if EMU_CPU_BIG_ENDIAN
+#define CPU_REG16_INDEX(reg) ((reg) * 2 + 1)
+#define CPU_REG8_INDEX(reg) (((reg) & 3) * 4 + 3 - ((reg) >> 2))
+#else
+#define CPU_REG16_INDEX(reg) ((reg) * 2)
+#define CPU_REG8_INDEX(reg) (((reg) & 3) * 4 + ((reg) >> 2))
+#endif
+
+/* the 16/8 bit register as lvalue, reg being a enum emu_reg16/emu_reg8 */
+#define CPU_REG16(cpu_p, reg) (cpu_p)->r16[CPU_REG16_INDEX(reg)]
+#define CPU_REG8(cpu_p, reg) (cpu_p)->r8[CPU_REG8_INDEX(reg)]
+
 struct emu_track_and_source;
+struct emu_cpu_block_cache;
+struct emu_cpu_livelock;
+struct emu_cpu_stats;
+struct emu_coverage;
+struct emu_trace;
 
 
 #define CPU_DEBUG_FLAG_SET(cpu_p, fl) (cpu_p)->debugflags |= 1 << (fl)
@@ -59,32 +90,175 @@ enum emu_cpu_debug_flag {
 	instruction_size = 1,
 };
 
+#define CPU_OPTION_SET(cpu_p, opt) (cpu_p)->options |= 1 << (opt)
+#define CPU_OPTION_UNSET(cpu_p, opt) (cpu_p)->options &= ~(1 << (opt))
+#define CPU_OPTION_ISSET(cpu_p, opt) ((cpu_p)->options & (1 << (opt)))
+
+enum emu_cpu_option {
+	loop_fastforward = 0,	/* apply closed xor/add/sub decoder loops at once, see emu_cpu_loop.c */
+	block_cache = 1,		/* cache decoded hot blocks, see emu_cpu_block.c */
+	block_cache_verify = 2,	/* decode cached instructions again and compare */
+	opcode_stats = 3,		/* count the steps per opcode, see emu_cpu_stats_get */
+	opcode_stats_cycles = 4,	/* additionally sample the cycles spent per opcode */
+	livelock_detect = 5,	/* stop loops which make no progress with ELOOP, see emu_cpu_livelock.c */
+};
+
 struct emu_cpu
 {
 	struct emu *emu;
 	struct emu_memory *mem;
 	
 	uint32_t debugflags;
+	uint32_t options;
 
 	uint32_t eip;
 	uint32_t eflags;
-	uint32_t reg[8];
-	uint16_t *reg16[8];
-	uint8_t *reg8[8];
+
+	/* the 16 and 8 bit registers are part of the 32 bit ones,
+	 * access them using CPU_REG16 and CPU_REG8 */
+	union
+	{
+		uint32_t reg[8];
+		uint16_t r16[16];
+		uint8_t r8[32];
+	};
 
 	struct emu_instruction 			instr;
-	struct emu_cpu_instruction_info 	*cpu_instr_info;
+	const struct emu_cpu_instruction_info 	*cpu_instr_info;
 	
 	uint32_t last_fpu_instr[2];
 
+	/* the disassembly of the last instruction, see emu_cpu_instruction_string,
+	 * the bytes are kept if the instruction_string debug flag is set */
 	char *instr_string;
+	bool instr_string_valid;
+	uint32_t instr_eip;
+	uint8_t instr_data[32];
 
 	bool repeat_current_instr;
 
+	/* instructions to parse until emu_interrupted is checked again */
+	uint32_t interrupt_countdown;
+
 	struct emu_track_and_source *tracking;
+
+	struct emu_cpu_block_cache *blocks;
+
+	struct emu_cpu_livelock *livelock;
+
+	struct emu_cpu_stats *stats;
+
+	struct emu_coverage *coverage;	/* not owned, see emu_cpu_coverage_set */
+	struct emu_trace *trace;		/* not owned, see emu_cpu_trace_set */
 };
 
 
+/**
+ * Fast forward the decoder loop the cpu just jumped back into.
+ * 
+ * @param c          the cpu, eip pointing to the start of the loop body
+ * @param branch_eip the address of the backward loop/jnz instruction
+ * 
+ * @return the number of iterations applied, 0 if the loop was not recognized
+ */
+int32_t emu_cpu_loop_fastforward(struct emu_cpu *c, uint32_t branch_eip);
+
+/**
+ * Compare the state after a backward branch to the states at the last
+ * backward branches.
+ * 
+ * @param c      the cpu, eip pointing to the branch target
+ * 
+ * @return 0 if the state is new,
+ *         -1 if the cpu was in exactly this state already, the error is ELOOP
+ */
+int32_t emu_cpu_livelock_check(struct emu_cpu *c);
+
+/**
+ * Forget the states seen, the cpu state was changed from the outside.
+ */
+void emu_cpu_livelock_clear(struct emu_cpu *c);
+
+/**
+ * Take the instruction at eip from the block cache.
+ * 
+ * @param c      the cpu
+ * 
+ * @return 0 if the instruction was served from the cache,
+ *         -1 if it has to be decoded
+ */
+int32_t emu_cpu_block_fetch(struct emu_cpu *c);
+
+/**
+ * Record the instruction just decoded into the block cache, compare it
+ * with the cached one in block_cache_verify mode.
+ * 
+ * @param c          the cpu
+ * @param eip_before the address of the instruction
+ * 
+ * @return on success: 0
+ *         on a difference in verify mode: -1
+ */
+int32_t emu_cpu_block_store(struct emu_cpu *c, uint32_t eip_before);
+void emu_cpu_block_cache_free(struct emu_cpu_block_cache *cache);
+
+/**
+ * Forget the block being run or recorded. The cached blocks are kept,
+ * they are compared with the memory before they are used anyway.
+ */
+void emu_cpu_block_cache_reset(struct emu_cpu_block_cache *cache);
+
+/**
+ * Start counting the instruction about to be stepped, see emu_cpu_stats.c
+ * 
+ * @return the timestamp if this step is sampled, else 0
+ */
+uint64_t emu_cpu_stats_step_begin(struct emu_cpu *c);
+
+/**
+ * Finish counting the instruction stepped.
+ * 
+ * @param c      the cpu
+ * @param start  the timestamp returned by emu_cpu_stats_step_begin
+ * @param ret    the return value of the step
+ */
+void emu_cpu_stats_step_end(struct emu_cpu *c, uint64_t start, int32_t ret);
+void emu_cpu_stats_fault(struct emu_cpu *c);
+
+struct emu_decoded;
+
+/**
+ * Decode the instruction bytes at buf, see emu_cpu_decode.c.
+ * Only the track information of the addressing is set, va and the
+ * source are left to the caller.
+ * 
+ * @return the length of the instruction, 0 if buf ends within the
+ *         instruction, -1 if the opcode is not supported
+ */
+int32_t emu_cpu_decode_instruction(const uint8_t *buf, size_t len, struct emu_decoded *out);
+
+/**
+ * Set the track need/init masks of a decoded instruction which depend on
+ * the opcode, the modrm form and the prefixes only. emu_cpu_parse attaches
+ * them while the cpu is tracking, the instruction functions add the parts
+ * depending on the data.
+ * The masks are looked up in tables generated from
+ * emu_cpu_decode_track_reference when the library is built.
+ */
+void emu_cpu_decode_track(struct emu_decoded *d);
+
+/**
+ * Same as emu_cpu_decode_track, case by case, see emu_cpu_decode_track.c.
+ */
+void emu_cpu_decode_track_reference(struct emu_decoded *d);
+
+uint32_t dasm_print_instruction(uint32_t eip, uint8_t *data, uint32_t size, char *str);
+uint32_t dasm_instruction_size(uint8_t *data);
+
+extern const struct emu_cpu_instruction_info ii_onebyte[0x100];
+extern const struct emu_cpu_instruction_info ii_twobyte[0x100];
+
+
 #define MODRM_MOD(x) (((x) >> 6) & 3)
 #define MODRM_REGOPC(x) (((x) >> 3) & 7)
 #define MODRM_RM(x) ((x) & 7)
@@ -132,13 +306,13 @@ struct emu_cpu
 
 
 
-extern int64_t max_inttype_borders[][2][2];
+extern const int64_t max_inttype_borders[][2][2];
 
 #define INTOF(bits) int##bits##_t
 #define UINTOF(bits) uint##bits##_t
 
 #if !defined(INSTR_CALC)
-#if BYTE_ORDER == BIG_ENDIAN 
+#if EMU_CPU_BIG_ENDIAN
 #define INSTR_CALC(bits, a, b, c, operation)			\
 UINTOF(bits) operand_a; \
 UINTOF(bits) operand_b; \
@@ -263,14 +437,19 @@ memcpy(((char *)&to)+4,&upper,4);
 
 
 
-#define TRACK_INIT_REG32(instruction, reg32) (instruction).track.init.reg[reg32] = 0xffffffff;
-#define TRACK_NEED_REG32(instruction, reg32) (instruction).track.need.reg[reg32] = 0xffffffff;
+/* the bytes of a register tracked, one bit for each byte */
+#define TRACK_REG32 0x0f
+#define TRACK_REG16 0x0c
+#define TRACK_REG8  0x08
+
+#define TRACK_INIT_REG32(instruction, reg32) (instruction).track.init.reg[reg32] = TRACK_REG32;
+#define TRACK_NEED_REG32(instruction, reg32) (instruction).track.need.reg[reg32] = TRACK_REG32;
 
-#define TRACK_INIT_REG16(instruction, reg16) (instruction).track.init.reg[reg16] |= 0xffff << 16;
-#define TRACK_NEED_REG16(instruction, reg16) (instruction).track.need.reg[reg16] |= 0xffff << 16;
+#define TRACK_INIT_REG16(instruction, reg16) (instruction).track.init.reg[reg16] |= TRACK_REG16;
+#define TRACK_NEED_REG16(instruction, reg16) (instruction).track.need.reg[reg16] |= TRACK_REG16;
 
-#define TRACK_INIT_REG8(instruction, reg8) (instruction).track.init.reg[reg8] |= 0xff << 24;
-#define TRACK_NEED_REG8(instruction, reg8) (instruction).track.need.reg[reg8] |= 0xff << 24;
+#define TRACK_INIT_REG8(instruction, reg8) (instruction).track.init.reg[reg8] |= TRACK_REG8;
+#define TRACK_NEED_REG8(instruction, reg8) (instruction).track.need.reg[reg8] |= TRACK_REG8;
 
 #define TRACK_INIT_EFLAG(instruction, fl) (instruction).track.init.eflags |= 1 << (fl)
 #define TRACK_NEED_EFLAG(instruction, fl) (instruction).track.need.eflags |= 1 << (fl)
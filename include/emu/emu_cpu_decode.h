@@ -0,0 +1,113 @@
+/********************************************************************************
+ *                               libemu
+ *
+ *                    - x86 shellcode emulation -
+ *
+ *
+ * Copyright (C) 2007  Paul Baecher & Markus Koetter
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *
+ *             contact nepenthesdev@users.sourceforge.net
+ *
+ *******************************************************************************/
+
+#ifndef HAVE_EMU_CPU_DECODE_H
+#define HAVE_EMU_CPU_DECODE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <emu/emu_instruction.h>
+
+struct emu_cpu_instruction_info;
+
+/* no register in emu_decoded.ea */
+#define EMU_DECODED_NOREG 0xff
+
+/* the instruction has a memory operand, see emu_decoded.ea */
+#define EMU_DECODED_MEMORY   (1 << 0)
+/* the branch target is taken from a register or memory, norm_pos is unknown */
+#define EMU_DECODED_INDIRECT (1 << 1)
+
+/**
+ * A decoded instruction.
+ *
+ * instr carries the same fields emu_cpu_parse fills for the cpu, including
+ * the source (branch targets) and the static track need/init masks.
+ * The parts of the track masks which depend on the data, like xor r32,[m32]
+ * resulting in zero, are left to the execution.
+ */
+struct emu_decoded
+{
+	uint32_t va;
+	uint32_t length;
+	uint32_t flags;
+
+	/* the fpu instructions share the onebyte entry of their opcode */
+	const struct emu_cpu_instruction_info *info;
+
+	struct emu_instruction instr;
+
+	/**
+	 * The registers of the effective address,
+	 * ea = instr.cpu.modrm.ea (or instr.fpu.ea) + reg[base] + reg[index] * scale
+	 */
+	struct
+	{
+		uint8_t base;
+		uint8_t index;
+		uint8_t scale;
+	} ea;
+};
+
+/**
+ * Decode the instruction at buf without touching any emu, cpu or memory.
+ *
+ * @param buf    the code
+ * @param len    number of bytes available at buf
+ * @param va     the address of buf, used for the branch targets
+ * @param out    the decoded instruction
+ *
+ * @return on success: the length of the instruction
+ *         if buf ends within the instruction: 0
+ *         if the opcode is not supported: -1
+ */
+int32_t emu_cpu_decode(const uint8_t *buf, size_t len, uint32_t va, struct emu_decoded *out);
+
+/**
+ * The length of the instruction at buf, as emu_cpu_decode would return it,
+ * without decoding anything else. For sweeps over a lot of bytes.
+ *
+ * @param buf    the code
+ * @param len    number of bytes available at buf
+ *
+ * @return same as emu_cpu_decode
+ */
+int32_t emu_cpu_decode_length(const uint8_t *buf, size_t len);
+
+/**
+ * The decoder without the lookup tables, which emu_cpu_decode and
+ * emu_cpu_parse use. It is slow and only kept for the testsuite to check
+ * the table driven decoder against. Like the decoder emu_cpu_parse uses,
+ * it does not fill the source and the track masks besides the registers of
+ * the effective address.
+ *
+ * @return same as emu_cpu_decode
+ */
+int32_t emu_cpu_decode_reference(const uint8_t *buf, size_t len, struct emu_decoded *out);
+
+#endif
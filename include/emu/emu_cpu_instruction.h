@@ -37,6 +37,33 @@
 struct emu_cpu_instruction;
 struct emu_cpu;
 
+#define II_SBIT 1
+#define II_WBIT 1
+
+#define II_XX_REG1_REG2 1
+#define II_MOD_REG_RM 2
+#define II_XX_YYY_REG 3
+#define II_MOD_YYY_RM 4
+#define II_UUUU_TTTN 5
+#define II_XX_SREG3_ZZ 6  
+
+#define II_IMM 1
+#define II_IMM8 2
+#define II_IMM16 3
+#define II_IMM32 4
+
+#define II_DISPF 1
+#define II_DISP8 2
+#define II_DISP16 3
+#define II_DISP32 4
+
+/*#define II_LEVEL8 1 -- implementation pending
+
+#define II_TYPE 1 -- impementation pending*/
+
+#define II_FPU_INSTR 1
+
+
 struct emu_cpu_instruction_info
 {
 	int32_t (*function)(struct emu_cpu *, struct emu_cpu_instruction *);
@@ -34,34 +34,8 @@
 #include <emu/emu_cpu_functions.h>
 #include <emu/emu_cpu_instruction.h>
 
-#define II_SBIT 1
-#define II_WBIT 1
 
-#define II_XX_REG1_REG2 1
-#define II_MOD_REG_RM 2
-#define II_XX_YYY_REG 3
-#define II_MOD_YYY_RM 4
-#define II_UUUU_TTTN 5
-#define II_XX_SREG3_ZZ 6  
-
-#define II_IMM 1
-#define II_IMM8 2
-#define II_IMM16 3
-#define II_IMM32 4
-
-#define II_DISPF 1
-#define II_DISP8 2
-#define II_DISP16 3
-#define II_DISP32 4
-
-/*#define II_LEVEL8 1 -- implementation pending
-
-#define II_TYPE 1 -- impementation pending*/
-
-#define II_FPU_INSTR 1
-
-
-struct emu_cpu_instruction_info ii_onebyte[0x100] = {
+const struct emu_cpu_instruction_info ii_onebyte[0x100] = {
 	/* 00 */ {instr_add_00, "add", {0, 0, II_MOD_REG_RM, 0, 0, 0, 0, 0}},
 	/* 01 */ {instr_add_01, "add", {0, 0, II_MOD_REG_RM, 0, 0, 0, 0, 0}},
 	/* 02 */ {instr_add_02, "add", {0, 0, II_MOD_REG_RM, 0, 0, 0, 0, 0}},
@@ -320,7 +294,7 @@ struct emu_cpu_instruction_info ii_onebyte[0x100] = {
 	/* ff */ {instr_group_5_ff, "group5", {0, 0, II_MOD_REG_RM, 0, 0, 0, 0, 0}},
 };
 
-struct emu_cpu_instruction_info ii_twobyte[0x100] = {
+const struct emu_cpu_instruction_info ii_twobyte[0x100] = {
 	/* 00 */ {instr_sldt_0f00, "sldt", {0, 0, II_MOD_REG_RM, 0, 0, 0, 0, 0}},
 	/* 01 */ {0, 0, {0, 0, 0, 0, 0, 0, 0, 0}},
 	/* 02 */ {0, 0, {0, 0, 0, 0, 0, 0, 0, 0}},
@@ -34,9 +34,8 @@
 	bcopy(&(arg),  &pushme, 4);							\
 	if (cpu->reg[esp] < 4)								\
 	{													\
-		emu_errno_set((cpu)->emu, ENOMEM);				\
-		emu_strerror_set((cpu)->emu,					\
-		"ran out of stack space writing a dword\n");	\
+		emu_error_set((cpu)->emu, ENOMEM,				\
+		"ran out of stack space writing a dword\n", 0);	\
 		return -1;										\
 	}													\
 	cpu->reg[esp]-=4;									\
@@ -54,9 +53,8 @@
 	bcopy(&(arg),  &pushme, 2);							\
 	if (cpu->reg[esp] < 2)								\
 	{													\
-		emu_errno_set((cpu)->emu, ENOMEM);				\
-		emu_strerror_set((cpu)->emu,					\
-		"ran out of stack space writing a word\n");		\
+		emu_error_set((cpu)->emu, ENOMEM,				\
+		"ran out of stack space writing a word\n", 0);		\
 		return -1;										\
 	}													\
 	cpu->reg[esp]-=2;									\
@@ -74,9 +72,8 @@
 	uint8_t pushme = arg;								\
 	if (cpu->reg[esp] < 1)								\
 	{													\
-		emu_errno_set((cpu)->emu, ENOMEM);				\
-		emu_strerror_set((cpu)->emu,					\
-		"ran out of stack space writing a byte\n");		\
+		emu_error_set((cpu)->emu, ENOMEM,				\
+		"ran out of stack space writing a byte\n", 0);		\
 		return -1;										\
 	}													\
 	cpu->reg[esp]-=1;									\
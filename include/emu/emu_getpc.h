@@ -30,6 +30,8 @@
 #include <stdint.h>
 
 /**
+ * Check if the instruction at offset can get the pc. The instruction is
+ * only decoded, nothing is written to the memory or run.
  * 
  * @param e
  * @param data
@@ -319,33 +319,52 @@ struct list__hack
 }									\
 /* static */ void name##_qsort_r(t_root *root, void *arg,			\
 		int (*cmp)(void *, t_elem *, t_elem *)) {		\
+	/* recurses into the smaller part and loops on the larger one,	\
+	 * sorted lists would recurse once per element otherwise */	\
 	t_elem *pivot, *elem;						\
-	t_root one, two, three;						\
-	int c;								\
+	t_root before, after, one, two, three;				\
+	int c, ones, threes;						\
 									\
-	name##_init(&one);						\
-	name##_init(&two);						\
-	name##_init(&three);						\
+	name##_init(&before);						\
+	name##_init(&after);						\
 									\
-	pivot = name##_remove_first(root);				\
-	if(pivot == NULL) return;					\
-	name##_insert_last(&two, pivot);				\
+	while(pivot = name##_remove_first(root), pivot != NULL) {	\
+		name##_init(&one);					\
+		name##_init(&two);					\
+		name##_init(&three);					\
+		ones = threes = 0;					\
 									\
-	while(elem = name##_remove_first(root), elem != NULL) {		\
-		c = cmp(arg, pivot, elem);				\
-		if(c > 0)						\
-			name##_insert_last(&one, elem);			\
-		else							\
-		if(c < 0)						\
-			name##_insert_last(&three, elem);		\
-		else							\
-			name##_insert_last(&two, elem);			\
+		name##_insert_last(&two, pivot);			\
+									\
+		while(elem = name##_remove_first(root), elem != NULL) {	\
+			c = cmp(arg, pivot, elem);			\
+			if(c > 0) {					\
+				name##_insert_last(&one, elem);		\
+				ones++;					\
+			} else						\
+			if(c < 0) {					\
+				name##_insert_last(&three, elem);	\
+				threes++;				\
+			} else						\
+				name##_insert_last(&two, elem);		\
+		}							\
+									\
+		if(ones < threes) {					\
+			name##_qsort_r(&one, arg, cmp);			\
+			name##_concat(&before, &one);			\
+			name##_concat(&before, &two);			\
+			name##_concat(root, &three);			\
+		} else {						\
+			name##_qsort_r(&three, arg, cmp);		\
+			name##_concat(&three, &after);			\
+			name##_concat(&two, &three);			\
+			name##_concat(&after, &two);			\
+			name##_concat(root, &one);			\
+		}							\
 	}								\
-	name##_qsort_r(&one, arg, cmp);					\
-	name##_qsort_r(&three, arg, cmp);				\
-	name##_concat(root, &one);					\
-	name##_concat(root, &two);					\
-	name##_concat(root, &three);					\
+									\
+	name##_concat(root, &before);					\
+	name##_concat(root, &after);					\
 }									\
 /* static */ int name##_qsort_cmp(void *a, t_elem *e1, t_elem *e2) {		\
 	/* function pointers can't be portably cast to void pointers */	\
@@ -46,6 +46,14 @@ void emu_log_level_set(struct emu_logging *el, enum emu_log_level level);
 
 void emu_log(struct emu *e, enum emu_log_level level, const char *format, ...);
 
+/**
+ * Check if messages of the given level are logged, so the
+ * arguments of a message are only computed if needed.
+ * 
+ * @return 1 if messages of level are logged, else 0
+ */
+int emu_log_level_enabled(struct emu *e, enum emu_log_level level);
+
 void emu_log_set_logcb(struct emu_logging *el, emu_log_logcb logcb);
 
 void emu_log_default_logcb(struct emu *e, enum emu_log_level level, const char *msg);
@@ -53,7 +61,8 @@ void emu_log_default_logcb(struct emu *e, enum emu_log_level level, const char *
 #define logInfo(e, format...) emu_log(e, EMU_LOG_INFO, format)
 
 #ifdef DEBUG
-#define logDebug(e, format...) emu_log(e, EMU_LOG_DEBUG, format)
+#define logDebug(e, format...) \
+	do { if( emu_log_level_enabled(e, EMU_LOG_DEBUG) ) emu_log(e, EMU_LOG_DEBUG, format); } while( 0 )
 #else
 #define logDebug(e, format...)
 #endif // DEBUG
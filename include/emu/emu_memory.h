@@ -44,6 +44,17 @@ struct emu_memory *emu_memory_new(struct emu *e);
 void emu_memory_clear(struct emu_memory *em);
 void emu_memory_free(struct emu_memory *em);
 
+/**
+ * Unmap all pages, drop the checkpoint and remove the breakpoints, like
+ * a new memory.
+ * Unlike emu_memory_clear, up to 64 pages are kept and reused by the next
+ * writes, so a run of the usual size allocates nothing again. The pages
+ * beyond that are freed.
+ * 
+ * @param m      the memory
+ */
+void emu_memory_reset(struct emu_memory *m);
+
 /* read access, these functions return -1 on error  */
 int32_t emu_memory_read_byte(struct emu_memory *m, uint32_t addr, uint8_t *byte);
 int32_t emu_memory_read_word(struct emu_memory *m, uint32_t addr, uint16_t *word);
@@ -68,6 +79,38 @@ int32_t emu_memory_alloc(struct emu_memory *m, uint32_t *addr, size_t len);
 /* information */
 uint32_t emu_memory_get_usage(struct emu_memory *m);
 
+/**
+ * the number of write accesses so far, changes whenever the memory got modified
+ */
+uint32_t emu_memory_get_writes(struct emu_memory *m);
+
+/**
+ * Remember the current contents of the memory, replacing the last
+ * checkpoint. Nothing is copied yet, every page is copied before the
+ * first write to it, so a rollback costs only the pages written since.
+ * 
+ * @param m      the memory
+ * 
+ * @return on success: 0
+ */
+int32_t emu_memory_checkpoint(struct emu_memory *m);
+
+/**
+ * Restore the memory to the checkpoint, the checkpoint stays valid.
+ * emu_memory_clear drops the checkpoint.
+ * 
+ * @param m      the memory
+ * 
+ * @return on success: 0
+ *         on error  : -1, there is no checkpoint
+ */
+int32_t emu_memory_rollback(struct emu_memory *m);
+
+/**
+ * Forget the checkpoint, the memory keeps its current contents.
+ */
+void emu_memory_checkpoint_drop(struct emu_memory *m);
+
 void emu_memory_mode_ro(struct emu_memory *m);
 void emu_memory_mode_rw(struct emu_memory *m);
 
@@ -0,0 +1,83 @@
+/********************************************************************************
+ *                               libemu
+ *
+ *                    - x86 shellcode emulation -
+ *
+ *
+ * Copyright (C) 2007  Paul Baecher & Markus Koetter
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ * 
+ * 
+ *             contact nepenthesdev@users.sourceforge.net  
+ *
+ *******************************************************************************/
+
+
+#ifndef HAVE_EMU_POOL_H
+#define HAVE_EMU_POOL_H
+
+#include <stdint.h>
+
+struct emu;
+struct emu_pool;
+
+/**
+ * Create a pool of emus. Callers testing one buffer after the other take
+ * an emu with emu_pool_get and hand it back with emu_pool_put instead of
+ * creating and freeing one for every buffer.
+ * 
+ * The pool may be used from several threads concurrently, an emu taken
+ * from it belongs to the thread which took it until it is put back.
+ * 
+ * @param max    the number of idle emus kept, emus put back beyond that
+ *               are freed
+ * 
+ * @return on success: the new pool
+ *         on failure: NULL
+ */
+struct emu_pool *emu_pool_new(uint32_t max);
+
+/**
+ * Free the pool and the idle emus in it, the emus taken from the pool
+ * have to be put back or freed with emu_free before.
+ * 
+ * @param p      the pool
+ */
+void emu_pool_free(struct emu_pool *p);
+
+/**
+ * Take an emu from the pool, a new one if there is no idle emu.
+ * The emu is in the state emu_new leaves it in.
+ * 
+ * @param p      the pool
+ * 
+ * @return on success: the emu
+ *         on failure: NULL
+ */
+struct emu *emu_pool_get(struct emu_pool *p);
+
+/**
+ * Hand an emu back to the pool, it is reset with emu_reset. An idle emu
+ * keeps only a few of the pages its last run mapped, however large that
+ * run was.
+ * Environments created for the emu have to be freed before.
+ * 
+ * @param p      the pool
+ * @param e      the emu
+ */
+void emu_pool_put(struct emu_pool *p, struct emu *e);
+
+#endif
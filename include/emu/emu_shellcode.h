@@ -33,8 +33,15 @@
 
 struct emu;
 
+/* buffers of a batch larger than this are tested in windows, see
+ * emu_shellcode_test_windowed */
+#define EMU_SHELLCODE_WINDOW 0x10000
+#define EMU_SHELLCODE_WINDOW_MIN 0x1000
+
 /**
  * Tests a given buffer for possible shellcodes
+ * The whole buffer is mapped and tested at once, so the memory needed
+ * grows with its size, see emu_shellcode_test_windowed for large buffers.
  * 
  * @param e      the emu
  * @param data   the buffer to test
@@ -42,8 +49,178 @@ struct emu;
  * 
  * @return on success, the offset within the buffer where the shellcode is suspected
  *         on failure (no shellcode detected), -1
+ *         if the emu got interrupted (see emu_cancel and emu_deadline_set),
+ *         the test stops early and returns what it found so far, emu_errno
+ *         is ECANCELED or ETIMEDOUT then
+ */
+int32_t emu_shellcode_test(struct emu *e, uint8_t *data, uint32_t size);
+
+/**
+ * Tests a given buffer for possible shellcodes like emu_shellcode_test,
+ * but the candidates are tested by several threads, each with an emu of
+ * its own, created with the cpu options of e.
+ *
+ * The threads share the static instruction graph and the positions
+ * tested already. The positions a candidate tested are shared in the
+ * order of the candidates, a candidate which missed a position one in
+ * front of it tested is tested again, and the results are merged in the
+ * order of the candidates, so the offset is the one emu_shellcode_test
+ * returns.
+ *
+ * Cancelling e or a deadline on e stops the threads.
+ *
+ * @param e       the emu
+ * @param data    the buffer to test
+ * @param size    the size of the buffer
+ * @param threads the number of threads, with 1 the candidates are
+ *                tested on e in the calling thread
+ *
+ * @return see emu_shellcode_test
+ */
+int32_t emu_shellcode_test_threads(struct emu *e, uint8_t *data, uint32_t size, uint32_t threads);
+
+/**
+ * Tests a large buffer for shellcodes, in windows around the GetPC
+ * candidates instead of all at once.
+ *
+ * A window starts window/4 bytes in front of the first candidate not
+ * tested yet and covers the candidates in the window/2 bytes from
+ * there, windows without candidates are skipped. So the memory needed
+ * depends on the window, not on the size of the buffer, and a shellcode
+ * is found as long as the code it runs lies within window/4 bytes
+ * around its GetPC.
+ *
+ * The offset is not always the one emu_shellcode_test returns for the
+ * buffer: a candidate sees only its window, the bytes behind the end of
+ * a window read as zero, and the addresses the code runs at depend on
+ * where its window starts. Windows start on a multiple of 0x1000 within
+ * the buffer, so a GetPC check sees the same page boundaries as in a
+ * single test.
+ *
+ * The windows are tested one after another, the candidates of a window
+ * by threads threads as with emu_shellcode_test_threads.
+ *
+ * @param e       the emu
+ * @param data    the buffer to test
+ * @param size    the size of the buffer
+ * @param window  the size of a window, EMU_SHELLCODE_WINDOW_MIN at least
+ * @param threads the number of threads
+ *
+ * @return the offset of the best position of all windows,
+ *         see emu_shellcode_test
+ */
+int32_t emu_shellcode_test_windowed(struct emu *e, uint8_t *data, uint32_t size, uint32_t window, uint32_t threads);
+
+struct emu_triage;
+
+/**
+ * Score the buffer with emu_triage first and only test it with
+ * emu_shellcode_test if it scores threshold or more.
+ * Without triage, a buffer without GetPC patterns is not scored at all,
+ * see emu_triage_getpc.
+ *
+ * @param e         the emu
+ * @param data      the buffer to test
+ * @param size      the size of the buffer
+ * @param threshold the score a buffer needs to get tested, see
+ *                  EMU_TRIAGE_THRESHOLD
+ * @param triage    the result of emu_triage, may be NULL
+ *
+ * @return see emu_shellcode_test, -1 if the buffer was not tested
+ */
+int32_t emu_shellcode_test_triaged(struct emu *e, uint8_t *data, uint32_t size, uint32_t threshold, struct emu_triage *triage);
+
+
+/**
+ * The result of testing a buffer of a batch.
+ */
+struct emu_shellcode_result
+{
+	/* the offset emu_shellcode_test would return, or
+	 * emu_shellcode_test_windowed for a large buffer, -1 if none */
+	int32_t offset;
+
+	/* the GetPC candidates found in the buffer */
+	uint32_t candidates;
+
+	/* the start positions tested */
+	uint32_t positions;
+
+	/* the steps the best position ran */
+	uint32_t steps;
+};
+
+/**
+ * Tests several buffers for shellcodes, like emu_shellcode_test for
+ * each of them, but the buffers are tested one after another on e,
+ * keeping the memory pages, the environment, the static graph and the
+ * buffers the test needs from one buffer to the next. For many small
+ * buffers, this is much cheaper than a emu_shellcode_test for each.
+ *
+ * Buffers larger than EMU_SHELLCODE_WINDOW are tested as
+ * emu_shellcode_test_windowed tests them with a window of that size, so
+ * the memory a batch needs does not depend on the size of its buffers.
+ *
+ * The emu's memory is reset before each buffer.
+ *
+ * @param e       the emu
+ * @param bufs    the buffers to test
+ * @param lens    the sizes of the buffers
+ * @param n       the number of buffers
+ * @param results the results, one for each buffer
+ *
+ * @return the number of buffers tested, less than n if the emu got
+ *         interrupted, the results of the buffers behind are not set
+ */
+int32_t emu_shellcode_test_batch(struct emu *e, uint8_t **bufs, uint32_t *lens, uint32_t n, struct emu_shellcode_result *results);
+
+
+struct emu_shellcode_stream;
+
+/* the most bytes a stream keeps between two feeds */
+#define EMU_SHELLCODE_STREAM_WINDOW_MAX 0x8000
+
+/**
+ * Create a stream to test data arriving in pieces, f.e. a reassembled
+ * tcp stream, for shellcodes.
+ * The stream keeps the last window bytes fed, every feed tests them
+ * together with the new bytes, so a shellcode may start up to window
+ * bytes before the data fed. The GetPC candidates are kept across feeds
+ * and not looked for again. The cost of a feed depends on the window and
+ * the size of the data fed, not on the length of the stream.
+ *
+ * @param e      the emu to run the tests on
+ * @param window the number of bytes kept, EMU_SHELLCODE_STREAM_WINDOW_MAX
+ *               at most
+ *
+ * @return on success: the stream
+ *         on failure: NULL
+ */
+struct emu_shellcode_stream *emu_shellcode_stream_new(struct emu *e, uint32_t window);
+
+/**
+ * Append data to the stream and test it.
+ *
+ * @param s      the stream
+ * @param data   the data
+ * @param size   the size of the data
+ *
+ * @return on success, the offset within the stream where the shellcode
+ *         is suspected
+ *         on failure (no shellcode detected), -1
+ *         an interrupted emu stops the test as with emu_shellcode_test
+ */
+int32_t emu_shellcode_stream_feed(struct emu_shellcode_stream *s, uint8_t *data, uint32_t size);
+
+/**
+ * Free the stream.
+ *
+ * @param s      the stream
+ *
+ * @return the offset within the stream of the first shellcode any feed
+ *         detected, -1 if there was none
  */
-int32_t emu_shellcode_test(struct emu *e, uint8_t *data, uint16_t size);
+int32_t emu_shellcode_stream_finish(struct emu_shellcode_stream *s);
 
 
 struct emu_stats
@@ -29,10 +29,46 @@
 #ifndef HAVE_EMU_SOURCE_H
 #define HAVE_EMU_SOURCE_H
 
+#include <stdint.h>
+
+struct emu;
 struct emu_track_and_source;
-struct emu_vertex;
+struct emu_source_and_track_instr_info;
 
 
+/**
+ * The static instruction graph of the shellcode.
+ * As every offset of the data may start an instruction, the graph has
+ * one instruction per offset and the edges are kept as offsets in
+ * compressed sparse rows, everything in a single allocation.
+ * 
+ * The successors of the instruction at offset i are
+ * succ[succ_index[i]] to succ[succ_index[i+1]-1], the normal one first,
+ * the predecessors are pred[pred_index[i]] to pred[pred_index[i+1]-1]
+ * in ascending order.
+ * Edges only lead to offsets within the data where an instruction
+ * could be decoded.
+ */
+struct emu_source_graph
+{
+	/* the address of offset 0 */
+	uint32_t start;
+	uint32_t size;
+
+	/* the number of offsets the arrays have room for */
+	uint32_t capacity;
+
+	/* the instruction at start + i, only valid if decoded[i] is set */
+	struct emu_source_and_track_instr_info *instr;
+	uint8_t *decoded;
+
+	uint32_t *succ_index;
+	uint32_t *succ;
+
+	uint32_t *pred_index;
+	uint32_t *pred;
+};
+
 /**
  * Create the callgraph of the shellcode being stored in the emu memory.
  * 
@@ -41,12 +77,22 @@ struct emu_vertex;
  * @param datastart where to start
  * @param datasize  where to stop
  * 
- * @return 
+ * A graph es got from an earlier call is reused if it is large enough,
+ * freed otherwise.
+ * 
+ * @return on success: 0
+ *         on failure: -1
  */
 uint32_t emu_source_instruction_graph_create(struct emu *e, struct emu_track_and_source *es, uint32_t datastart, uint32_t datasize);
 
+void emu_source_graph_free(struct emu_source_graph *g);
 
-void emu_source_forward_bfs(struct emu_track_and_source *et, struct emu_vertex *from);
-void emu_source_backward_bfs(struct emu_track_and_source *et, struct emu_vertex *ev);
+/**
+ * The instruction at an address.
+ * 
+ * @return the instruction, NULL if the address is outside of the
+ *         graph or no instruction could be decoded there
+ */
+struct emu_source_and_track_instr_info *emu_source_graph_instr(struct emu_source_graph *g, uint32_t eip);
 
 #endif
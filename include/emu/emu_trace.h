@@ -0,0 +1,172 @@
+/********************************************************************************
+ *                               libemu
+ *
+ *                    - x86 shellcode emulation -
+ *
+ *
+ * Copyright (C) 2007  Paul Baecher & Markus Koetter
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *
+ *             contact nepenthesdev@users.sourceforge.net
+ *
+ *******************************************************************************/
+
+#ifndef HAVE_EMU_TRACE_H
+#define HAVE_EMU_TRACE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+struct emu_cpu;
+struct emu_trace;
+struct emu_trace_reader;
+
+/**
+ * The execution trace.
+ *
+ * A trace is a stream of records, written while the cpu runs and read back
+ * later without emulating again. Every record carries the eip of the
+ * instruction, the eip behind it and the registers which changed, as
+ * deltas to the record before. The instruction bytes are only stored if
+ * the reader can not know them yet, so a loop costs a few bytes per step.
+ * The file is written sequentially and never seeked, a pipe will do.
+ */
+enum emu_trace_type
+{
+	EMU_TRACE_STEP = 0,		/* an instruction was executed */
+	EMU_TRACE_HOOK = 1,		/* an api call or syscall was hooked */
+	EMU_TRACE_STATE = 2,	/* the registers were set from outside */
+	EMU_TRACE_FAULT = 3,	/* the instruction could not be parsed */
+};
+
+/* the size of the buffer for emu_trace_record_string */
+#define EMU_TRACE_STRING_SIZE 92
+
+struct emu_trace_record
+{
+	enum emu_trace_type type;
+
+	/* the address of the instruction or hook */
+	uint32_t eip;
+
+	/* the cpu after the record */
+	uint32_t next_eip;
+	uint32_t reg[8];
+	uint32_t eflags;
+
+	/* EMU_TRACE_STEP: emu_cpu_step failed */
+	int error;
+
+	/* EMU_TRACE_STEP: the instruction, valid until the next record */
+	const uint8_t *code;
+	uint32_t code_len;
+
+	/* EMU_TRACE_HOOK: the name of the api call or syscall,
+	 * the return value is in reg[eax] */
+	const char *name;
+};
+
+/**
+ * Create a trace writing to f. The trace does not close f.
+ *
+ * @param f      the file
+ *
+ * @return on success: the trace
+ *         on error  : NULL
+ */
+struct emu_trace *emu_trace_new(FILE *f);
+
+/**
+ * Flush and free the trace.
+ */
+void emu_trace_free(struct emu_trace *t);
+
+/**
+ * Record the execution of the cpu to t, NULL stops recording.
+ * The current registers are written as EMU_TRACE_STATE record.
+ *
+ * @param c      the cpu
+ * @param t      the trace
+ */
+void emu_cpu_trace_set(struct emu_cpu *c, struct emu_trace *t);
+
+/**
+ * Write the registers, if they were changed outside of emu_cpu_step.
+ */
+void emu_trace_state(struct emu_trace *t, struct emu_cpu *c);
+
+/**
+ * Record a hook to the trace of the cpu, if any.
+ * Used by the environments after the hook ran.
+ *
+ * @param c      the cpu
+ * @param eip    the address of the call or syscall
+ * @param name   the name of the call
+ */
+void emu_cpu_trace_hook(struct emu_cpu *c, uint32_t eip, const char *name);
+
+/* used by emu_cpu_parse and emu_cpu_step */
+void emu_trace_parse(struct emu_trace *t, struct emu_cpu *c, uint32_t eip, int32_t ret);
+void emu_trace_step(struct emu_trace *t, struct emu_cpu *c, int32_t ret);
+
+/**
+ * Read a trace from memory.
+ *
+ * @param data   the trace
+ * @param len    the length of the trace
+ *
+ * @return on success: the reader
+ *         on error  : NULL, data is no trace
+ */
+struct emu_trace_reader *emu_trace_reader_new(const uint8_t *data, size_t len);
+
+/**
+ * Read a trace from a file, the file is mapped into memory.
+ *
+ * @param path   the file
+ *
+ * @return on success: the reader
+ *         on error  : NULL, check errno
+ */
+struct emu_trace_reader *emu_trace_reader_open(const char *path);
+
+void emu_trace_reader_free(struct emu_trace_reader *r);
+
+/**
+ * Read the next record.
+ *
+ * @param r      the reader
+ * @param rec    the record
+ *
+ * @return on success: 1
+ *         at the end of the trace: 0
+ *         if the trace is broken or truncated: -1
+ */
+int emu_trace_reader_next(struct emu_trace_reader *r, struct emu_trace_record *rec);
+
+/**
+ * Disassemble the instruction of an EMU_TRACE_STEP record.
+ *
+ * @param rec    the record
+ * @param str    EMU_TRACE_STRING_SIZE bytes
+ *
+ * @return the length of the instruction, 0 if it is invalid
+ */
+uint32_t emu_trace_record_string(const struct emu_trace_record *rec, char *str);
+
+#endif
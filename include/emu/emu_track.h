@@ -36,6 +36,7 @@ struct emu;
 struct emu_cpu;
 struct emu_graph;
 struct emu_instruction;
+struct emu_source_graph;
 
 
 
@@ -54,7 +55,16 @@ struct emu_tracking_info
 	uint32_t eip;
 
 	uint32_t eflags;
-	uint32_t reg[8];
+
+	/* a byte for each register, bit n is set if byte n of the register
+	 * is tracked, see TRACK_REG32, regs has them all in one word, so
+	 * emu_tracking_info_covers and emu_tracking_info_diff work on all
+	 * registers at once */
+	union
+	{
+		uint8_t reg[8];
+		uint64_t regs;
+	};
 
 	uint8_t fpu:1; // used to store the last_instruction information required for fnstenv
 };
@@ -64,15 +74,17 @@ struct emu_tracking_info
  * The emu_source_and_track_instr_info struct stores the register/fpu
  * tracking information as well as the source information 
  * for a instruction.
- * Additionally the disassembly of the instruction can be stored 
- * for debugging purposes.
+ * Additionally the instruction bytes can be stored for debugging
+ * purposes, see emu_source_and_track_instr_info_string.
  * 
  * @see emu_shellcode_run_and_track
  */
 struct emu_source_and_track_instr_info
 {
 	uint32_t eip;
-	char *instrstring;
+	char *instrstring;           /* rendered from instrdata on demand */
+	uint8_t instrdata[16];
+	bool has_instrdata;
 
 	struct 
 	{
@@ -88,8 +100,36 @@ struct emu_source_and_track_instr_info
 	} source;
 };
 
+/**
+ * Create the instr_info from the instruction the cpu just ran. The static
+ * part of the track information is attached by emu_cpu_parse only while
+ * cpu->tracking is set.
+ */
 struct emu_source_and_track_instr_info *emu_source_and_track_instr_info_new(struct emu_cpu *cpu, uint32_t eip_before_instruction);
+
+struct emu_decoded;
+
+/**
+ * Create the instr_info from a instruction decoded by emu_cpu_decode.
+ * 
+ * @param d           the decoded instruction
+ * @param data        the bytes of the instruction, kept for the disassembly, may be NULL
+ */
+struct emu_source_and_track_instr_info *emu_source_and_track_instr_info_new_decoded(struct emu_decoded *d, const uint8_t *data);
+
+/**
+ * Like emu_source_and_track_instr_info_new_decoded, but fill an instr_info
+ * the caller allocated, f.e. within an array.
+ */
+void emu_source_and_track_instr_info_init_decoded(struct emu_source_and_track_instr_info *etii, struct emu_decoded *d, const uint8_t *data);
 void emu_source_and_track_instr_info_free(struct emu_source_and_track_instr_info *esantii);
+
+/**
+ * The disassembly of the instruction, rendered on the first call.
+ * 
+ * @return the instruction, "" if the bytes were not kept
+ */
+const char *emu_source_and_track_instr_info_string(struct emu_source_and_track_instr_info *etii);
 void emu_source_and_track_instr_info_free_void(void *x);
 
 bool emu_source_and_track_instr_info_cmp(void *a, void *b);
@@ -100,8 +140,7 @@ struct emu_track_and_source
 {
 	struct emu_tracking_info track;
 
-	struct emu_graph        *static_instr_graph;
-	struct emu_hashtable    *static_instr_table;
+	struct emu_source_graph *static_graph;
 
 	struct emu_graph        *run_instr_graph;
 	struct emu_hashtable    *run_instr_table;
@@ -0,0 +1,108 @@
+/********************************************************************************
+ *                               libemu
+ *
+ *                    - x86 shellcode emulation -
+ *
+ *
+ * Copyright (C) 2007  Paul Baecher & Markus Koetter
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ * 
+ * 
+ *             contact nepenthesdev@users.sourceforge.net  
+ *
+ *******************************************************************************/
+
+
+#ifndef HAVE_EMU_TRIAGE_H
+#define HAVE_EMU_TRIAGE_H
+
+#include <stdint.h>
+
+/**
+ * What made a buffer score as it did, the bits of emu_triage.reasons
+ */
+enum emu_triage_reason
+{
+	/* call or fnstenv patterns emu_shellcode_test takes as candidates */
+	EMU_TRIAGE_GETPC     = (1 << 0),
+	/* a run of nop like bytes */
+	EMU_TRIAGE_NOPSLED   = (1 << 1),
+	/* a window with the entropy of encoded code */
+	EMU_TRIAGE_ENTROPY   = (1 << 2),
+	/* most bytes decode to instructions in a linear sweep */
+	EMU_TRIAGE_DECODABLE = (1 << 3),
+	/* mostly printable text, lowers the score */
+	EMU_TRIAGE_TEXT      = (1 << 4),
+};
+
+/**
+ * The result of emu_triage.
+ */
+struct emu_triage
+{
+	/* 0 to 100, the higher the more the buffer looks like a shellcode */
+	uint32_t score;
+
+	/* the emu_triage_reason bits which apply */
+	uint32_t reasons;
+
+	/* the GetPC patterns found */
+	uint32_t getpc;
+
+	/* the longest run of nop like bytes */
+	uint32_t nopsled;
+
+	/* the highest entropy of a 256 byte window, in 1/100 bits per byte */
+	uint32_t entropy;
+
+	/* the bytes decoded by a linear sweep, in percent */
+	uint32_t decodable;
+
+	/* the printable bytes, in percent */
+	uint32_t printable;
+};
+
+/* the score emu_shellcode_test_triaged is meant to be used with, a buffer
+ * needs a GetPC pattern and one of the other reasons to reach it */
+#define EMU_TRIAGE_THRESHOLD 65
+
+/**
+ * Score a buffer without emulating it, to tell the buffers worth an
+ * emu_shellcode_test from the obviously benign ones.
+ * The buffer is read a few times, the cost is linear in its size, far
+ * below the cost of testing a buffer with GetPC candidates.
+ *
+ * A buffer without a GetPC pattern has no candidates emu_shellcode_test
+ * could find a shellcode at, its test is about as cheap as
+ * emu_triage_getpc.
+ *
+ * @param data   the buffer
+ * @param size   the size of the buffer
+ * @param t      the result, the score and what made it
+ *
+ * @return the score
+ */
+uint32_t emu_triage(uint8_t *data, uint32_t size, struct emu_triage *t);
+
+/**
+ * Count the GetPC patterns only, the cheapest part of emu_triage.
+ * If there is none, emu_shellcode_test finds no shellcode in the buffer.
+ *
+ * @return the number of GetPC patterns
+ */
+uint32_t emu_triage_getpc(uint8_t *data, uint32_t size);
+
+#endif
@@ -25,6 +25,8 @@
  *
  *******************************************************************************/
 
+#include <stdint.h>
+
 struct emu_env_linux;
 struct emu_env_linux_syscall;
 struct emu_env_w32;
@@ -114,3 +116,14 @@ struct emu_env
 
 struct emu_env *emu_env_new(struct emu *e);
 void emu_env_free(struct emu_env *env);
+
+/**
+ * Reset the environments to their initial state, the hooks and
+ * the profile are kept.
+ *
+ * @see emu_env_w32_reset
+ *
+ * @return on success: 0
+ *         on failure: -1
+ */
+int32_t emu_env_reset(struct emu_env *env);
@@ -139,7 +139,7 @@ void emu_profile_argument_debug(struct emu_profile_argument *argument, int inden
 void emu_profile_argument_add_none(struct emu_profile *profile);
 void emu_profile_argument_add_int(struct emu_profile *profile, char *argtype, char *argname, int32_t value);
 void emu_profile_argument_add_short(struct emu_profile *profile, char *argtype, char *argname, int16_t value);
-void emu_profile_argument_add_string(struct emu_profile *profile, char *argtype,  char *argname, char *value);
+void emu_profile_argument_add_string(struct emu_profile *profile, const char *argtype, const char *argname, const char *value);
 void emu_profile_argument_add_ptr(struct emu_profile *profile,	char *argtype,  char *argname, uint32_t value);
 void emu_profile_argument_add_ip(struct emu_profile *profile, char *argtype,  char *argname, uint32_t value);
 void emu_profile_argument_add_port(struct emu_profile *profile,	char *argtype,  char *argname, uint32_t value);
@@ -44,6 +44,7 @@ struct emu_env;
 struct emu_env_linux
 {
 	struct emu *emu;
+	/* shared by all envs, the values are indexes into hooks */
 	struct emu_hashtable *syscall_hooks_by_name;
 	struct emu_env_linux_syscall *syscall_hookx;
 	struct emu_env_hook *hooks;
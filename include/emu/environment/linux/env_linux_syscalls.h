@@ -29,7 +29,7 @@
 #include "emu/environment/linux/emu_env_linux.h"
 #include "emu/environment/linux/env_linux_syscall_hooks.h"
 
-struct emu_env_linux_syscall_entry env_linux_syscalls[] = 
+static const struct emu_env_linux_syscall_entry env_linux_syscalls[] = 
 {
 /* 0*/   { NULL                         , NULL}, 
 /* 1*/   { "exit"                       , NULL}, 
@@ -225,7 +225,7 @@ struct emu_env_linux_syscall_entry env_linux_syscalls[] =
 };
 
 
-struct emu_env_linux_syscall syscall_hooks[] = 
+static const struct emu_env_linux_syscall syscall_hooks[] = 
 {
 	{ "accept"              		, env_linux_hook_socketcall},
 	{ "access"              		, NULL},
@@ -82,6 +82,22 @@ struct emu_env_w32 *emu_env_w32_new(struct emu *e);
  */
 void emu_env_w32_free(struct emu_env_w32 *env);
 
+/**
+ * Reset the emu_env_w32 to the state emu_env_w32_new left it in,
+ * dlls loaded later on are unloaded, the process memory and the
+ * dlls are written to the emu's memory again.
+ * The hooks set on the exports are kept.
+ *
+ * Cheaper than emu_env_w32_free and emu_env_w32_new once the
+ * memory got cleared, see emu_memory_reset.
+ *
+ * @param env    the env to reset
+ *
+ * @return on success: 0
+ *         on failure: -1
+ */
+int32_t emu_env_w32_reset(struct emu_env_w32 *env);
+
 int32_t emu_env_w32_load_dll(struct emu_env_w32 *env, char *path);
 
 /**
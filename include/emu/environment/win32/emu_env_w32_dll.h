@@ -29,6 +29,7 @@
 #define HAVE_EMU_ENV_W32_DLL_H
 
 #include <stdint.h>
+#include <stdbool.h>
 
 struct emu_env_hook;
 struct emu_env_w32_dll_export;
@@ -44,13 +45,65 @@ struct emu_env_w32_dll
 
 	struct emu_env_w32_dll_export *exportx;
 	struct emu_env_hook *hooks;
+	uint32_t	exports_count;
+
+	/* the values are indexes into exportx and hooks, see
+	 * emu_env_w32_dll_hook_by_fnptr, the tables belong to another dll
+	 * if exports_shared is set and are not freed with this one */
 	struct emu_hashtable *exports_by_fnptr;
 	struct emu_hashtable *exports_by_fnname;
+	bool		exports_shared;
 };
 
 struct emu_env_w32_dll *emu_env_w32_dll_new(void);
 void emu_env_w32_dll_free(struct emu_env_w32_dll *dll);
-void emu_env_w32_dll_exports_copy(struct emu_env_w32_dll *to, struct emu_env_w32_dll_export *from);
+
+/**
+ * Copy the exports to the dll and build the lookup tables for them, the
+ * tables belong to the dll.
+ * 
+ * @param to     the dll
+ * @param from   the export array, terminated by an export without name
+ * 
+ * @return on success: 0
+ *         on failure: -1
+ */
+int32_t emu_env_w32_dll_exports_copy(struct emu_env_w32_dll *to, const struct emu_env_w32_dll_export *from);
+
+/**
+ * Copy the exports of a dll and use its lookup tables instead of
+ * building new ones. The tables stay with from, which has to outlive to,
+ * only the exports and hooks get copied.
+ * 
+ * @param to     the dll
+ * @param from   the dll to copy the exports from
+ * 
+ * @return on success: 0
+ *         on failure: -1
+ */
+int32_t emu_env_w32_dll_exports_share(struct emu_env_w32_dll *to, const struct emu_env_w32_dll *from);
+
+/**
+ * Look up the hook for an export of the dll
+ * 
+ * @param dll    the dll
+ * @param fnptr  the address of the export relative to the dll base
+ * 
+ * @return on success: the hook
+ *         on failure: NULL
+ */
+struct emu_env_hook *emu_env_w32_dll_hook_by_fnptr(struct emu_env_w32_dll *dll, uint32_t fnptr);
+
+/**
+ * Look up the hook for an export of the dll
+ * 
+ * @param dll    the dll
+ * @param fnname the name of the export
+ * 
+ * @return on success: the hook
+ *         on failure: NULL
+ */
+struct emu_env_hook *emu_env_w32_dll_hook_by_fnname(struct emu_env_w32_dll *dll, const char *fnname);
 
 
 struct emu_env_w32_known_dll_segment
@@ -65,8 +118,8 @@ struct emu_env_w32_known_dll
 	const char *dllname;
 	uint32_t 	baseaddress;
 	uint32_t	imagesize;
-	struct emu_env_w32_dll_export *exports;
-	struct emu_env_w32_known_dll_segment *memory_segments;
+	const struct emu_env_w32_dll_export *exports;
+	const struct emu_env_w32_known_dll_segment *memory_segments;
 };
 
 #endif
@@ -52,10 +52,10 @@ struct emu_env_w32_dll_export *emu_env_w32_dll_export_new(void);
 void emu_env_w32_dll_export_copy(struct emu_env_w32_dll_export *to, struct emu_env_w32_dll_export *from);
 void emu_env_w32_dll_export_free(struct emu_env_w32_dll_export *exp);
 
-extern struct emu_env_w32_dll_export kernel32_exports[];
-extern struct emu_env_w32_dll_export ws2_32_exports[];
-extern struct emu_env_w32_dll_export wininet_exports[];
-extern struct emu_env_w32_dll_export urlmon_exports[];
+extern const struct emu_env_w32_dll_export kernel32_exports[];
+extern const struct emu_env_w32_dll_export ws2_32_exports[];
+extern const struct emu_env_w32_dll_export wininet_exports[];
+extern const struct emu_env_w32_dll_export urlmon_exports[];
 
 
 #endif
@@ -37,7 +37,7 @@
 #include <emu/environment/win32/env_w32_dll_export_shell32_hooks.h>
 #include <emu/environment/win32/env_w32_dll_export_shdocvw_hooks.h>
 
-struct emu_env_w32_dll_export kernel32_exports[] = 
+const struct emu_env_w32_dll_export kernel32_exports[] = 
 {
 	{"ActivateActCtx", 0x0000A644, NULL, NULL},
 	{"AddAtomA", 0x000354ED, NULL, NULL},
@@ -991,7 +991,7 @@ struct emu_env_w32_dll_export kernel32_exports[] =
 	{0,0,NULL},
 };
 
-struct emu_env_w32_dll_export ws2_32_exports[] = 
+const struct emu_env_w32_dll_export ws2_32_exports[] = 
 {
 	{"accept", 0x00011028, env_w32_hook_accept, NULL},
 	{"bind", 0x00003E00, env_w32_hook_bind, NULL},
@@ -1113,7 +1113,7 @@ struct emu_env_w32_dll_export ws2_32_exports[] =
 	{0,0,NULL},
 };
 
-struct emu_env_w32_dll_export wininet_exports[] = 
+const struct emu_env_w32_dll_export wininet_exports[] = 
 {
 	{"CommitUrlCacheEntryA", 0x00021B82, NULL, NULL},
 	{"CommitUrlCacheEntryW", 0x0006F7E3, NULL, NULL},
@@ -1343,7 +1343,7 @@ struct emu_env_w32_dll_export wininet_exports[] =
 	{0,0,NULL},
 };
 
-struct emu_env_w32_dll_export msvcrt_exports[] = 
+const struct emu_env_w32_dll_export msvcrt_exports[] = 
 {
 
 	{"??0__non_rtti_object@@QAE@ABV0@@Z", 0x0001164B, NULL, NULL},
@@ -2180,7 +2180,7 @@ struct emu_env_w32_dll_export msvcrt_exports[] =
 };
 
 
-struct emu_env_w32_dll_export urlmon_exports[] = 
+const struct emu_env_w32_dll_export urlmon_exports[] = 
 {
 	{ "AsyncGetClassBits", 0x0003DF95, NULL, NULL},
 	{ "AsyncInstallDistributionUnit", 0x0003DA19, NULL, NULL},
@@ -2272,7 +2272,7 @@ struct emu_env_w32_dll_export urlmon_exports[] =
 };
 
 //dzzie 1-26-11
-struct emu_env_w32_dll_export user32_exports[] =
+const struct emu_env_w32_dll_export user32_exports[] =
 {
 	{"ActivateKeyboardLayout", 0x00018673, NULL, NULL},
 	{"AdjustWindowRect", 0x00021140, NULL, NULL},
@@ -3009,7 +3009,7 @@ struct emu_env_w32_dll_export user32_exports[] =
 	{0,0,NULL},
 };
 
-struct emu_env_w32_dll_export shell32_exports[] =
+const struct emu_env_w32_dll_export shell32_exports[] =
 {
 	{"SHChangeNotifyRegister", 0x0003EB0B, NULL, NULL},
 	{"SHDefExtractIconA", 0x000F4E4E, NULL, NULL},
@@ -3323,7 +3323,7 @@ struct emu_env_w32_dll_export shell32_exports[] =
 	{0,0,NULL},
 };
 
-struct emu_env_w32_dll_export ntdll_exports[] = 
+const struct emu_env_w32_dll_export ntdll_exports[] = 
 {
 	{"PropertyLengthAsVariant", 0x00059D2B, NULL, NULL},
 	{"RtlConvertPropertyToVariant", 0x00059C93, NULL, NULL},
@@ -4645,7 +4645,7 @@ struct emu_env_w32_dll_export ntdll_exports[] =
 };
 
 
-struct emu_env_w32_dll_export shlwapi_exports[] = 
+const struct emu_env_w32_dll_export shlwapi_exports[] = 
 {
 	{"SHAllocShared", 0x0000B601, NULL, NULL},
 	{"SHLockShared", 0x0001C37B, NULL, NULL},
@@ -4965,7 +4965,7 @@ struct emu_env_w32_dll_export shlwapi_exports[] =
 };
 
 
-struct emu_env_w32_dll_export advapi32_exports[] = 
+const struct emu_env_w32_dll_export advapi32_exports[] = 
 {
 	{"I_ScGetCurrentGroupStateW", 0x00066924, NULL, NULL},
 	{"A_SHAFinal", 0x0002B22D, NULL, NULL},
@@ -5647,7 +5647,7 @@ struct emu_env_w32_dll_export advapi32_exports[] =
 	{0,0,NULL},
 };
 
-struct emu_env_w32_dll_export shdocvw_exports[] = 
+const struct emu_env_w32_dll_export shdocvw_exports[] = 
 {
 	{"AddUrlToFavorites", 0x00044715, NULL, NULL},
 	{"DllCanUnloadNow", 0x0002200A, NULL, NULL},
@@ -29,6 +29,8 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <errno.h>
+#include <time.h>
 
 #include "emu/emu.h"
 #include "emu/emu_log.h"
@@ -41,8 +43,16 @@ struct emu
 	struct emu_memory *memory; 
 	struct emu_cpu *cpu;
 
-	int 	errno;
+	int 	error;	/* the errno, the name errno is taken by errno.h */
 	char 	*errorstr;
+
+	/* set by emu_error_set, formatted by emu_strerror */
+	const char *error_format;
+	uint32_t error_arg;
+
+	/* see emu_cancel and emu_deadline_set */
+	volatile int cancel;
+	uint64_t deadline;	/* CLOCK_MONOTONIC in ns, 0 if there is none */
 };
 
 
@@ -78,6 +88,68 @@ void emu_free(struct emu *e)
 	free(e);
 }
 
+void emu_reset(struct emu *e)
+{
+	emu_log_level_set(e->log, EMU_LOG_NONE);
+	emu_log_set_logcb(e->log, emu_log_default_logcb);
+
+	emu_memory_reset(e->memory);
+	emu_cpu_reset(e->cpu);
+
+	emu_interrupt_clear(e);
+
+	e->error = 0;
+	e->error_format = NULL;
+	if (e->errorstr != NULL)
+	{
+		free(e->errorstr);
+		e->errorstr = NULL;
+	}
+}
+
+static uint64_t emu_clock(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+void emu_cancel(struct emu *e)
+{
+	__sync_lock_test_and_set(&e->cancel, 1);
+}
+
+void emu_deadline_set(struct emu *e, uint32_t msec)
+{
+	if (msec == 0)
+		e->deadline = 0;
+	else
+		e->deadline = emu_clock() + (uint64_t)msec * 1000000ULL;
+}
+
+void emu_interrupt_clear(struct emu *e)
+{
+	__sync_lock_release(&e->cancel);
+	e->deadline = 0;
+}
+
+int emu_interrupted(struct emu *e)
+{
+	if (e->cancel != 0)
+	{
+		emu_error_set(e, ECANCELED, "run cancelled\n", 0);
+		return ECANCELED;
+	}
+
+	if (e->deadline != 0 && emu_clock() >= e->deadline)
+	{
+		emu_error_set(e, ETIMEDOUT, "deadline exceeded\n", 0);
+		return ETIMEDOUT;
+	}
+
+	return 0;
+}
+
 inline struct emu_memory *emu_memory_get(struct emu *e)
 {
 	return e->memory;
@@ -97,16 +169,25 @@ inline struct emu_cpu *emu_cpu_get(struct emu *e)
 
 void emu_errno_set(struct emu *e, int err)
 {
-	e->errno = err;
+	e->error = err;
 }
 
 int emu_errno(struct emu *c)
 {
-	return c->errno;
+	return c->error;
+}
+
+void emu_error_set(struct emu *e, int err, const char *format, uint32_t arg)
+{
+	e->error = err;
+	e->error_format = format;
+	e->error_arg = arg;
 }
 
 void emu_strerror_set(struct emu *e, const char *format, ...)
 {
+	e->error_format = NULL;
+
 	if (e->errorstr != NULL)
     	free(e->errorstr);
 
@@ -124,6 +205,21 @@ void emu_strerror_set(struct emu *e, const char *format, ...)
 
 const char *emu_strerror(struct emu *e)
 {
+	if (e->error_format != NULL)
+	{
+		char *message;
+
+		if (asprintf(&message, e->error_format, e->error_arg) != -1)
+		{
+			if (e->errorstr != NULL)
+				free(e->errorstr);
+
+			e->errorstr = message;
+		}
+
+		e->error_format = NULL;
+	}
+
 	return e->errorstr;
 }
 
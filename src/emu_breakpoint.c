@@ -128,6 +128,21 @@ void emu_breakpoint_check(struct emu_memory *m, uint32_t addr, uint8_t access)
 	return;
 }
 
+void emu_breakpoint_clear(struct emu_memory *m)
+{
+	struct emu_breakpoint *head = emu_memory_get_breakpoint(m);
+	struct emu_breakpoint *item = head->next;
+	
+	while(item != NULL) {
+		struct emu_breakpoint *next = item->next;
+		emu_breakpoint_free(item);
+		item = next;
+	}
+	head->next = NULL;
+	
+	return;
+}
+
 void emu_breakpoint_remove(struct emu_memory *m, uint32_t addr)
 {
 	struct emu_breakpoint *item_current = emu_memory_get_breakpoint(m);
@@ -0,0 +1,153 @@
+/********************************************************************************
+ *                               libemu
+ *
+ *                    - x86 shellcode emulation -
+ *
+ *
+ * Copyright (C) 2007  Paul Baecher & Markus Koetter
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *
+ *             contact nepenthesdev@users.sourceforge.net
+ *
+ *******************************************************************************/
+
+/*
+ * execution coverage
+ *
+ * emu_cpu_parse reports every instruction to the coverage attached to the
+ * cpu, both for decoded and block cached instructions. The cost without a
+ * coverage is a single pointer test per parse.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "emu/emu.h"
+#include "emu/emu_cpu.h"
+#include "emu/emu_cpu_data.h"
+#include "emu/emu_coverage.h"
+
+struct emu_coverage *emu_coverage_new(uint32_t base, uint32_t size)
+{
+	struct emu_coverage *cov = malloc(sizeof(struct emu_coverage));
+	if( cov == NULL )
+		return NULL;
+
+	memset(cov, 0, sizeof(struct emu_coverage));
+	cov->base = base;
+	cov->size = size;
+
+	cov->bitmap = malloc(size / 8 + 1);
+	cov->edges = malloc(EMU_COVERAGE_EDGES);
+	if( cov->bitmap == NULL || cov->edges == NULL )
+	{
+		emu_coverage_free(cov);
+		return NULL;
+	}
+
+	emu_coverage_clear(cov);
+	return cov;
+}
+
+void emu_coverage_free(struct emu_coverage *cov)
+{
+	if( cov->bitmap != NULL )
+		free(cov->bitmap);
+
+	if( cov->edges != NULL )
+		free(cov->edges);
+
+	free(cov);
+}
+
+void emu_coverage_clear(struct emu_coverage *cov)
+{
+	memset(cov->bitmap, 0, cov->size / 8 + 1);
+	memset(cov->edges, 0, EMU_COVERAGE_EDGES);
+	cov->outside = 0;
+	cov->has_last = 0;
+}
+
+void emu_cpu_coverage_set(struct emu_cpu *c, struct emu_coverage *cov)
+{
+	c->coverage = cov;
+
+	/* a new run, do not connect it to the last one */
+	if( cov != NULL )
+		cov->has_last = 0;
+}
+
+static inline uint32_t coverage_edge_hash(uint32_t from, uint32_t to)
+{
+	uint32_t h = from * 2654435761U ^ to;
+	h ^= h >> 16;
+	return h & (EMU_COVERAGE_EDGES - 1);
+}
+
+void emu_coverage_hit(struct emu_coverage *cov, uint32_t eip, uint32_t next)
+{
+	uint32_t offset = eip - cov->base;
+
+	if( offset < cov->size )
+		cov->bitmap[offset >> 3] |= 1 << (offset & 7);
+	else
+		cov->outside++;
+
+	if( cov->has_last && cov->last_next != eip )
+	{
+		uint8_t *count = &cov->edges[coverage_edge_hash(cov->last_eip, eip)];
+		if( *count != 0xff )
+			(*count)++;
+	}
+
+	cov->last_eip = eip;
+	cov->last_next = next;
+	cov->has_last = 1;
+}
+
+const uint8_t *emu_coverage_bitmap_get(struct emu_coverage *cov, uint32_t *len)
+{
+	*len = cov->size / 8 + 1;
+	return cov->bitmap;
+}
+
+const uint8_t *emu_coverage_edges_get(struct emu_coverage *cov, uint32_t *len)
+{
+	*len = EMU_COVERAGE_EDGES;
+	return cov->edges;
+}
+
+uint32_t emu_coverage_count(struct emu_coverage *cov)
+{
+	uint32_t i, n = 0;
+
+	for( i = 0; i < cov->size / 8 + 1; i++ )
+		n += __builtin_popcount(cov->bitmap[i]);
+
+	return n;
+}
+
+uint32_t emu_coverage_edge_count(struct emu_coverage *cov)
+{
+	uint32_t i, n = 0;
+
+	for( i = 0; i < EMU_COVERAGE_EDGES; i++ )
+		if( cov->edges[i] != 0 )
+			n++;
+
+	return n;
+}
@@ -30,48 +30,60 @@
 #include <errno.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "../config.h"
 
 #include "emu/emu_cpu.h"
 #include "emu/emu_cpu_data.h"
+#include "emu/emu_cpu_decode.h"
+#include "emu/emu_coverage.h"
+#include "emu/emu_trace.h"
 #include "emu/emu_memory.h"
 #include "emu/emu.h"
 #include "emu/emu_log.h"
 #include "emu/emu_breakpoint.h"
 
-static const char *regm[] = {
+/* the installed headers pick the register layout without config.h */
+#if defined(WORDS_BIGENDIAN) ? !EMU_CPU_BIG_ENDIAN : EMU_CPU_BIG_ENDIAN
+#error "configure and emu_cpu_data.h disagree on the byte order"
+#endif
+
+static const char *const regm[] = {
 	"eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi"
 };
 
-static uint8_t scalem[] = {
+static const uint8_t scalem[] = {
 	1, 2, 4, 8
 };
 
 	                      /* 0     1     2     3      4       5       6     7 */
-   const char *eflagm[] = { "CF", "  ", "PF", "  " , "AF"  , "    ", "ZF", "SF", 
+static const char *const eflagm[] = { "CF", "  ", "PF", "  " , "AF"  , "    ", "ZF", "SF", 
 	                        "TF", "IF", "DF", "OF" , "IOPL", "IOPL", "NT", "  ",
 	                        "RF", "VM", "AC", "VIF", "RIP" , "ID"  , "  ", "  ",
 	                        "  ", "  ", "  ", "   ", "    ", "    ", "  ", "  "};
 
+/* point imm8 and imm16 to the matching bytes of imm */
+static void cpu_imm_init(struct emu_cpu *c)
+{
+	int i = 1;
 
-static uint16_t prefix_map[0x100];
+	if( *((uint8_t *)&i) == 1 )
+	{
+		logDebug(c->emu,"little endian\n");
 
-#include "emu/emu_cpu_itables.h"
+		c->instr.cpu.imm16 = (uint16_t *)((void *)&c->instr.cpu.imm);
+		c->instr.cpu.imm8 = (uint8_t *)&c->instr.cpu.imm;
 
-static void init_prefix_map(void)
-{
-	prefix_map[0x26] = PREFIX_ES_OVR;
-	prefix_map[0x2e] = PREFIX_CS_OVR;
-	prefix_map[0x36] = PREFIX_SS_OVR;
-	prefix_map[0x3e] = PREFIX_DS_OVR;
-	prefix_map[0x64] = PREFIX_FS_OVR;
-	prefix_map[0x65] = PREFIX_GS_OVR;
-	prefix_map[0x66] = PREFIX_OPSIZE;
-	prefix_map[0x67] = PREFIX_ADSIZE;
-	prefix_map[0xf0] = PREFIX_LOCK;
-	prefix_map[0xf2] = PREFIX_F2;
-	prefix_map[0xf3] = PREFIX_F3;
+	}
+	else
+	{
+		logDebug(c->emu,"big endian\n");
+
+		c->instr.cpu.imm16 = (uint16_t *)((void *)&c->instr.cpu.imm + 1);
+		c->instr.cpu.imm8 = (uint8_t *)&c->instr.cpu.imm + 3;
+
+	}
 }
 
 struct emu_cpu *emu_cpu_new(struct emu *e)
@@ -88,58 +100,48 @@ struct emu_cpu *emu_cpu_new(struct emu *e)
 	c->emu = e;
 	c->mem = emu_memory_get(e);
 
-	int i = 1;
-
-	if( *((uint8_t *)&i) == 1 )
-	{
-		logDebug(e,"little endian\n");
-
-		for( i = 0; i < 8; i++ )
-		{
-			c->reg16[i] = (uint16_t *)&c->reg[i];
-
-			if( i < 4 )
-			{
-				c->reg8[i] = (uint8_t *)&c->reg[i];
-			}
-			else
-			{
-				c->reg8[i] = (uint8_t *)&c->reg[i & 3] + 1;
-			}
-		}
+	cpu_imm_init(c);
 
-		c->instr.cpu.imm16 = (uint16_t *)((void *)&c->instr.cpu.imm);
-		c->instr.cpu.imm8 = (uint8_t *)&c->instr.cpu.imm;
+	c->instr_string = (char *)malloc(92);
+	c->instr_string[0] = '\0';
+	c->instr_string_valid = true;
+	c->repeat_current_instr = false;
+	
+	return c;
+}
 
-	}
-	else
-	{
-		logDebug(e,"big endian\n");
+void emu_cpu_reset(struct emu_cpu *c)
+{
+	c->debugflags = 0;
+	c->options = 0;
+	c->eip = 0;
+	c->eflags = 0;
+	memset(c->reg, 0, sizeof(c->reg));
+
+	memset(&c->instr, 0, sizeof(struct emu_instruction));
+	cpu_imm_init(c);
+	c->cpu_instr_info = NULL;
+	memset(c->last_fpu_instr, 0, sizeof(c->last_fpu_instr));
+
+	c->instr_string[0] = '\0';
+	c->instr_string_valid = true;
+	c->instr_eip = 0;
+	memset(c->instr_data, 0, sizeof(c->instr_data));
+	c->repeat_current_instr = false;
+	c->interrupt_countdown = 0;
 
-		for( i = 0; i < 8; i++ )
-		{
-			c->reg16[i] = (uint16_t *)&c->reg[i] + 1;
+	c->tracking = NULL;
 
-			if( i < 4 )
-			{
-				c->reg8[i] = (uint8_t *)&c->reg[i] + 3;
-			}
-			else
-			{
-				c->reg8[i] = (uint8_t *)&c->reg[i & 3] + 2;
-			}
-		}
+	if( c->blocks != NULL )
+		emu_cpu_block_cache_reset(c->blocks);
 
-		c->instr.cpu.imm16 = (uint16_t *)((void *)&c->instr.cpu.imm + 1);
-		c->instr.cpu.imm8 = (uint8_t *)&c->instr.cpu.imm + 3;
+	if( c->livelock != NULL )
+		emu_cpu_livelock_clear(c);
 
-	}
+	emu_cpu_stats_reset(c);
 
-	c->instr_string = (char *)malloc(92);
-	c->repeat_current_instr = false;
-	init_prefix_map();
-	
-	return c;
+	c->coverage = NULL;
+	c->trace = NULL;
 }
 
 inline uint32_t emu_cpu_reg32_get(struct emu_cpu *cpu_p, enum emu_reg32 reg)
@@ -154,23 +156,23 @@ inline void  emu_cpu_reg32_set(struct emu_cpu *cpu_p, enum emu_reg32 reg, uint32
 
 inline uint16_t emu_cpu_reg16_get(struct emu_cpu *cpu_p, enum emu_reg16 reg)
 {
-	return *cpu_p->reg16[reg];
+	return CPU_REG16(cpu_p, reg);
 }
 
 inline void emu_cpu_reg16_set(struct emu_cpu *cpu_p, enum emu_reg16 reg, uint16_t val)
 {
-	*cpu_p->reg16[reg] = val; 
+	CPU_REG16(cpu_p, reg) = val;
 }
 
 inline uint8_t emu_cpu_reg8_get(struct emu_cpu *cpu_p, enum emu_reg8 reg)
 {
-	return *cpu_p->reg8[reg];
+	return CPU_REG8(cpu_p, reg);
 }
 
 
 inline void emu_cpu_reg8_set(struct emu_cpu *cpu_p, enum emu_reg8 reg, uint8_t val)
 {
-	*cpu_p->reg8[reg] = val;
+	CPU_REG8(cpu_p, reg) = val;
 }
 
 uint32_t emu_cpu_eflags_get(struct emu_cpu *c)
@@ -187,6 +189,9 @@ void emu_cpu_eip_set(struct emu_cpu *c, uint32_t val)
 {
 	c->eip = val;
 	c->repeat_current_instr = false;
+
+	if( c->livelock != NULL )
+		emu_cpu_livelock_clear(c);
 }
 
 uint32_t emu_cpu_eip_get(struct emu_cpu *c)
@@ -196,6 +201,15 @@ uint32_t emu_cpu_eip_get(struct emu_cpu *c)
 
 void emu_cpu_free(struct emu_cpu *c)
 {
+	if( c->blocks != NULL )
+		emu_cpu_block_cache_free(c->blocks);
+
+	if( c->stats != NULL )
+		free(c->stats);
+
+	if( c->livelock != NULL )
+		free(c->livelock);
+
 	free(c->instr_string);
 	free(c);
 }
@@ -246,7 +260,7 @@ void emu_cpu_debug_print(struct emu_cpu *c)
 void debug_instruction(struct emu_instruction *ei)
 {
 	struct emu_cpu_instruction *i = &ei->cpu;
-	struct emu_cpu_instruction_info *ii;
+	const struct emu_cpu_instruction_info *ii;
 	
 	if( i->opc == 0x0f )
 		ii = &ii_twobyte[i->opc_2nd];
@@ -465,374 +479,190 @@ uint32_t dasm_print_instruction(uint32_t eip, uint8_t *data, uint32_t size, char
 	return instrsize;
 }
 
-int32_t emu_cpu_parse(struct emu_cpu *c)
+uint32_t dasm_instruction_size(uint8_t *data)
+{
+	INSTRUCTION inst;
+
+	return get_instruction(&inst, data, MODE_32);
+}
+
+const char *emu_cpu_instruction_string(struct emu_cpu *c)
+{
+	if( c->instr_string_valid == false )
+	{
+		dasm_print_instruction(c->instr_eip, c->instr_data, 0, c->instr_string);
+		c->instr_string_valid = true;
+	}
+
+	return c->instr_string;
+}
+
+static inline int32_t cpu_parse(struct emu_cpu *c)
 {
 	if (c->repeat_current_instr == true)
 	{
 		return 0;
 	}
 
-	/* TODO make unstatic for threadsafety */
-	uint8_t byte;
-	uint8_t *opcode;
-	uint32_t ret;
-	
-	c->instr.prefixes = 0;
-	
-	
+	if( CPU_OPTION_ISSET(c, block_cache) && c->debugflags == 0 && emu_cpu_block_fetch(c) == 0 )
+	{
+		return 0;
+	}
+
+	struct emu_decoded d;
+	uint8_t dis[32];
+	uint32_t len = sizeof(dis);
+	int32_t ret;
+
 //	logDebug(c->emu,"decoding\n");
 //	emu_cpu_debug_print(c);
 
-	uint8_t dis[32];
-	emu_memory_read_block(c->mem,c->eip,dis,32);
+	if( emu_memory_read_block(c->mem, c->eip, dis, sizeof(dis)) != 0 )
+	{
+		/* the code ends within the next 32 bytes, decode what is there */
+		memset(dis, 0, sizeof(dis));
+		for( len = 0; len < sizeof(dis); len++ )
+			if( emu_memory_read_byte(c->mem, c->eip + len, &dis[len]) != 0 )
+				break;
+	}
+
 	emu_breakpoint_check(c->mem,c->eip, EMU_ACCESS_EXECUTE);
 
+	/* keep the bytes, the disassembly is done only if someone asks for it */
+	if( CPU_DEBUG_FLAG_ISSET(c, instruction_string ) )
+	{
+		memcpy(c->instr_data, dis, sizeof(dis));
+		c->instr_eip = c->eip;
+		c->instr_string_valid = false;
+	}
+
 	uint32_t expected_instr_size = 0;
-	if( CPU_DEBUG_FLAG_ISSET(c, instruction_string ) || CPU_DEBUG_FLAG_ISSET(c, instruction_size ) )
+	if( CPU_DEBUG_FLAG_ISSET(c, instruction_size ) )
 	{
-		expected_instr_size = dasm_print_instruction(c->eip,dis,0,c->instr_string);
+		expected_instr_size = dasm_instruction_size(dis);
 	}
 
 	uint32_t eip_before = c->eip;
-	uint32_t eip_after = 0;
 
+	ret = emu_cpu_decode_instruction(dis, len, &d);
 
-	/* reset the instruction source and track infos, maybe move to a fn and call the fn instead? */
+	if( ret <= 0 && CPU_OPTION_ISSET(c, opcode_stats) )
+		emu_cpu_stats_fault(c);
 
-	c->instr.source.has_cond_pos = 0;
+	if( ret == 0 )
+	{
+		/* the memory error is set already, unless the instruction does not fit */
+		if( len == sizeof(dis) )
+		{
+			emu_error_set(c->emu, EINVAL, "instruction at 0x%08x too long\n", c->eip);
+		}
+		return -1;
+	}
+
+	if( ret == -1 )
+	{
+		emu_error_set(c->emu, EOPNOTSUPP, "opcode %02x not supported\n", d.instr.cpu.opc);
+		return -1;
+	}
 
-	c->instr.track.init.eflags = 0;
-	memset(c->instr.track.init.reg, 0, sizeof(uint32_t) * 8);
-	c->instr.track.init.fpu = 0;
+	/* the static masks are a lookup in the generated track tables */
+	if( c->tracking != NULL )
+		emu_cpu_decode_track(&d);
 
-	c->instr.track.need.eflags = 0;
-	memset(c->instr.track.need.reg, 0, sizeof(uint32_t) * 8);
-	c->instr.track.need.fpu = 0;
+	/* the source and track infos are reset by the decoder, keep the imm
+	 * pointers into our own instruction */
+	uint8_t *imm8 = c->instr.cpu.imm8;
+	uint16_t *imm16 = c->instr.cpu.imm16;
 
+	c->instr = d.instr;
+	c->instr.cpu.imm8 = imm8;
+	c->instr.cpu.imm16 = imm16;
+	c->cpu_instr_info = d.info;
 
-	while( 1 )
+	/* the registers part of the effective address */
+	if( d.flags & EMU_DECODED_MEMORY )
 	{
-		ret = emu_memory_read_byte(c->mem, c->eip++, &byte);
-		
-		if( ret != 0 )
-			return ret;
-		
-		c->cpu_instr_info = &ii_onebyte[byte];
-	
-		if( c->cpu_instr_info->function == prefix_fn )
-		{
-			c->instr.prefixes |= prefix_map[byte];
-			continue;
-		}
-		else
-		{
-			c->instr.opc = byte;
-			if( c->cpu_instr_info->format.fpu_info == 0 )
-			{
-				c->instr.is_fpu = 0;
-				c->instr.cpu.opc = c->instr.opc;
-				c->instr.cpu.prefixes = c->instr.prefixes;
-				
-				if( c->instr.cpu.opc == 0x0f )
-				{
-					ret = emu_memory_read_byte(c->mem, c->eip++, &byte);
-			
-					if( ret != 0 )
-						return ret;
-						
-					c->instr.cpu.opc_2nd = byte;
-					opcode = &c->instr.cpu.opc_2nd;
-					c->cpu_instr_info = &ii_twobyte[byte];
-				}
-				else
-				{
-					opcode = &c->instr.cpu.opc;
-				}
-				
-				if ( c->cpu_instr_info->function == 0 )
-				{
-					emu_strerror_set(c->emu,"opcode %02x not supported\n", c->instr.cpu.opc);
-					emu_errno_set(c->emu, EOPNOTSUPP);
-/*					int y=0;
-					for (y=0;y<expected_instr_size;y++)
-					{
-						printf("%02x ", dis[y]);
-					}
-					printf("\n");
-*/
-					return -1;
-				}
-				
-				c->instr.cpu.w_bit = *opcode & 1;
-				c->instr.cpu.s_bit = (*opcode >> 1) & 1;
-	
-				/* mod r/m byte?  sib/disp */
-				if( c->cpu_instr_info->format.modrm_byte != 0 )
-				{
-					ret = emu_memory_read_byte(c->mem, c->eip++, &byte);
-			
-					if( ret != 0 )
-						return ret;
-						
-					c->instr.cpu.modrm.mod = MODRM_MOD(byte);
-					c->instr.cpu.modrm.opc = MODRM_REGOPC(byte);
-					c->instr.cpu.modrm.rm = MODRM_RM(byte);
-					
-					if( c->cpu_instr_info->format.modrm_byte == II_MOD_REG_RM || c->cpu_instr_info->format.modrm_byte == II_MOD_YYY_RM ||
-						c->cpu_instr_info->format.modrm_byte == II_XX_REG1_REG2) /* cases with possible sib/disp*/
-					{
-						if( c->instr.cpu.modrm.mod != 3 )
-						{
-							if( c->instr.cpu.modrm.rm != 4 && !(c->instr.cpu.modrm.mod == 0 && c->instr.cpu.modrm.rm == 5) )
-							{
-                                c->instr.cpu.modrm.ea = c->reg[c->instr.cpu.modrm.rm];
-								TRACK_NEED_REG32(c->instr, c->instr.cpu.modrm.rm);
-							}
-							else
-								c->instr.cpu.modrm.ea = 0;
-							
-							if( c->instr.cpu.modrm.rm == 4 ) /* sib byte present */
-							{
-								ret = emu_memory_read_byte(c->mem, c->eip++, &byte);
-			
-								if( ret != 0 )
-									return ret;
-									
-								c->instr.cpu.modrm.sib.base = SIB_BASE(byte);
-								c->instr.cpu.modrm.sib.scale = SIB_SCALE(byte);
-								c->instr.cpu.modrm.sib.index = SIB_INDEX(byte);
-								
-								if( c->instr.cpu.modrm.sib.base != 5 )
-								{
-									c->instr.cpu.modrm.ea += c->reg[c->instr.cpu.modrm.sib.base];
-									TRACK_NEED_REG32(c->instr, c->instr.cpu.modrm.sib.base);
-								}
-								else if( c->instr.cpu.modrm.mod != 0 )
-								{
-									c->instr.cpu.modrm.ea += c->reg[ebp];
-									TRACK_NEED_REG32(c->instr, ebp);
-								}
-	
-								if( c->instr.cpu.modrm.sib.index != 4 )
-								{
-									c->instr.cpu.modrm.ea += c->reg[c->instr.cpu.modrm.sib.index] * scalem[c->instr.cpu.modrm.sib.scale];
-									TRACK_NEED_REG32(c->instr, c->instr.cpu.modrm.sib.index);
-								}
-							}
-							
-							if( c->instr.cpu.modrm.mod == 1 ) /* disp8 */
-							{
-								ret = emu_memory_read_byte(c->mem, c->eip++, &c->instr.cpu.modrm.disp.s8);
-			
-								if( ret != 0 )
-									return ret;
-								
-								c->instr.cpu.modrm.ea += (int8_t)c->instr.cpu.modrm.disp.s8;
-							}
-							else if( c->instr.cpu.modrm.mod == 2 || (c->instr.cpu.modrm.mod == 0 && c->instr.cpu.modrm.rm == 5) ) /* disp32 */
-							{
-								ret = emu_memory_read_dword(c->mem, c->eip, &c->instr.cpu.modrm.disp.s32);
-								c->eip += 4;
-			
-								if( ret != 0 )
-									return ret;
-	
-								c->instr.cpu.modrm.ea += c->instr.cpu.modrm.disp.s32;
-							}
-						}
-					}
-				}
-				
-				/* */
-				c->instr.cpu.operand_size = 0;
-				
-				if( c->cpu_instr_info->format.imm_data == II_IMM8 || c->cpu_instr_info->format.disp_data == II_DISP8 )
-					c->instr.cpu.operand_size = OPSIZE_8;
-				else if( c->cpu_instr_info->format.imm_data == II_IMM16 || c->cpu_instr_info->format.disp_data == II_DISP16 )
-					c->instr.cpu.operand_size = OPSIZE_16;
-				else if( c->cpu_instr_info->format.imm_data == II_IMM32 || c->cpu_instr_info->format.disp_data == II_DISP32 )
-					c->instr.cpu.operand_size = OPSIZE_32;
-				else if( c->cpu_instr_info->format.imm_data == II_IMM || c->cpu_instr_info->format.disp_data == II_DISPF
-					 || (c->cpu_instr_info->format.type && !c->instr.cpu.modrm.opc))
-				{
-					if( c->cpu_instr_info->format.w_bit == 1 && c->instr.cpu.w_bit == 0 )
-						c->instr.cpu.operand_size = OPSIZE_8;
-					else
-					{
-						if( c->instr.cpu.prefixes & PREFIX_OPSIZE )
-							c->instr.cpu.operand_size = OPSIZE_16;
-						else
-							c->instr.cpu.operand_size = OPSIZE_32;
-					}
-				}
-				
-				/* imm */
-				if( c->cpu_instr_info->format.imm_data != 0 || (c->cpu_instr_info->format.type && !c->instr.cpu.modrm.opc))
-				{
-					if( c->instr.cpu.operand_size == OPSIZE_32 )
-					{
-						ret = emu_memory_read_dword(c->mem, c->eip, &c->instr.cpu.imm);
-						c->eip += 4;
-					}
-					else if( c->instr.cpu.operand_size == OPSIZE_8 )
-					{
-						ret = emu_memory_read_byte(c->mem, c->eip++, c->instr.cpu.imm8);
-					}
-					else if( c->instr.cpu.operand_size == OPSIZE_16 )
-					{
-						ret = emu_memory_read_word(c->mem, c->eip, c->instr.cpu.imm16);
-						c->eip += 2;
-					}
-	
-					if( ret != 0 )
-						return ret;
-				}
-				
-				/* disp */
-				if( c->cpu_instr_info->format.disp_data != 0 )
-				{
-					if( c->instr.cpu.operand_size == OPSIZE_32 )
-					{
-						uint32_t disp32;
-						ret = emu_memory_read_dword(c->mem, c->eip, &disp32);
-						c->instr.cpu.disp = (int32_t)disp32;
-						c->eip += 4;
-					}
-					else if( c->instr.cpu.operand_size == OPSIZE_16 )
-					{
-						uint16_t disp16;
-						ret = emu_memory_read_word(c->mem, c->eip, &disp16);
-						c->instr.cpu.disp = (int16_t)disp16;
-						c->eip += 2;
-					}
-					else if( c->instr.cpu.operand_size == OPSIZE_8 )
-					{
-						uint8_t disp8;
-						ret = emu_memory_read_byte(c->mem, c->eip++, &disp8);
-						c->instr.cpu.disp = (int8_t)disp8;
-					}
-	
-					if( ret != 0 )
-						return ret;
-				}
-				
-				/* TODO level type ... */
-			}
-			else /* fpu */
-			{
-				/* this is a minimal parser without exact decomposition
-				 * into all fields. instead it determines the length of
-				 * the instruction and ignores pretty much everything else
-				 * except for a few explicitly implemented instructions. */
-				c->instr.is_fpu = 1;
-				c->instr.fpu.prefixes = c->instr.prefixes;
-
-				c->instr.fpu.fpu_data[0] = c->instr.opc;
-
-				ret = emu_memory_read_byte(c->mem, c->eip++, &c->instr.fpu.fpu_data[1]);
-				if( ret != 0 )
-					return ret;
-				
-				if( FPU_MOD(c->instr.fpu.fpu_data) != 3 ) /* intel pdf page 36 */
-				{
-					/* trivial case, one register is ea */
-		   			if( FPU_RM(c->instr.fpu.fpu_data) != 4 && !(FPU_MOD(c->instr.fpu.fpu_data) == 0 && FPU_RM(c->instr.fpu.fpu_data) == 5) )
-						c->instr.fpu.ea = c->reg[FPU_RM(c->instr.fpu.fpu_data)];
-					else
-						c->instr.fpu.ea = 0;
-					
-					/* sib byte */
-					if( FPU_RM(c->instr.fpu.fpu_data) == 4 )
-					{
-						ret = emu_memory_read_byte(c->mem, c->eip++, &byte);
-			
-						if( ret != 0 )
-							return ret;
-						
-						if( SIB_BASE(byte) != 5 )
-						{
-							c->instr.fpu.ea += c->reg[SIB_BASE(byte)];
-						}
-						else if( FPU_MOD(c->instr.fpu.fpu_data) != 0 )
-						{
-							c->instr.fpu.ea += c->reg[ebp];
-						}
+		uint32_t ea = 0;
 
-						if( SIB_INDEX(byte) != 4 )
-						{
-							c->instr.fpu.ea += c->reg[SIB_INDEX(byte)] * scalem[SIB_SCALE(byte)];
-						}
-					}
-					
-					/* modrm */
-					if( FPU_MOD(c->instr.fpu.fpu_data) == 1 )
-					{
-						ret = emu_memory_read_byte(c->mem, c->eip++, &byte);
+		if( d.ea.base != EMU_DECODED_NOREG )
+			ea += c->reg[d.ea.base];
 
-						if( ret != 0 )
-							return ret;
-						
-						c->instr.fpu.ea += (int8_t)byte;
-					}
-					else if( FPU_MOD(c->instr.fpu.fpu_data) == 2 || (FPU_MOD(c->instr.fpu.fpu_data) == 0 && FPU_RM(c->instr.fpu.fpu_data) == 5) ) 
-					{
-						uint32_t dword;
-						ret = emu_memory_read_dword(c->mem, c->eip, &dword);
-						c->eip += 4;
+		if( d.ea.index != EMU_DECODED_NOREG )
+			ea += c->reg[d.ea.index] * d.ea.scale;
 
-						if( ret != 0 )
-							return ret;
+		if( c->instr.is_fpu == 0 )
+			c->instr.cpu.modrm.ea += ea;
+		else
+			c->instr.fpu.ea += ea;
+	}
 
-						c->instr.fpu.ea += dword;
-					}
-				}
-				
-				/*c->instr.fpu.last_instr = c->last_fpu_instr;*/
-				
-				
-				c->last_fpu_instr[1] = c->last_fpu_instr[0]; 
-				c->last_fpu_instr[0] = eip_before;
-			}
-			
-//			logDebug(c->emu,"\n");
+	if( c->instr.is_fpu == 1 )
+	{
+		/*c->instr.fpu.last_instr = c->last_fpu_instr;*/
+		c->last_fpu_instr[1] = c->last_fpu_instr[0]; 
+		c->last_fpu_instr[0] = eip_before;
+	}
 
-			eip_after = c->eip;
-			if ( CPU_DEBUG_FLAG_ISSET(c, instruction_size ) && eip_after - eip_before != expected_instr_size)
-			{
-				logDebug(c->emu, "broken instr.cpu size %i %i\n",
-					   eip_after - eip_before,
-					   expected_instr_size);
-				return -1;
-			}
+	c->eip += ret;
 
+	if ( CPU_DEBUG_FLAG_ISSET(c, instruction_size ) && (uint32_t)ret != expected_instr_size)
+	{
+		logDebug(c->emu, "broken instr.cpu size %i %i\n",
+			   ret,
+			   expected_instr_size);
+		return -1;
+	}
 
-			/* the default normal position is behind the instruction, specific instructions as call jmp set their
-			 * norm position 
-			 */
-			if ( c->instr.is_fpu == 0 )
-			{
-				SOURCE_NORM_POS(c->instr, c->eip);
-			}
-			else
-			{
-				SOURCE_NORM_POS(c->instr, c->eip);
-			}
+	/* the default normal position is behind the instruction, specific instructions as call jmp set their
+	 * norm position 
+	 */
+	SOURCE_NORM_POS(c->instr, c->eip);
 
+	if( c->blocks != NULL && c->debugflags == 0 )
+		return emu_cpu_block_store(c, eip_before);
+	
+	return 0;
+}
 
-			break;
+int32_t emu_cpu_parse(struct emu_cpu *c)
+{
+	if( c->interrupt_countdown-- == 0 )
+	{
+		c->interrupt_countdown = EMU_INTERRUPT_INTERVAL - 1;
+		if( emu_interrupted(c->emu) != 0 )
+		{
+			/* stay interrupted */
+			c->interrupt_countdown = 0;
+			return -1;
 		}
 	}
-	
-	return 0;
+
+	if( (c->coverage != NULL || c->trace != NULL) && c->repeat_current_instr == false )
+	{
+		uint32_t eip = c->eip;
+		int32_t ret = cpu_parse(c);
+
+		if( ret == 0 && c->coverage != NULL )
+			emu_coverage_hit(c->coverage, eip, c->eip);
+
+		if( c->trace != NULL )
+			emu_trace_parse(c->trace, c, eip, ret);
+
+		return ret;
+	}
+
+	return cpu_parse(c);
 }
 
-int32_t emu_cpu_step(struct emu_cpu *c)
+static inline int32_t cpu_step(struct emu_cpu *c)
 {
 	int32_t ret = 0;
 
 	/* call the function */
 	if( c->instr.is_fpu == 0 )
 	{
+		uint32_t next_eip = c->eip;
+
 		if( c->instr.cpu.prefixes & PREFIX_FS_OVR )
 		{
 			emu_memory_segment_select(c->mem, s_fs);
@@ -844,49 +674,36 @@ int32_t emu_cpu_step(struct emu_cpu *c)
 		{
 			emu_memory_segment_select(c->mem, s_cs);
 		}
+
+		/* a short loop/jnz just jumped backwards, maybe a decoder */
+		if( CPU_OPTION_ISSET(c, loop_fastforward) && ret == 0 && c->instr.cpu.prefixes == 0 &&
+			(c->instr.cpu.opc == 0xe2 || c->instr.cpu.opc == 0x75) && c->eip < c->instr.source.norm_pos )
+		{
+			emu_cpu_loop_fastforward(c, c->instr.source.norm_pos - 2);
+		}
+
+		/* a backward branch was taken, maybe going round in circles */
+		if( CPU_OPTION_ISSET(c, livelock_detect) && ret == 0 && c->eip < next_eip )
+			ret = emu_cpu_livelock_check(c);
 	}
 	else
 	{
-		/* for now we only support three critical instructions. */
-		if( c->instr.fpu.fpu_data[0] == 0xd9 )
-		{
-			if( (c->instr.fpu.fpu_data[1] & 0x38) == 0x30 )
-			{
-				/* fnstenv volume 1, page 230 */
-				static int null = 0;
-				MEM_DWORD_WRITE(c, c->instr.fpu.ea + 0x00, null);
-				MEM_DWORD_WRITE(c, c->instr.fpu.ea + 0x04, null);
-				MEM_DWORD_WRITE(c, c->instr.fpu.ea + 0x08, null);
-				MEM_DWORD_WRITE(c, c->instr.fpu.ea + 0x0c, c->last_fpu_instr[1]);
-				MEM_DWORD_WRITE(c, c->instr.fpu.ea + 0x10, null);
-				MEM_DWORD_WRITE(c, c->instr.fpu.ea + 0x14, null);
-				MEM_DWORD_WRITE(c, c->instr.fpu.ea + 0x18, null);
-
-				TRACK_NEED_FPU(c->instr, TRACK_FPU_LAST_INSTRUCTION);
-//				TRACK_INIT_FPU(c->instr, TRACK_FPU_LAST_INSTRUCTION);
-			}
-			else if( c->instr.fpu.fpu_data[1] == 0xee )
-			{
-				/* fldz */
-				TRACK_INIT_FPU(c->instr, TRACK_FPU_LAST_INSTRUCTION);
-			}
-			else
-			{ // catch all others to init fpu
-				TRACK_INIT_FPU(c->instr, TRACK_FPU_LAST_INSTRUCTION);
-			}
-
-		}
-		else if( c->instr.fpu.fpu_data[0] == 0xdd )
+		/* for now we only support fnstenv, the track information of the
+		 * other fpu instructions is set by emu_cpu_decode_track */
+		if( c->instr.fpu.fpu_data[0] == 0xd9 && (c->instr.fpu.fpu_data[1] & 0x38) == 0x30 )
 		{
-			if( (c->instr.fpu.fpu_data[1] & 0xf8) == 0xc0 )
-			{
-				/* ffree */
-				TRACK_INIT_FPU(c->instr, TRACK_FPU_LAST_INSTRUCTION);
-			}
+			/* fnstenv volume 1, page 230 */
+			uint32_t null = 0;
+			MEM_DWORD_WRITE(c, c->instr.fpu.ea + 0x00, null);
+			MEM_DWORD_WRITE(c, c->instr.fpu.ea + 0x04, null);
+			MEM_DWORD_WRITE(c, c->instr.fpu.ea + 0x08, null);
+			MEM_DWORD_WRITE(c, c->instr.fpu.ea + 0x0c, c->last_fpu_instr[1]);
+			MEM_DWORD_WRITE(c, c->instr.fpu.ea + 0x10, null);
+			MEM_DWORD_WRITE(c, c->instr.fpu.ea + 0x14, null);
+			MEM_DWORD_WRITE(c, c->instr.fpu.ea + 0x18, null);
 		}
 	}
 
-
 	if (0)
 		debug_instruction(&c->instr);
 //	emu_cpu_debug_print(c);
@@ -894,6 +711,28 @@ int32_t emu_cpu_step(struct emu_cpu *c)
 	return ret;
 }
 
+int32_t emu_cpu_step(struct emu_cpu *c)
+{
+	uint64_t start = 0;
+	int32_t ret;
+
+	if( !CPU_OPTION_ISSET(c, opcode_stats) && c->trace == NULL )
+		return cpu_step(c);
+
+	if( CPU_OPTION_ISSET(c, opcode_stats) )
+		start = emu_cpu_stats_step_begin(c);
+
+	ret = cpu_step(c);
+
+	if( CPU_OPTION_ISSET(c, opcode_stats) )
+		emu_cpu_stats_step_end(c, start, ret);
+
+	if( c->trace != NULL )
+		emu_trace_step(c->trace, c, ret);
+
+	return ret;
+}
+
 int32_t emu_cpu_run(struct emu_cpu *c)
 {
 	int steps=0;
@@ -920,3 +759,13 @@ void emu_cpu_debugflag_unset(struct emu_cpu *c, uint8_t flag)
 	CPU_DEBUG_FLAG_UNSET(c, flag);	
 }
 
+void emu_cpu_option_set(struct emu_cpu *c, uint8_t option)
+{
+	CPU_OPTION_SET(c, option);
+}
+
+void emu_cpu_option_unset(struct emu_cpu *c, uint8_t option)
+{
+	CPU_OPTION_UNSET(c, option);
+}
+
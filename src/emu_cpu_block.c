@@ -0,0 +1,406 @@
+/********************************************************************************
+ *                               libemu
+ *
+ *                    - x86 shellcode emulation -
+ *
+ *
+ * Copyright (C) 2007  Paul Baecher & Markus Koetter
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *
+ *             contact nepenthesdev@users.sourceforge.net
+ *
+ *******************************************************************************/
+
+/*
+ * block cache
+ *
+ * Blocks of straight code which are entered often get recorded while the
+ * interpreter decodes them. Later runs of the block take the decoded
+ * instructions from the cache instead of decoding them from memory byte by
+ * byte, only the effective address has to be calculated from the current
+ * registers.
+ * The bytes of a block are compared to the memory whenever the block is
+ * entered, and again whenever the memory was written while running it, so
+ * self modifying code is always decoded from what is in memory.
+ *
+ * With block_cache_verify, every instruction taken from the cache is decoded
+ * again and both results are compared, a difference fails emu_cpu_parse.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "emu/emu.h"
+#include "emu/emu_cpu.h"
+#include "emu/emu_cpu_data.h"
+#include "emu/emu_memory.h"
+#include "emu/emu_hashtable.h"
+#include "emu/emu_log.h"
+
+/* number of entries before a block gets recorded */
+#define BLOCK_HOT 16
+
+#define BLOCK_INSTR_MAX 16
+#define BLOCK_SIZE_MAX 64
+
+struct emu_cpu_block_instr
+{
+	struct emu_instruction instr;
+	const struct emu_cpu_instruction_info *info;
+	uint32_t eip;
+	uint8_t length;
+};
+
+struct emu_cpu_block
+{
+	uint32_t eip;
+	uint32_t hits;
+
+	uint32_t size;
+	uint32_t count;
+	/* recorded with the track information, see emu_cpu_decode_track */
+	bool tracked;
+	uint8_t bytes[BLOCK_SIZE_MAX];
+	struct emu_cpu_block_instr *instrs;
+};
+
+struct emu_cpu_block_cache
+{
+	struct emu_hashtable *blocks;
+
+	/* the block we are running or recording */
+	struct emu_cpu_block *current;
+	uint32_t index;
+	bool recording;
+
+	/* eip behind the last decoded instruction */
+	uint32_t next_eip;
+	uint32_t writes;
+
+	bool verifying;
+	struct emu_cpu_block_instr verify;
+};
+
+static void emu_cpu_block_free(void *data)
+{
+	struct emu_cpu_block *b = (struct emu_cpu_block *)data;
+
+	if( b->instrs != NULL )
+		free(b->instrs);
+
+	free(b);
+}
+
+static struct emu_cpu_block_cache *emu_cpu_block_cache_new(void)
+{
+	struct emu_cpu_block_cache *cache = (struct emu_cpu_block_cache *)malloc(sizeof(struct emu_cpu_block_cache));
+	if( cache == NULL )
+		return NULL;
+
+	memset(cache, 0, sizeof(struct emu_cpu_block_cache));
+
+	cache->blocks = emu_hashtable_new(1021, emu_hashtable_ptr_hash, emu_hashtable_ptr_cmp);
+	if( cache->blocks == NULL )
+	{
+		free(cache);
+		return NULL;
+	}
+
+	cache->blocks->value_destructor = emu_cpu_block_free;
+
+	return cache;
+}
+
+void emu_cpu_block_cache_free(struct emu_cpu_block_cache *cache)
+{
+	emu_hashtable_free(cache->blocks);
+	free(cache);
+}
+
+void emu_cpu_block_cache_reset(struct emu_cpu_block_cache *cache)
+{
+	cache->current = NULL;
+	cache->recording = false;
+	cache->verifying = false;
+}
+
+static void emu_cpu_block_invalidate(struct emu_cpu_block *b)
+{
+	b->count = 0;
+	b->size = 0;
+	b->hits = 0;
+}
+
+/**
+ * compare the blocks bytes starting at offset with the memory
+ */
+static bool emu_cpu_block_valid(struct emu_cpu *c, struct emu_cpu_block *b, uint32_t offset)
+{
+	uint8_t bytes[BLOCK_SIZE_MAX];
+
+	if( emu_memory_read_block(c->mem, b->eip + offset, bytes, b->size - offset) != 0 )
+		return false;
+
+	return memcmp(bytes, b->bytes + offset, b->size - offset) == 0;
+}
+
+/**
+ * the effective address depends on the registers, so it can not be cached
+ */
+static void emu_cpu_block_ea(struct emu_cpu *c, struct emu_cpu_instruction *i, const struct emu_cpu_instruction_info *ii)
+{
+	uint8_t form = ii->format.modrm_byte;
+
+	if( form != II_MOD_REG_RM && form != II_MOD_YYY_RM && form != II_XX_REG1_REG2 )
+		return;
+
+	if( i->modrm.mod == 3 )
+		return;
+
+	if( i->modrm.rm != 4 && !(i->modrm.mod == 0 && i->modrm.rm == 5) )
+		i->modrm.ea = c->reg[i->modrm.rm];
+	else
+		i->modrm.ea = 0;
+
+	if( i->modrm.rm == 4 )
+	{
+		if( i->modrm.sib.base != 5 )
+			i->modrm.ea += c->reg[i->modrm.sib.base];
+		else if( i->modrm.mod != 0 )
+			i->modrm.ea += c->reg[ebp];
+
+		if( i->modrm.sib.index != 4 )
+			i->modrm.ea += c->reg[i->modrm.sib.index] << i->modrm.sib.scale;
+	}
+
+	if( i->modrm.mod == 1 )
+		i->modrm.ea += (int8_t)i->modrm.disp.s8;
+	else if( i->modrm.mod == 2 || (i->modrm.mod == 0 && i->modrm.rm == 5) )
+		i->modrm.ea += i->modrm.disp.s32;
+}
+
+static bool emu_cpu_block_instr_equal(struct emu_cpu_block_instr *a, struct emu_cpu *c, uint32_t eip)
+{
+	struct emu_cpu_instruction *x = &a->instr.cpu;
+	struct emu_cpu_instruction *y = &c->instr.cpu;
+	const struct emu_cpu_instruction_info *ii = c->cpu_instr_info;
+
+	if( a->eip != eip || a->eip + a->length != c->eip || a->info != ii )
+		return false;
+
+	if( a->instr.is_fpu != c->instr.is_fpu || a->instr.prefixes != c->instr.prefixes || a->instr.opc != c->instr.opc )
+		return false;
+
+	if( x->opc != y->opc || (x->opc == 0x0f && x->opc_2nd != y->opc_2nd) || x->prefixes != y->prefixes ||
+		x->w_bit != y->w_bit || x->s_bit != y->s_bit || x->operand_size != y->operand_size )
+		return false;
+
+	if( ii->format.modrm_byte != 0 )
+	{
+		if( x->modrm.mod != y->modrm.mod || x->modrm.opc != y->modrm.opc || x->modrm.rm != y->modrm.rm )
+			return false;
+
+		if( (ii->format.modrm_byte == II_MOD_REG_RM || ii->format.modrm_byte == II_MOD_YYY_RM ||
+			 ii->format.modrm_byte == II_XX_REG1_REG2) && x->modrm.mod != 3 && x->modrm.ea != y->modrm.ea )
+			return false;
+	}
+
+	if( ii->format.imm_data != 0 || (ii->format.type && !y->modrm.opc) )
+	{
+		uint32_t mask = 0xffffffff;
+
+		if( y->operand_size == OPSIZE_8 )
+			mask = 0xff;
+		else if( y->operand_size == OPSIZE_16 )
+			mask = 0xffff;
+
+		if( (x->imm & mask) != (y->imm & mask) )
+			return false;
+	}
+
+	if( ii->format.disp_data != 0 && x->disp != y->disp )
+		return false;
+
+	if( memcmp(&a->instr.track, &c->instr.track, sizeof(a->instr.track)) != 0 )
+		return false;
+
+	if( a->instr.source.norm_pos != c->instr.source.norm_pos )
+		return false;
+
+	return true;
+}
+
+static void emu_cpu_block_serve(struct emu_cpu *c, struct emu_cpu_block_cache *cache)
+{
+	struct emu_cpu_block_instr *bi = &cache->current->instrs[cache->index++];
+
+	cache->next_eip = bi->eip + bi->length;
+
+	if( CPU_OPTION_ISSET(c, block_cache_verify) )
+	{
+		memcpy(&cache->verify, bi, sizeof(struct emu_cpu_block_instr));
+		emu_cpu_block_ea(c, &cache->verify.instr.cpu, bi->info);
+		cache->verifying = true;
+		return;
+	}
+
+	memcpy(&c->instr, &bi->instr, sizeof(struct emu_instruction));
+	c->cpu_instr_info = bi->info;
+	c->eip = cache->next_eip;
+
+	emu_cpu_block_ea(c, &c->instr.cpu, c->cpu_instr_info);
+}
+
+int32_t emu_cpu_block_fetch(struct emu_cpu *c)
+{
+	struct emu_cpu_block_cache *cache = c->blocks;
+	struct emu_cpu_block *b;
+
+	if( cache == NULL )
+	{
+		if( (c->blocks = cache = emu_cpu_block_cache_new()) == NULL )
+			return -1;
+	}
+
+	/* a previous decode may have failed */
+	cache->verifying = false;
+
+	b = cache->current;
+	if( b != NULL && c->eip == cache->next_eip )
+	{
+		/* straight on */
+		if( cache->recording == true )
+			return -1;
+
+		if( cache->index < b->count )
+		{
+			if( emu_memory_get_writes(c->mem) != cache->writes )
+			{
+				if( emu_cpu_block_valid(c, b, b->instrs[cache->index].eip - b->eip) == false )
+				{
+					emu_cpu_block_invalidate(b);
+					cache->current = NULL;
+					return -1;
+				}
+
+				cache->writes = emu_memory_get_writes(c->mem);
+			}
+
+			emu_cpu_block_serve(c, cache);
+			return cache->verifying ? -1 : 0;
+		}
+	}
+
+	/* entering a new block */
+	cache->current = NULL;
+	cache->recording = false;
+
+	struct emu_hashtable_item *ehi = emu_hashtable_search(cache->blocks, (void *)(uintptr_t)c->eip);
+	if( ehi != NULL )
+	{
+		b = (struct emu_cpu_block *)ehi->value;
+	}
+	else
+	{
+		if( (b = (struct emu_cpu_block *)malloc(sizeof(struct emu_cpu_block))) == NULL )
+			return -1;
+
+		memset(b, 0, sizeof(struct emu_cpu_block));
+		b->eip = c->eip;
+		emu_hashtable_insert(cache->blocks, (void *)(uintptr_t)c->eip, b);
+	}
+
+	b->hits++;
+
+	if( b->count > 0 )
+	{
+		if( b->tracked == (c->tracking != NULL) && emu_cpu_block_valid(c, b, 0) == true )
+		{
+			cache->current = b;
+			cache->index = 0;
+			cache->writes = emu_memory_get_writes(c->mem);
+
+			emu_cpu_block_serve(c, cache);
+			return cache->verifying ? -1 : 0;
+		}
+
+		emu_cpu_block_invalidate(b);
+	}
+	else
+	if( b->hits >= BLOCK_HOT )
+	{
+		if( b->instrs == NULL &&
+			(b->instrs = (struct emu_cpu_block_instr *)malloc(sizeof(struct emu_cpu_block_instr) * BLOCK_INSTR_MAX)) == NULL )
+			return -1;
+
+		cache->current = b;
+		cache->recording = true;
+		b->tracked = c->tracking != NULL;
+	}
+
+	return -1;
+}
+
+int32_t emu_cpu_block_store(struct emu_cpu *c, uint32_t eip_before)
+{
+	struct emu_cpu_block_cache *cache = c->blocks;
+	struct emu_cpu_block *b = cache->current;
+	uint32_t length = c->eip - eip_before;
+
+	cache->next_eip = c->eip;
+
+	if( cache->verifying == true )
+	{
+		cache->verifying = false;
+
+		if( emu_cpu_block_instr_equal(&cache->verify, c, eip_before) == false )
+		{
+			emu_strerror_set(c->emu, "block cache differs from the decoder at 0x%08x\n", eip_before);
+			emu_errno_set(c->emu, EINVAL);
+			return -1;
+		}
+
+		return 0;
+	}
+
+	if( cache->recording == false || b == NULL )
+		return 0;
+
+	if( c->instr.is_fpu == 1 || b->count == BLOCK_INSTR_MAX || b->size + length > BLOCK_SIZE_MAX ||
+		eip_before != b->eip + b->size ||
+		emu_memory_read_block(c->mem, eip_before, b->bytes + b->size, length) != 0 )
+	{
+		/* the block is complete */
+		cache->recording = false;
+		cache->index = b->count;
+		return 0;
+	}
+
+	struct emu_cpu_block_instr *bi = &b->instrs[b->count++];
+	memcpy(&bi->instr, &c->instr, sizeof(struct emu_instruction));
+	bi->info = c->cpu_instr_info;
+	bi->eip = eip_before;
+	bi->length = length;
+
+	b->size += length;
+	cache->index = b->count;
+
+	return 0;
+}
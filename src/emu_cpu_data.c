@@ -38,7 +38,7 @@
  * where signed/min is 0 
  * and unsigned/max is 1 
  */
-int64_t max_inttype_borders[][2][2] =                                            
+const int64_t max_inttype_borders[][2][2] =                                            
 {                                                                          
 	{                                                                      
 		{0, 0},                                                             
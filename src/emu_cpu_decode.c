@@ -0,0 +1,714 @@
+/********************************************************************************
+ *                               libemu
+ *
+ *                    - x86 shellcode emulation -
+ *
+ *
+ * Copyright (C) 2007  Paul Baecher & Markus Koetter
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *
+ *             contact nepenthesdev@users.sourceforge.net
+ *
+ *******************************************************************************/
+
+/*
+ * the instruction decoder
+ *
+ * emu_cpu_parse reads the bytes at eip and hands them to
+ * emu_cpu_decode_instruction, which only knows about the bytes. The
+ * registers are added to the effective address by emu_cpu_parse afterwards.
+ *
+ * emu_cpu_decode additionally works out what the instruction functions in
+ * src/functions/ would store as source and track information when running
+ * the instruction, so the static analysis does not have to run them.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "emu/emu.h"
+#include "emu/emu_cpu.h"
+#include "emu/emu_cpu_data.h"
+#include "emu/emu_cpu_decode.h"
+
+static const uint16_t prefix_map[0x100] = {
+	[0x26] = PREFIX_ES_OVR,
+	[0x2e] = PREFIX_CS_OVR,
+	[0x36] = PREFIX_SS_OVR,
+	[0x3e] = PREFIX_DS_OVR,
+	[0x64] = PREFIX_FS_OVR,
+	[0x65] = PREFIX_GS_OVR,
+	[0x66] = PREFIX_OPSIZE,
+	[0x67] = PREFIX_ADSIZE,
+	[0xf0] = PREFIX_LOCK,
+	[0xf2] = PREFIX_F2,
+	[0xf3] = PREFIX_F3,
+};
+
+#include "emu/emu_cpu_itables.h"
+
+/* fetch the next byte, 0 if the buffer ends */
+#define DECODE_BYTE(to) \
+	do { if( pos >= len ) return 0; (to) = buf[pos++]; } while( 0 )
+
+#define DECODE_WORD(to) \
+	do { if( pos + 2 > len ) return 0; (to) = buf[pos] | buf[pos+1] << 8; pos += 2; } while( 0 )
+
+#define DECODE_DWORD(to) \
+	do { if( pos + 4 > len ) return 0; \
+		(to) = buf[pos] | buf[pos+1] << 8 | buf[pos+2] << 16 | (uint32_t)buf[pos+3] << 24; pos += 4; } while( 0 )
+
+/**
+ * decode the sib byte and the displacement of a memory operand
+ *
+ * @return 1 on success, 0 if the buffer ends
+ */
+static int32_t decode_ea(const uint8_t *buf, size_t len, size_t *ppos, uint8_t mod, uint8_t rm, struct emu_decoded *out, uint32_t *disp)
+{
+	size_t pos = *ppos;
+	uint8_t byte;
+
+	*disp = 0;
+
+	if( rm != 4 && !(mod == 0 && rm == 5) )
+		out->ea.base = rm;
+
+	if( rm == 4 ) /* sib byte present */
+	{
+		DECODE_BYTE(byte);
+
+		out->instr.cpu.modrm.sib.base = SIB_BASE(byte);
+		out->instr.cpu.modrm.sib.scale = SIB_SCALE(byte);
+		out->instr.cpu.modrm.sib.index = SIB_INDEX(byte);
+
+		if( SIB_BASE(byte) != 5 )
+			out->ea.base = SIB_BASE(byte);
+		else if( mod != 0 )
+			out->ea.base = ebp;
+
+		if( SIB_INDEX(byte) != 4 )
+		{
+			out->ea.index = SIB_INDEX(byte);
+			out->ea.scale = 1 << SIB_SCALE(byte);
+		}
+	}
+
+	if( mod == 1 ) /* disp8 */
+	{
+		DECODE_BYTE(byte);
+		*disp = (int8_t)byte;
+	}
+	else if( mod == 2 || (mod == 0 && rm == 5) ) /* disp32 */
+	{
+		DECODE_DWORD(*disp);
+	}
+
+	out->flags |= EMU_DECODED_MEMORY;
+	*ppos = pos;
+	return 1;
+}
+
+static void decode_init(struct emu_decoded *out)
+{
+	memset(out, 0, sizeof(struct emu_decoded));
+
+	out->ea.base = EMU_DECODED_NOREG;
+	out->ea.index = EMU_DECODED_NOREG;
+
+	int i = 1;
+	if( *((uint8_t *)&i) == 1 )
+	{
+		out->instr.cpu.imm16 = (uint16_t *)((void *)&out->instr.cpu.imm);
+		out->instr.cpu.imm8 = (uint8_t *)&out->instr.cpu.imm;
+	}
+	else
+	{
+		out->instr.cpu.imm16 = (uint16_t *)((void *)&out->instr.cpu.imm + 1);
+		out->instr.cpu.imm8 = (uint8_t *)&out->instr.cpu.imm + 3;
+	}
+}
+
+/**
+ * the decoder as it was before the tables, it works out the format of
+ * every instruction bit by bit from the instruction tables
+ *
+ * kept as the reference emu_cpu_decode_instruction is checked against
+ */
+int32_t emu_cpu_decode_reference(const uint8_t *buf, size_t len, struct emu_decoded *out)
+{
+	const struct emu_cpu_instruction_info *info;
+	struct emu_cpu_instruction *i = &out->instr.cpu;
+	size_t pos = 0;
+	uint8_t byte;
+	uint8_t *opcode;
+
+	decode_init(out);
+
+	while( 1 )
+	{
+		DECODE_BYTE(byte);
+
+		info = &ii_onebyte[byte];
+
+		if( info->function != prefix_fn )
+			break;
+
+		out->instr.prefixes |= prefix_map[byte];
+	}
+
+	out->instr.opc = byte;
+	out->info = info;
+
+	if( info->format.fpu_info != 0 )
+	{
+		/* this is a minimal parser without exact decomposition
+		 * into all fields. instead it determines the length of
+		 * the instruction and ignores pretty much everything else
+		 * except for a few explicitly implemented instructions. */
+		struct emu_fpu_instruction *f = &out->instr.fpu;
+
+		out->instr.is_fpu = 1;
+		f->prefixes = out->instr.prefixes;
+		f->fpu_data[0] = byte;
+
+		DECODE_BYTE(f->fpu_data[1]);
+
+		if( FPU_MOD(f->fpu_data) != 3 ) /* intel pdf page 36 */
+		{
+			if( decode_ea(buf, len, &pos, FPU_MOD(f->fpu_data), FPU_RM(f->fpu_data), out, &f->ea) == 0 )
+				return 0;
+		}
+
+		out->length = pos;
+		return pos;
+	}
+
+	i->opc = byte;
+	i->prefixes = out->instr.prefixes;
+
+	if( i->opc == 0x0f )
+	{
+		DECODE_BYTE(i->opc_2nd);
+		opcode = &i->opc_2nd;
+		info = &ii_twobyte[i->opc_2nd];
+		out->info = info;
+	}
+	else
+	{
+		opcode = &i->opc;
+	}
+
+	if( info->function == 0 )
+		return -1;
+
+	i->w_bit = *opcode & 1;
+	i->s_bit = (*opcode >> 1) & 1;
+
+	/* mod r/m byte?  sib/disp */
+	if( info->format.modrm_byte != 0 )
+	{
+		DECODE_BYTE(byte);
+
+		i->modrm.mod = MODRM_MOD(byte);
+		i->modrm.opc = MODRM_REGOPC(byte);
+		i->modrm.rm = MODRM_RM(byte);
+
+		if( (info->format.modrm_byte == II_MOD_REG_RM || info->format.modrm_byte == II_MOD_YYY_RM ||
+			 info->format.modrm_byte == II_XX_REG1_REG2) && i->modrm.mod != 3 ) /* cases with possible sib/disp*/
+		{
+			uint32_t disp;
+
+			if( decode_ea(buf, len, &pos, i->modrm.mod, i->modrm.rm, out, &disp) == 0 )
+				return 0;
+
+			if( i->modrm.mod == 1 )
+				i->modrm.disp.s8 = disp;
+			else
+				i->modrm.disp.s32 = disp;
+
+			i->modrm.ea = disp;
+
+			if( out->ea.base != EMU_DECODED_NOREG )
+				TRACK_NEED_REG32(out->instr, out->ea.base);
+
+			if( out->ea.index != EMU_DECODED_NOREG )
+				TRACK_NEED_REG32(out->instr, out->ea.index);
+		}
+	}
+
+	if( info->format.imm_data == II_IMM8 || info->format.disp_data == II_DISP8 )
+		i->operand_size = OPSIZE_8;
+	else if( info->format.imm_data == II_IMM16 || info->format.disp_data == II_DISP16 )
+		i->operand_size = OPSIZE_16;
+	else if( info->format.imm_data == II_IMM32 || info->format.disp_data == II_DISP32 )
+		i->operand_size = OPSIZE_32;
+	else if( info->format.imm_data == II_IMM || info->format.disp_data == II_DISPF
+			 || (info->format.type && !i->modrm.opc) )
+	{
+		if( info->format.w_bit == 1 && i->w_bit == 0 )
+			i->operand_size = OPSIZE_8;
+		else if( i->prefixes & PREFIX_OPSIZE )
+			i->operand_size = OPSIZE_16;
+		else
+			i->operand_size = OPSIZE_32;
+	}
+
+	/* imm */
+	if( info->format.imm_data != 0 || (info->format.type && !i->modrm.opc) )
+	{
+		if( i->operand_size == OPSIZE_32 )
+			DECODE_DWORD(i->imm);
+		else if( i->operand_size == OPSIZE_8 )
+			DECODE_BYTE(*i->imm8);
+		else if( i->operand_size == OPSIZE_16 )
+			DECODE_WORD(*i->imm16);
+	}
+
+	/* disp */
+	if( info->format.disp_data != 0 )
+	{
+		uint32_t disp;
+
+		if( i->operand_size == OPSIZE_32 )
+		{
+			DECODE_DWORD(disp);
+			i->disp = (int32_t)disp;
+		}
+		else if( i->operand_size == OPSIZE_16 )
+		{
+			DECODE_WORD(disp);
+			i->disp = (int16_t)disp;
+		}
+		else if( i->operand_size == OPSIZE_8 )
+		{
+			DECODE_BYTE(disp);
+			i->disp = (int8_t)disp;
+		}
+	}
+
+	out->length = pos;
+	return pos;
+}
+
+/*
+ * the table driven decoder
+ *
+ * everything the decoder has to know about a modrm or a sib byte is looked
+ * up in decode_modrm and decode_sib, which are complete at compile time.
+ * everything it has to know about an opcode is looked up in decode_onebyte
+ * and decode_twobyte, which are derived from ii_onebyte and ii_twobyte when
+ * the library is built, see emu_cpu_dtables_gen.c.
+ */
+
+struct decode_modrm
+{
+	uint8_t mod;
+	uint8_t reg;
+	uint8_t rm;
+	uint8_t disp;	/* bytes of displacement: 0, 1 or 4 */
+	uint8_t base;	/* the base register, EMU_DECODED_NOREG if none or a sib byte follows */
+	uint8_t sib;	/* a sib byte follows */
+};
+
+struct decode_sib
+{
+	uint8_t scale;	/* the factor, 0 if there is no index */
+	uint8_t index;
+	uint8_t base[2];	/* indexed by mod != 0, base 5 is ebp only with a displacement */
+};
+
+#define DECODE_R4(f, n)   f(n) f((n) + 1) f((n) + 2) f((n) + 3)
+#define DECODE_R16(f, n)  DECODE_R4(f, n) DECODE_R4(f, (n) + 4) DECODE_R4(f, (n) + 8) DECODE_R4(f, (n) + 12)
+#define DECODE_R64(f, n)  DECODE_R16(f, n) DECODE_R16(f, (n) + 16) DECODE_R16(f, (n) + 32) DECODE_R16(f, (n) + 48)
+#define DECODE_R256(f)    DECODE_R64(f, 0) DECODE_R64(f, 64) DECODE_R64(f, 128) DECODE_R64(f, 192)
+
+#define DECODE_MODRM_ENTRY(b) { \
+	MODRM_MOD(b), MODRM_REGOPC(b), MODRM_RM(b), \
+	MODRM_MOD(b) == 1 ? 1 : (MODRM_MOD(b) == 2 || ((b) & 0xc7) == 0x05) ? 4 : 0, \
+	(MODRM_RM(b) == 4 || ((b) & 0xc7) == 0x05) ? EMU_DECODED_NOREG : MODRM_RM(b), \
+	MODRM_RM(b) == 4 },
+
+#define DECODE_SIB_ENTRY(b) { \
+	SIB_INDEX(b) == 4 ? 0 : 1 << SIB_SCALE(b), \
+	SIB_INDEX(b) == 4 ? EMU_DECODED_NOREG : SIB_INDEX(b), \
+	{ SIB_BASE(b) == 5 ? EMU_DECODED_NOREG : SIB_BASE(b), SIB_BASE(b) } },
+
+static const struct decode_modrm decode_modrm[0x100] = { DECODE_R256(DECODE_MODRM_ENTRY) };
+static const struct decode_sib decode_sib[0x100] = { DECODE_R256(DECODE_SIB_ENTRY) };
+
+#define DOP_INVALID (1 << 0)	/* no function, decodes to -1 */
+#define DOP_PREFIX  (1 << 1)
+#define DOP_FPU     (1 << 2)
+#define DOP_MODRM   (1 << 3)	/* a modrm byte follows */
+#define DOP_EA      (1 << 4)	/* the modrm byte may address memory */
+
+/* operand size, bytes of immediate and bytes of displacement in a layout */
+#define DOP_SIZE(l) ((l) & 3)
+#define DOP_IMM(l)  (((l) >> 2) & 7)
+#define DOP_DISP(l) ((l) >> 5)
+#define DOP_LAYOUT(size, imm, disp) ((size) | (imm) << 2 | (disp) << 5)
+
+struct decode_op
+{
+	uint8_t flags;
+	/* indexed by (opsize prefix ? 1 : 0) | (modrm.opc == 0 ? 2 : 0) */
+	uint8_t layout[4];
+};
+
+/* the static track masks, see emu_cpu_decode_track_reference */
+struct decode_track
+{
+	uint8_t need_reg[8];
+	uint8_t init_reg[8];
+	uint32_t need_eflags;
+	uint32_t init_eflags;
+	uint8_t need_fpu;
+	uint8_t init_fpu;
+};
+
+/* decode_onebyte and decode_twobyte, decode_track_onebyte and
+ * decode_track_twobyte with their rows, see emu_cpu_dtables_gen.c */
+#include "emu_cpu_dtables.h"
+
+/**
+ * decode_ea using the modrm and sib tables
+ *
+ * @return 1 on success, 0 if the buffer ends
+ */
+static inline int32_t decode_ea_table(const uint8_t *buf, size_t len, size_t *ppos, const struct decode_modrm *m, struct emu_decoded *out, uint32_t *disp)
+{
+	size_t pos = *ppos;
+	uint8_t byte;
+
+	*disp = 0;
+	out->ea.base = m->base;
+
+	if( m->sib )
+	{
+		const struct decode_sib *s;
+
+		DECODE_BYTE(byte);
+		s = &decode_sib[byte];
+
+		out->instr.cpu.modrm.sib.base = SIB_BASE(byte);
+		out->instr.cpu.modrm.sib.scale = SIB_SCALE(byte);
+		out->instr.cpu.modrm.sib.index = SIB_INDEX(byte);
+
+		out->ea.base = s->base[m->mod != 0];
+		out->ea.index = s->index;
+		out->ea.scale = s->scale;
+	}
+
+	if( m->disp == 1 )
+	{
+		DECODE_BYTE(byte);
+		*disp = (int8_t)byte;
+	}
+	else if( m->disp == 4 )
+	{
+		DECODE_DWORD(*disp);
+	}
+
+	out->flags |= EMU_DECODED_MEMORY;
+	*ppos = pos;
+	return 1;
+}
+
+int32_t emu_cpu_decode_instruction(const uint8_t *buf, size_t len, struct emu_decoded *out)
+{
+	struct emu_cpu_instruction *i = &out->instr.cpu;
+	const struct decode_op *op;
+	const struct decode_modrm *m;
+	size_t pos = 0;
+	uint8_t byte;
+	uint8_t opcode;
+	uint8_t layout;
+	uint32_t disp;
+
+	decode_init(out);
+
+	while( 1 )
+	{
+		DECODE_BYTE(byte);
+
+		op = &decode_onebyte[byte];
+
+		if( (op->flags & DOP_PREFIX) == 0 )
+			break;
+
+		out->instr.prefixes |= prefix_map[byte];
+	}
+
+	out->instr.opc = byte;
+	out->info = &ii_onebyte[byte];
+
+	if( op->flags & DOP_FPU )
+	{
+		struct emu_fpu_instruction *f = &out->instr.fpu;
+
+		out->instr.is_fpu = 1;
+		f->prefixes = out->instr.prefixes;
+		f->fpu_data[0] = byte;
+
+		DECODE_BYTE(f->fpu_data[1]);
+
+		m = &decode_modrm[f->fpu_data[1]];
+		if( m->mod != 3 )
+		{
+			if( decode_ea_table(buf, len, &pos, m, out, &f->ea) == 0 )
+				return 0;
+		}
+
+		out->length = pos;
+		return pos;
+	}
+
+	i->opc = byte;
+	i->prefixes = out->instr.prefixes;
+	opcode = byte;
+
+	if( opcode == 0x0f )
+	{
+		DECODE_BYTE(i->opc_2nd);
+		opcode = i->opc_2nd;
+		op = &decode_twobyte[opcode];
+		out->info = &ii_twobyte[opcode];
+	}
+
+	if( op->flags & DOP_INVALID )
+		return -1;
+
+	i->w_bit = opcode & 1;
+	i->s_bit = (opcode >> 1) & 1;
+
+	if( op->flags & DOP_MODRM )
+	{
+		DECODE_BYTE(byte);
+
+		m = &decode_modrm[byte];
+		i->modrm.mod = m->mod;
+		i->modrm.opc = m->reg;
+		i->modrm.rm = m->rm;
+
+		if( (op->flags & DOP_EA) && m->mod != 3 )
+		{
+			if( decode_ea_table(buf, len, &pos, m, out, &disp) == 0 )
+				return 0;
+
+			if( m->mod == 1 )
+				i->modrm.disp.s8 = disp;
+			else
+				i->modrm.disp.s32 = disp;
+
+			i->modrm.ea = disp;
+
+			if( out->ea.base != EMU_DECODED_NOREG )
+				TRACK_NEED_REG32(out->instr, out->ea.base);
+
+			if( out->ea.index != EMU_DECODED_NOREG )
+				TRACK_NEED_REG32(out->instr, out->ea.index);
+		}
+	}
+
+	layout = op->layout[((i->prefixes & PREFIX_OPSIZE) ? 1 : 0) | (i->modrm.opc == 0 ? 2 : 0)];
+	i->operand_size = DOP_SIZE(layout);
+
+	switch( DOP_IMM(layout) )
+	{
+	case 1:
+		DECODE_BYTE(*i->imm8);
+		break;
+	case 2:
+		DECODE_WORD(*i->imm16);
+		break;
+	case 4:
+		DECODE_DWORD(i->imm);
+		break;
+	}
+
+	switch( DOP_DISP(layout) )
+	{
+	case 1:
+		DECODE_BYTE(byte);
+		i->disp = (int8_t)byte;
+		break;
+	case 2:
+		DECODE_WORD(disp);
+		i->disp = (int16_t)disp;
+		break;
+	case 4:
+		DECODE_DWORD(disp);
+		i->disp = (int32_t)disp;
+		break;
+	}
+
+	out->length = pos;
+	return pos;
+}
+
+int32_t emu_cpu_decode_length(const uint8_t *buf, size_t len)
+{
+	const struct decode_op *op;
+	const struct decode_modrm *m;
+	size_t pos = 0;
+	uint8_t byte;
+	uint8_t reg = 0;
+	uint8_t layout;
+	bool opsize = false;
+
+	while( 1 )
+	{
+		DECODE_BYTE(byte);
+
+		op = &decode_onebyte[byte];
+
+		if( (op->flags & DOP_PREFIX) == 0 )
+			break;
+
+		if( prefix_map[byte] & PREFIX_OPSIZE )
+			opsize = true;
+	}
+
+	if( op->flags & DOP_FPU )
+	{
+		DECODE_BYTE(byte);
+
+		m = &decode_modrm[byte];
+		if( m->mod != 3 )
+			pos += m->sib + m->disp;
+	}
+	else
+	{
+		if( byte == 0x0f )
+		{
+			DECODE_BYTE(byte);
+			op = &decode_twobyte[byte];
+		}
+
+		if( op->flags & DOP_INVALID )
+			return -1;
+
+		if( op->flags & DOP_MODRM )
+		{
+			DECODE_BYTE(byte);
+
+			m = &decode_modrm[byte];
+			reg = m->reg;
+
+			if( (op->flags & DOP_EA) && m->mod != 3 )
+				pos += m->sib + m->disp;
+		}
+
+		layout = op->layout[(opsize ? 1 : 0) | (reg == 0 ? 2 : 0)];
+		pos += DOP_IMM(layout) + DOP_DISP(layout);
+	}
+
+	if( pos > len )
+		return 0;
+
+	return pos;
+}
+
+/**
+ * the track information of the instruction as far as it does not depend on
+ * the data, looked up by opcode, prefixes and modrm byte
+ */
+void emu_cpu_decode_track(struct emu_decoded *d)
+{
+	struct emu_instruction *in = &d->instr;
+	struct emu_cpu_instruction *i = &in->cpu;
+	const struct decode_track *t;
+	uint8_t context = ((in->prefixes & PREFIX_OPSIZE) ? 1 : 0) | ((in->prefixes & PREFIX_ADSIZE) ? 2 : 0);
+	uint8_t row;
+	uint8_t modrm;
+	uint64_t regs;
+
+	if( in->is_fpu == 1 )
+	{
+		row = decode_track_onebyte[in->opc][context];
+		modrm = in->fpu.fpu_data[1];
+	}
+	else
+	{
+		if( in->opc == 0x0f )
+			row = decode_track_twobyte[i->opc_2nd][context];
+		else
+			row = decode_track_onebyte[in->opc][context];
+
+		modrm = i->modrm.mod << 6 | i->modrm.opc << 3 | i->modrm.rm;
+	}
+
+	t = &decode_tracks[decode_track_rows[row][modrm]];
+
+	memcpy(&regs, t->need_reg, sizeof(regs));
+	in->track.need.regs |= regs;
+	memcpy(&regs, t->init_reg, sizeof(regs));
+	in->track.init.regs |= regs;
+
+	in->track.need.eflags |= t->need_eflags;
+	in->track.init.eflags |= t->init_eflags;
+	in->track.need.fpu |= t->need_fpu;
+	in->track.init.fpu |= t->init_fpu;
+}
+
+/**
+ * the branch targets stored by the instruction functions
+ */
+static void decode_source(struct emu_decoded *d)
+{
+	struct emu_instruction *in = &d->instr;
+	struct emu_cpu_instruction *i = &in->cpu;
+	uint32_t next = d->va + d->length;
+
+	SOURCE_NORM_POS(*in, next);
+
+	if( in->is_fpu == 1 )
+		return;
+
+	if( (i->opc >= 0x70 && i->opc <= 0x7f) || (i->opc >= 0xe0 && i->opc <= 0xe3) ||
+		(i->opc == 0x0f && i->opc_2nd >= 0x80 && i->opc_2nd <= 0x8f) )
+	{
+		/* jcc, loopcc, jecxz */
+		SOURCE_COND_POS(*in, next + i->disp);
+	}
+	else if( i->opc == 0xe8 || i->opc == 0xe9 || i->opc == 0xeb )
+	{
+		/* call, jmp */
+		SOURCE_NORM_POS(*in, next + i->disp);
+	}
+	else if( i->opc == 0xff && (i->modrm.opc == 2 || i->modrm.opc == 4) )
+	{
+		/* call, jmp r/m32 */
+		SOURCE_NORM_POS(*in, 0);
+		d->flags |= EMU_DECODED_INDIRECT;
+	}
+}
+
+int32_t emu_cpu_decode(const uint8_t *buf, size_t len, uint32_t va, struct emu_decoded *out)
+{
+	int32_t ret = emu_cpu_decode_instruction(buf, len, out);
+
+	if( ret <= 0 )
+		return ret;
+
+	out->va = va;
+
+	decode_source(out);
+	emu_cpu_decode_track(out);
+
+	return ret;
+}
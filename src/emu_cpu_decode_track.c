@@ -0,0 +1,441 @@
+/********************************************************************************
+ *                               libemu
+ *
+ *                    - x86 shellcode emulation -
+ *
+ *
+ * Copyright (C) 2007  Paul Baecher & Markus Koetter
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *
+ *             contact nepenthesdev@users.sourceforge.net
+ *
+ *******************************************************************************/
+
+/*
+ * the track masks of an instruction as far as they do not depend on the
+ * data, written out case by case
+ *
+ * emu_cpu_dtables_gen runs this for every opcode, prefix context and modrm
+ * byte and writes the results as the decode_track tables, which is what
+ * emu_cpu_decode_track looks up. libemu keeps it to test the tables against.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "emu/emu.h"
+#include "emu/emu_cpu.h"
+#include "emu/emu_cpu_data.h"
+#include "emu/emu_cpu_decode.h"
+
+#define TRACK_INIT_ALL_FLAGS(instruction) \
+	TRACK_INIT_EFLAG(instruction, f_zf); \
+	TRACK_INIT_EFLAG(instruction, f_pf); \
+	TRACK_INIT_EFLAG(instruction, f_sf); \
+	TRACK_INIT_EFLAG(instruction, f_cf); \
+	TRACK_INIT_EFLAG(instruction, f_of);
+
+/**
+ * the track information of the instruction as far as it does not depend on
+ * the data, the instruction functions only add the data dependent parts
+ */
+void emu_cpu_decode_track_reference(struct emu_decoded *d)
+{
+	struct emu_instruction *in = &d->instr;
+	struct emu_cpu_instruction *i = &in->cpu;
+	bool opsize = (i->prefixes & PREFIX_OPSIZE) != 0;
+	bool reg = i->modrm.mod == 3;
+	uint8_t op;
+
+	if( in->is_fpu == 1 )
+	{
+		if( in->fpu.fpu_data[0] == 0xd9 )
+		{
+			if( (in->fpu.fpu_data[1] & 0x38) == 0x30 )
+			{
+				/* fnstenv */
+				TRACK_NEED_FPU(*in, TRACK_FPU_LAST_INSTRUCTION);
+			}
+			else
+			{
+				TRACK_INIT_FPU(*in, TRACK_FPU_LAST_INSTRUCTION);
+			}
+		}
+		else if( in->fpu.fpu_data[0] == 0xdd && (in->fpu.fpu_data[1] & 0xf8) == 0xc0 )
+		{
+			/* ffree */
+			TRACK_INIT_FPU(*in, TRACK_FPU_LAST_INSTRUCTION);
+		}
+		return;
+	}
+
+	if( i->opc == 0x0f )
+	{
+		switch( i->opc_2nd )
+		{
+		case 0x80: case 0x81: /* jo jno */
+			TRACK_NEED_EFLAG(*in, f_of);
+			break;
+
+		case 0x82: case 0x83: /* jc jnc */
+			TRACK_NEED_EFLAG(*in, f_cf);
+			break;
+
+		case 0x84: case 0x85: /* jz jnz */
+			TRACK_NEED_EFLAG(*in, f_zf);
+			break;
+
+		case 0x94: case 0x95: /* setz setnz */
+			TRACK_NEED_EFLAG(*in, f_zf);
+			if( reg )
+			{
+				TRACK_INIT_REG8(*in, i->modrm.rm);
+			}
+			break;
+
+		case 0x86: case 0x87: /* jbe ja */
+			TRACK_NEED_EFLAG(*in, f_cf);
+			TRACK_NEED_EFLAG(*in, f_zf);
+			break;
+
+		case 0x88: case 0x89: /* js jns */
+			TRACK_NEED_EFLAG(*in, f_sf);
+			break;
+
+		case 0x8a: case 0x8b: /* jp jnp */
+			TRACK_NEED_EFLAG(*in, f_pf);
+			break;
+
+		case 0x8c: case 0x8d: /* jl jge */
+			TRACK_NEED_EFLAG(*in, f_sf);
+			TRACK_NEED_EFLAG(*in, f_of);
+			break;
+
+		case 0x8e: case 0x8f: /* jle jg */
+			TRACK_NEED_EFLAG(*in, f_zf);
+			TRACK_NEED_EFLAG(*in, f_sf);
+			TRACK_NEED_EFLAG(*in, f_of);
+			break;
+		}
+		return;
+	}
+
+	/* add or adc sbb and sub xor, cmp does not set the track information */
+	if( (i->opc < 0x40 && (i->opc & 7) < 6 && (i->opc >> 3) != 7) ||
+		(i->opc >= 0x80 && i->opc <= 0x83 && i->modrm.opc != 7) )
+	{
+		TRACK_INIT_ALL_FLAGS(*in);
+	}
+
+	switch( i->opc )
+	{
+	case 0x29: /* sub r/m32, r32 */
+		if( reg && !opsize )
+		{
+			if( i->modrm.opc == i->modrm.rm )
+			{
+				TRACK_INIT_REG32(*in, i->modrm.opc);
+			}
+			else
+			{
+				TRACK_NEED_REG32(*in, i->modrm.rm);
+				TRACK_NEED_REG32(*in, i->modrm.opc);
+			}
+		}
+		break;
+
+	case 0x2b: /* sub r32, r/m32 */
+		if( reg && !opsize && i->modrm.opc == i->modrm.rm )
+		{
+			TRACK_INIT_REG32(*in, i->modrm.opc);
+		}
+		break;
+
+	case 0x30: /* xor r/m8, r8 */
+		if( reg )
+		{
+			TRACK_NEED_REG8(*in, i->modrm.rm);
+			TRACK_INIT_REG8(*in, i->modrm.rm);
+		}
+		break;
+
+	case 0x31: /* xor r/m32, r32 */
+		if( !reg )
+		{
+			if( opsize )
+			{
+				TRACK_NEED_REG16(*in, i->modrm.opc);
+			}
+			else
+			{
+				TRACK_NEED_REG32(*in, i->modrm.opc);
+			}
+		}
+		else if( opsize )
+		{
+			TRACK_NEED_REG16(*in, i->modrm.rm);
+			TRACK_NEED_REG16(*in, i->modrm.opc);
+			TRACK_INIT_REG16(*in, i->modrm.rm);
+		}
+		else if( i->modrm.opc == i->modrm.rm )
+		{
+			TRACK_INIT_REG32(*in, i->modrm.opc);
+		}
+		break;
+
+	case 0x32: /* xor r8, r/m8 */
+		TRACK_NEED_REG8(*in, i->modrm.opc);
+		if( reg )
+		{
+			TRACK_NEED_REG8(*in, i->modrm.rm);
+		}
+		TRACK_INIT_REG8(*in, i->modrm.opc);
+		break;
+
+	case 0x33: /* xor r32, r/m32, xor r32, [m32] depends on the result */
+		if( !reg )
+		{
+			if( opsize )
+			{
+				TRACK_NEED_REG16(*in, i->modrm.opc);
+				TRACK_INIT_REG16(*in, i->modrm.opc);
+			}
+		}
+		else if( i->modrm.opc == i->modrm.rm )
+		{
+			if( opsize )
+			{
+				TRACK_INIT_REG16(*in, i->modrm.opc);
+			}
+			else
+			{
+				TRACK_INIT_REG32(*in, i->modrm.opc);
+			}
+		}
+		break;
+
+	case 0x34: /* xor al, imm8 */
+		TRACK_NEED_REG8(*in, al);
+		TRACK_INIT_REG8(*in, al);
+		break;
+
+	case 0x35: /* xor eax, imm32 */
+		if( opsize )
+		{
+			TRACK_NEED_REG16(*in, ax);
+			TRACK_INIT_REG16(*in, ax);
+		}
+		else
+		{
+			TRACK_NEED_REG32(*in, eax);
+			TRACK_INIT_REG32(*in, eax);
+		}
+		break;
+
+	case 0x58: case 0x59: case 0x5a: case 0x5b: /* pop r32 */
+	case 0x5c: case 0x5d: case 0x5e: case 0x5f:
+		if( opsize )
+		{
+			TRACK_INIT_REG16(*in, i->opc & 7);
+		}
+		else
+		{
+			TRACK_INIT_REG32(*in, i->opc & 7);
+		}
+		break;
+
+	case 0x70: case 0x71: /* jo jno */
+		TRACK_NEED_EFLAG(*in, f_of);
+		break;
+
+	case 0x72: case 0x73: /* jc jnc */
+		TRACK_NEED_EFLAG(*in, f_cf);
+		break;
+
+	case 0x74: case 0x75: /* jz jnz */
+		TRACK_NEED_EFLAG(*in, f_zf);
+		break;
+
+	case 0x76: case 0x77: /* jbe ja */
+		TRACK_NEED_EFLAG(*in, f_cf);
+		TRACK_NEED_EFLAG(*in, f_zf);
+		break;
+
+	case 0x78: case 0x79: /* js jns */
+		TRACK_NEED_EFLAG(*in, f_sf);
+		break;
+
+	case 0x7a: case 0x7b: /* jp jnp */
+		TRACK_NEED_EFLAG(*in, f_pf);
+		break;
+
+	case 0x7c: case 0x7d: /* jl jge */
+		TRACK_NEED_EFLAG(*in, f_sf);
+		TRACK_NEED_EFLAG(*in, f_of);
+		break;
+
+	case 0x7e: case 0x7f: /* jle jg */
+		TRACK_NEED_EFLAG(*in, f_zf);
+		TRACK_NEED_EFLAG(*in, f_sf);
+		TRACK_NEED_EFLAG(*in, f_of);
+		break;
+
+	case 0x80: /* group 1 xor r/m8, imm8 */
+	case 0x82:
+		if( i->modrm.opc == 6 && reg )
+		{
+			TRACK_INIT_REG8(*in, i->modrm.rm);
+			TRACK_NEED_REG8(*in, i->modrm.rm);
+		}
+		break;
+
+	case 0x81: /* group 1 xor r/m32, imm */
+	case 0x83:
+		if( i->modrm.opc == 6 && reg )
+		{
+			if( opsize )
+			{
+				TRACK_NEED_REG16(*in, i->modrm.rm);
+				TRACK_INIT_REG16(*in, i->modrm.rm);
+			}
+			else
+			{
+				TRACK_NEED_REG32(*in, i->modrm.rm);
+				TRACK_INIT_REG32(*in, i->modrm.rm);
+			}
+		}
+		break;
+
+	case 0x89: /* mov r/m32, r32 */
+		if( reg && !opsize )
+		{
+			TRACK_NEED_REG32(*in, i->modrm.opc);
+			TRACK_INIT_REG32(*in, i->modrm.rm);
+		}
+		break;
+
+	case 0x8a: /* mov r8, [m8] */
+		if( !reg )
+		{
+			TRACK_INIT_REG16(*in, i->modrm.opc);
+		}
+		break;
+
+	case 0x8b: /* mov r32, r/m32 */
+		if( opsize )
+		{
+			if( !reg )
+			{
+				TRACK_INIT_REG16(*in, i->modrm.opc);
+			}
+		}
+		else
+		{
+			TRACK_INIT_REG32(*in, i->modrm.opc);
+		}
+		break;
+
+	case 0x8d: /* lea */
+		if( !opsize )
+		{
+			TRACK_INIT_REG32(*in, i->modrm.opc);
+		}
+		break;
+
+	case 0xa1: /* mov eax, moffs32 */
+		if( !opsize )
+		{
+			TRACK_INIT_REG32(*in, eax);
+		}
+		break;
+
+	case 0xac: /* lodsb */
+		if( !(i->prefixes & PREFIX_ADSIZE) )
+		{
+			TRACK_INIT_REG8(*in, al);
+		}
+		break;
+
+	case 0xad: /* lodsd */
+		if( !opsize && !(i->prefixes & PREFIX_ADSIZE) )
+		{
+			TRACK_INIT_REG32(*in, eax);
+		}
+		break;
+
+	case 0xb8: case 0xb9: case 0xba: case 0xbb: /* mov r32, imm32 */
+	case 0xbc: case 0xbd: case 0xbe: case 0xbf:
+		if( !opsize )
+		{
+			TRACK_INIT_REG32(*in, i->opc & 7);
+		}
+		break;
+
+	case 0xc9: /* leave, mov esp, ebp; pop ebp */
+		if( opsize )
+		{
+			TRACK_INIT_REG16(*in, ebp);
+		}
+		else
+		{
+			TRACK_NEED_REG32(*in, ebp);
+			TRACK_INIT_REG32(*in, esp);
+			TRACK_INIT_REG32(*in, ebp);
+		}
+		break;
+
+	case 0xe0: /* loopnz */
+	case 0xe1: /* loopz */
+		op = opsize ? cx : ecx;
+		if( opsize )
+		{
+			TRACK_NEED_REG16(*in, op);
+		}
+		else
+		{
+			TRACK_NEED_REG32(*in, op);
+		}
+		TRACK_NEED_EFLAG(*in, f_zf);
+		break;
+
+	case 0xe2: /* loop */
+	case 0xe3: /* jecxz */
+		if( opsize )
+		{
+			TRACK_NEED_REG16(*in, cx);
+		}
+		else
+		{
+			TRACK_NEED_REG32(*in, ecx);
+		}
+		break;
+
+	case 0xff: /* group 5 call/jmp r32 */
+		if( (i->modrm.opc == 2 || i->modrm.opc == 4) && reg )
+		{
+			if( opsize )
+			{
+				TRACK_NEED_REG16(*in, i->modrm.rm);
+			}
+			else
+			{
+				TRACK_NEED_REG32(*in, i->modrm.rm);
+			}
+		}
+		break;
+	}
+}
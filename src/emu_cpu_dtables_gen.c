@@ -0,0 +1,328 @@
+/********************************************************************************
+ *                               libemu
+ *
+ *                    - x86 shellcode emulation -
+ *
+ *
+ * Copyright (C) 2007  Paul Baecher & Markus Koetter
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ * 
+ * 
+ *             contact nepenthesdev@users.sourceforge.net  
+ *
+ *******************************************************************************/
+
+
+/*
+ * writes the opcode tables of the table driven decoder in emu_cpu_decode.c
+ *
+ * C has no way to derive them from ii_onebyte and ii_twobyte at compile
+ * time, so this is run at build time and its output, emu_cpu_dtables.h,
+ * is included by emu_cpu_decode.c.
+ * The instruction functions are not linked in, emu_cpu_dtables_stubs.c
+ * only gives each of them an address.
+ *
+ * The track masks emu_cpu_decode_track attaches are written out the same
+ * way, by running emu_cpu_decode_track_reference for every opcode, prefix
+ * context and modrm byte.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "emu/emu.h"
+#include "emu/emu_cpu.h"
+#include "emu/emu_cpu_data.h"
+#include "emu/emu_cpu_decode.h"
+
+#include "emu/emu_cpu_itables.h"
+
+/**
+ * work out operand size, immediate and displacement the way
+ * emu_cpu_decode_reference does, for one opcode in one context
+ */
+static void dtables_layout(const struct emu_cpu_instruction_info *info, uint8_t opcode, int opsize, int typehit)
+{
+	uint8_t size = 0;
+	uint8_t bytes;
+
+	typehit = typehit && info->format.type;
+
+	if( info->format.imm_data == II_IMM8 || info->format.disp_data == II_DISP8 )
+		size = OPSIZE_8;
+	else if( info->format.imm_data == II_IMM16 || info->format.disp_data == II_DISP16 )
+		size = OPSIZE_16;
+	else if( info->format.imm_data == II_IMM32 || info->format.disp_data == II_DISP32 )
+		size = OPSIZE_32;
+	else if( info->format.imm_data == II_IMM || info->format.disp_data == II_DISPF || typehit )
+	{
+		if( info->format.w_bit == 1 && (opcode & 1) == 0 )
+			size = OPSIZE_8;
+		else if( opsize )
+			size = OPSIZE_16;
+		else
+			size = OPSIZE_32;
+	}
+
+	bytes = size == OPSIZE_8 ? 1 : size == OPSIZE_16 ? 2 : size == OPSIZE_32 ? 4 : 0;
+
+	printf("DOP_LAYOUT(%i, %i, %i)", size,
+		(info->format.imm_data != 0 || typehit) ? bytes : 0,
+		info->format.disp_data != 0 ? bytes : 0);
+}
+
+static void dtables_op(const struct emu_cpu_instruction_info *info, uint8_t opcode)
+{
+	const char *flags[5];
+	int n = 0;
+	int l;
+
+	if( info->function == 0 )
+		flags[n++] = "DOP_INVALID";
+
+	if( info->function == prefix_fn )
+		flags[n++] = "DOP_PREFIX";
+
+	if( info->format.fpu_info != 0 )
+		flags[n++] = "DOP_FPU";
+
+	if( info->format.modrm_byte != 0 )
+		flags[n++] = "DOP_MODRM";
+
+	if( info->format.modrm_byte == II_MOD_REG_RM || info->format.modrm_byte == II_MOD_YYY_RM ||
+		info->format.modrm_byte == II_XX_REG1_REG2 )
+		flags[n++] = "DOP_EA";
+
+	printf("\t/* %02x */ {", opcode);
+
+	if( n == 0 )
+		printf("0");
+
+	for( l = 0; l < n; l++ )
+		printf("%s%s", l == 0 ? "" : " | ", flags[l]);
+
+	/* indexed by (opsize prefix ? 1 : 0) | (modrm.opc == 0 ? 2 : 0) */
+	printf(", {");
+	for( l = 0; l < 4; l++ )
+	{
+		if( l != 0 )
+			printf(", ");
+		dtables_layout(info, opcode, l & 1, l & 2);
+	}
+	printf("}},\n");
+}
+
+static void dtables_table(const char *name, const char *from, const struct emu_cpu_instruction_info *table)
+{
+	int opcode;
+
+	printf("/* from %s */\n", from);
+	printf("static const struct decode_op %s[0x100] = {\n", name);
+
+	for( opcode = 0; opcode < 0x100; opcode++ )
+		dtables_op(&table[opcode], opcode);
+
+	printf("};\n\n");
+}
+
+/* the contexts of the track tables, (opsize prefix ? 1 : 0) | (adsize prefix ? 2 : 0) */
+#define TRACK_CONTEXTS 4
+
+/* the distinct masks, and the distinct rows of masks indexed by the modrm byte */
+#define TRACK_MAX 0x1000
+#define TRACK_ROWS_MAX (2 * 0x100 * TRACK_CONTEXTS)
+
+struct dtables_track
+{
+	uint8_t need_reg[8];
+	uint8_t init_reg[8];
+	uint32_t need_eflags;
+	uint32_t init_eflags;
+	uint8_t need_fpu;
+	uint8_t init_fpu;
+};
+
+static struct dtables_track tracks[TRACK_MAX];
+static int track_count;
+
+static uint16_t track_rows[TRACK_ROWS_MAX][0x100];
+static int track_row_count;
+
+/* the row of each opcode in each context, onebyte and twobyte */
+static int track_opcodes[2][0x100][TRACK_CONTEXTS];
+
+static int dtables_track_index(const struct emu_instruction *in)
+{
+	struct dtables_track t;
+	int n;
+
+	memset(&t, 0, sizeof(t));
+	memcpy(t.need_reg, in->track.need.reg, sizeof(t.need_reg));
+	memcpy(t.init_reg, in->track.init.reg, sizeof(t.init_reg));
+	t.need_eflags = in->track.need.eflags;
+	t.init_eflags = in->track.init.eflags;
+	t.need_fpu = in->track.need.fpu;
+	t.init_fpu = in->track.init.fpu;
+
+	for( n = 0; n < track_count; n++ )
+		if( memcmp(&tracks[n], &t, sizeof(t)) == 0 )
+			return n;
+
+	if( track_count == TRACK_MAX )
+		return -1;
+
+	tracks[track_count] = t;
+	return track_count++;
+}
+
+/**
+ * run the reference for each modrm byte of an opcode in one context
+ *
+ * @return the index of the row, -1 if a table is full
+ */
+static int dtables_track_row(const struct emu_cpu_instruction_info *table, int twobyte, uint8_t opcode, int context)
+{
+	uint16_t row[0x100];
+	uint16_t prefixes = ((context & 1) ? PREFIX_OPSIZE : 0) | ((context & 2) ? PREFIX_ADSIZE : 0);
+	int modrm;
+	int n;
+
+	for( modrm = 0; modrm < 0x100; modrm++ )
+	{
+		struct emu_decoded d;
+		struct emu_instruction *in = &d.instr;
+
+		/* the fields the decoder sets */
+		memset(&d, 0, sizeof(d));
+		in->prefixes = prefixes;
+		in->opc = twobyte ? 0x0f : opcode;
+
+		if( twobyte == 0 && table[opcode].format.fpu_info != 0 )
+		{
+			in->is_fpu = 1;
+			in->fpu.prefixes = prefixes;
+			in->fpu.fpu_data[0] = opcode;
+			in->fpu.fpu_data[1] = modrm;
+		}
+		else
+		{
+			in->cpu.prefixes = prefixes;
+			in->cpu.opc = in->opc;
+			in->cpu.opc_2nd = twobyte ? opcode : 0;
+
+			if( table[opcode].format.modrm_byte != 0 )
+			{
+				in->cpu.modrm.mod = MODRM_MOD(modrm);
+				in->cpu.modrm.opc = MODRM_REGOPC(modrm);
+				in->cpu.modrm.rm = MODRM_RM(modrm);
+			}
+		}
+
+		emu_cpu_decode_track_reference(&d);
+
+		if( (n = dtables_track_index(in)) < 0 )
+			return -1;
+		row[modrm] = n;
+	}
+
+	for( n = 0; n < track_row_count; n++ )
+		if( memcmp(track_rows[n], row, sizeof(row)) == 0 )
+			return n;
+
+	memcpy(track_rows[track_row_count], row, sizeof(row));
+	return track_row_count++;
+}
+
+static int dtables_track(void)
+{
+	const struct emu_cpu_instruction_info *tables[2] = { ii_onebyte, ii_twobyte };
+	int twobyte, opcode, context, n;
+
+	for( twobyte = 0; twobyte < 2; twobyte++ )
+	for( opcode = 0; opcode < 0x100; opcode++ )
+	for( context = 0; context < TRACK_CONTEXTS; context++ )
+	{
+		if( (track_opcodes[twobyte][opcode][context] = dtables_track_row(tables[twobyte], twobyte, opcode, context)) < 0 )
+		{
+			fprintf(stderr, "emu_cpu_dtables_gen: more than %i track masks\n", TRACK_MAX);
+			return -1;
+		}
+	}
+
+	if( track_row_count > 0x100 )
+	{
+		fprintf(stderr, "emu_cpu_dtables_gen: %i track rows do not fit a byte\n", track_row_count);
+		return -1;
+	}
+
+	printf("/* from emu_cpu_decode_track_reference */\n");
+	printf("static const struct decode_track decode_tracks[%i] = {\n", track_count);
+	for( n = 0; n < track_count; n++ )
+	{
+		struct dtables_track *t = &tracks[n];
+
+		printf("\t/* %3i */ {{%i, %i, %i, %i, %i, %i, %i, %i}, {%i, %i, %i, %i, %i, %i, %i, %i}, 0x%x, 0x%x, %i, %i},\n", n,
+			t->need_reg[0], t->need_reg[1], t->need_reg[2], t->need_reg[3],
+			t->need_reg[4], t->need_reg[5], t->need_reg[6], t->need_reg[7],
+			t->init_reg[0], t->init_reg[1], t->init_reg[2], t->init_reg[3],
+			t->init_reg[4], t->init_reg[5], t->init_reg[6], t->init_reg[7],
+			t->need_eflags, t->init_eflags, t->need_fpu, t->init_fpu);
+	}
+	printf("};\n\n");
+
+	printf("/* the index into decode_tracks by modrm byte */\n");
+	printf("static const uint16_t decode_track_rows[%i][0x100] = {\n", track_row_count);
+	for( n = 0; n < track_row_count; n++ )
+	{
+		int modrm;
+
+		printf("\t/* %i */ {", n);
+		for( modrm = 0; modrm < 0x100; modrm++ )
+			printf("%s%s%i", modrm == 0 ? "" : ",", (modrm & 0x1f) == 0 ? "\n\t\t" : " ", track_rows[n][modrm]);
+		printf("},\n");
+	}
+	printf("};\n\n");
+
+	for( twobyte = 0; twobyte < 2; twobyte++ )
+	{
+		/* indexed by (opsize prefix ? 1 : 0) | (adsize prefix ? 2 : 0) */
+		printf("static const uint8_t %s[0x100][%i] = {\n", twobyte ? "decode_track_twobyte" : "decode_track_onebyte", TRACK_CONTEXTS);
+		for( opcode = 0; opcode < 0x100; opcode++ )
+		{
+			printf("\t/* %02x */ {", opcode);
+			for( context = 0; context < TRACK_CONTEXTS; context++ )
+				printf("%s%i", context == 0 ? "" : ", ", track_opcodes[twobyte][opcode][context]);
+			printf("},\n");
+		}
+		printf("};\n\n");
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	printf("/* generated by emu_cpu_dtables_gen, do not edit */\n\n");
+
+	dtables_table("decode_onebyte", "ii_onebyte", ii_onebyte);
+	dtables_table("decode_twobyte", "ii_twobyte", ii_twobyte);
+
+	if( dtables_track() != 0 )
+		return 1;
+
+	return 0;
+}
@@ -0,0 +1,131 @@
+/********************************************************************************
+ *                               libemu
+ *
+ *                    - x86 shellcode emulation -
+ *
+ *
+ * Copyright (C) 2007  Paul Baecher & Markus Koetter
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *
+ *             contact nepenthesdev@users.sourceforge.net
+ *
+ *******************************************************************************/
+
+/*
+ * livelock detection
+ *
+ * Junk data and broken payloads tend to end up in a loop which makes no
+ * progress at all, like jmp $ or jecxz $ with ecx being zero, and burn the
+ * whole step budget there.
+ * Whenever a backward branch is taken, the state of the cpu (eip, the
+ * registers and the flags) and the write counter of the memory are compared
+ * to the states seen at the last backward branches. If nothing was written
+ * and the state is exactly the same, the code will keep going round in the
+ * same circle, so the run is stopped.
+ * Setting eip from the outside, like the hooks do, starts over.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "emu/emu.h"
+#include "emu/emu_cpu.h"
+#include "emu/emu_cpu_data.h"
+#include "emu/emu_memory.h"
+
+/* backward branches remembered */
+#define LIVELOCK_WINDOW 16
+
+struct livelock_state
+{
+	uint32_t hash;
+	uint32_t eip;
+	uint32_t eflags;
+	uint32_t writes;
+	uint32_t reg[8];
+};
+
+struct emu_cpu_livelock
+{
+	struct livelock_state states[LIVELOCK_WINDOW];
+	uint32_t next;
+	uint32_t count;
+};
+
+static uint32_t livelock_hash(struct livelock_state *s)
+{
+	uint32_t h = 2166136261U;
+	int i;
+
+	h = (h ^ s->eip) * 16777619U;
+	h = (h ^ s->eflags) * 16777619U;
+	h = (h ^ s->writes) * 16777619U;
+	for( i = 0; i < 8; i++ )
+		h = (h ^ s->reg[i]) * 16777619U;
+
+	return h;
+}
+
+int32_t emu_cpu_livelock_check(struct emu_cpu *c)
+{
+	struct emu_cpu_livelock *l = c->livelock;
+	struct livelock_state s;
+	uint32_t i;
+
+	if( l == NULL )
+	{
+		if( (l = (struct emu_cpu_livelock *)malloc(sizeof(struct emu_cpu_livelock))) == NULL )
+			return 0;
+
+		memset(l, 0, sizeof(struct emu_cpu_livelock));
+		c->livelock = l;
+	}
+
+	s.eip = c->eip;
+	s.eflags = c->eflags;
+	s.writes = emu_memory_get_writes(c->mem);
+	memcpy(s.reg, c->reg, sizeof(s.reg));
+	s.hash = livelock_hash(&s);
+
+	for( i = 0; i < l->count; i++ )
+	{
+		if( l->states[i].hash == s.hash && memcmp(&l->states[i], &s, sizeof(s)) == 0 )
+		{
+			emu_error_set(c->emu, ELOOP, "livelock at 0x%08x\n", c->eip);
+			return -1;
+		}
+	}
+
+	l->states[l->next] = s;
+	l->next = (l->next + 1) % LIVELOCK_WINDOW;
+	if( l->count < LIVELOCK_WINDOW )
+		l->count++;
+
+	return 0;
+}
+
+void emu_cpu_livelock_clear(struct emu_cpu *c)
+{
+	if( c->livelock == NULL )
+		return;
+
+	c->livelock->next = 0;
+	c->livelock->count = 0;
+}
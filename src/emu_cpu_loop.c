@@ -0,0 +1,419 @@
+/********************************************************************************
+ *                               libemu
+ *
+ *                    - x86 shellcode emulation -
+ *
+ *
+ * Copyright (C) 2007  Paul Baecher & Markus Koetter
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *
+ *             contact nepenthesdev@users.sourceforge.net
+ *
+ *******************************************************************************/
+
+/*
+ * fast forwarding of decoder loops
+ *
+ * most encoded shellcodes start with a tiny loop, like
+ *
+ *   xor byte [esi+0x12], 0x99     |   xor dword [ebx+0x13], 0x1a2b3c4d
+ *   inc esi                       |   sub ebx, -4
+ *   loop -7                       |   dec ecx / jnz -9
+ *
+ * which would cost a full parse and step for every instruction of every
+ * iteration. Once such a loop closed (the backward branch was taken), the
+ * body is matched against this pattern, and all but the last remaining
+ * iteration are applied to the memory in one go.
+ * The last iteration is left to the interpreter, so the flags are exactly what
+ * stepping the loop would have produced.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "emu/emu.h"
+#include "emu/emu_cpu.h"
+#include "emu/emu_cpu_data.h"
+#include "emu/emu_memory.h"
+#include "emu/emu_log.h"
+
+/* longest loop body we try to match, the branch instruction excluded */
+#define LOOP_BODY_MAX 24
+
+/* bytes transformed per memory access */
+#define LOOP_CHUNK_SIZE 4096
+
+/* dont bother for less */
+#define LOOP_ITERATIONS_MIN 4
+
+enum loop_op
+{
+	loop_op_add = 0, loop_op_sub = 5, loop_op_xor = 6
+};
+
+struct loop_pattern
+{
+	enum loop_op op;
+	uint8_t width;           /* 1 or 4 */
+	uint8_t ptr;             /* register holding the pointer */
+	int8_t disp;
+	bool key_is_reg;
+	uint8_t key_reg;         /* reg8 or reg32 index, depending on width */
+	uint32_t key;
+	int32_t stride;          /* pointer advance per iteration */
+	int32_t pre;             /* pointer advance before the transform */
+	uint8_t counter;         /* register counting the iterations */
+};
+
+/**
+ * match the transforming instruction
+ *
+ * @return length of the instruction, 0 if it does not match
+ */
+static uint32_t loop_match_transform(uint8_t *b, uint32_t len, struct loop_pattern *p)
+{
+	uint32_t pos;
+	uint8_t opc = b[0];
+
+	if( len < 2 )
+		return 0;
+
+	switch( opc )
+	{
+	case 0x80:
+	case 0x81:
+	case 0x83:
+		p->key_is_reg = false;
+		p->op = MODRM_REGOPC(b[1]);
+		p->width = (opc == 0x80) ? 1 : 4;
+		break;
+
+	case 0x00: case 0x01:
+	case 0x28: case 0x29:
+	case 0x30: case 0x31:
+		p->key_is_reg = true;
+		p->op = (opc >> 3) & 7;
+		p->width = (opc & 1) ? 4 : 1;
+		p->key_reg = MODRM_REGOPC(b[1]);
+		break;
+
+	default:
+		return 0;
+	}
+
+	if( p->op != loop_op_add && p->op != loop_op_sub && p->op != loop_op_xor )
+		return 0;
+
+	/* [reg] or [reg+disp8], no sib */
+	p->ptr = MODRM_RM(b[1]);
+	if( p->ptr == 4 )
+		return 0;
+
+	if( MODRM_MOD(b[1]) == 0 && p->ptr != 5 )
+	{
+		p->disp = 0;
+		pos = 2;
+	}
+	else if( MODRM_MOD(b[1]) == 1 && len >= 3 )
+	{
+		p->disp = (int8_t)b[2];
+		pos = 3;
+	}
+	else
+		return 0;
+
+	if( p->key_is_reg == false )
+	{
+		if( opc == 0x81 )
+		{
+			if( len < pos + 4 )
+				return 0;
+			p->key = b[pos] | b[pos+1] << 8 | b[pos+2] << 16 | (uint32_t)b[pos+3] << 24;
+			pos += 4;
+		}
+		else
+		{
+			if( len < pos + 1 )
+				return 0;
+			if( opc == 0x83 )
+				p->key = (uint32_t)(int32_t)(int8_t)b[pos];
+			else
+				p->key = b[pos];
+			pos += 1;
+		}
+	}
+
+	return pos;
+}
+
+/**
+ * match a single pointer increment
+ *
+ * @return length of the instruction, 0 if it does not match
+ */
+static uint32_t loop_match_advance(uint8_t *b, uint32_t len, uint8_t ptr, int32_t *stride)
+{
+	if( len >= 1 && b[0] == 0x40 + ptr )
+	{
+		*stride += 1;
+		return 1;
+	}
+
+	if( len >= 1 && b[0] == 0x48 + ptr )
+	{
+		*stride -= 1;
+		return 1;
+	}
+
+	if( len >= 3 && b[0] == 0x83 && b[1] == 0xc0 + ptr )
+	{
+		*stride += (int8_t)b[2];
+		return 3;
+	}
+
+	if( len >= 3 && b[0] == 0x83 && b[1] == 0xe8 + ptr )
+	{
+		*stride -= (int8_t)b[2];
+		return 3;
+	}
+
+	return 0;
+}
+
+/**
+ * match the loop body against the decoder pattern
+ *
+ * @param b       the body, starting at the branch target
+ * @param len     length of the body, the branch instruction excluded
+ * @param branch  the branch opcode, 0xe2 (loop) or 0x75 (jnz)
+ * @param p       the pattern to fill
+ *
+ * @return true if the body matches
+ */
+static bool loop_match(uint8_t *b, uint32_t len, uint8_t branch, struct loop_pattern *p)
+{
+	uint32_t pos = 0;
+	uint32_t r;
+
+	memset(p, 0, sizeof(struct loop_pattern));
+
+	if( branch == 0x75 )
+	{
+		/* dec counter; jnz */
+		if( len < 2 || b[len-1] < 0x48 || b[len-1] > 0x4f )
+			return false;
+
+		p->counter = b[len-1] - 0x48;
+		len--;
+	}
+	else
+		p->counter = ecx;
+
+	if( (r = loop_match_transform(b, len, p)) != 0 )
+	{
+		/* transform, advance */
+		pos = r;
+		while( pos < len && (r = loop_match_advance(b + pos, len - pos, p->ptr, &p->stride)) != 0 )
+			pos += r;
+	}
+	else
+	{
+		/* advance, transform */
+		uint8_t ptr;
+		for( ptr = 0; ptr < 8; ptr++ )
+			if( (r = loop_match_advance(b, len, ptr, &p->stride)) != 0 )
+				break;
+
+		if( ptr == 8 )
+			return false;
+
+		pos = r;
+		while( pos < len && (r = loop_match_advance(b + pos, len - pos, ptr, &p->stride)) != 0 )
+			pos += r;
+
+		if( (r = loop_match_transform(b + pos, len - pos, p)) == 0 || p->ptr != ptr )
+			return false;
+
+		p->pre = p->stride;
+		pos += r;
+	}
+
+	if( pos != len )
+		return false;
+
+	/* every iteration has to touch its own cell */
+	if( p->stride != p->width && p->stride != -p->width )
+		return false;
+
+	/* the counter, the pointer and the key have to be independent */
+	if( p->counter == p->ptr || p->counter == esp )
+		return false;
+
+	if( p->key_is_reg == true )
+	{
+		uint8_t key32 = (p->width == 1) ? (p->key_reg & 3) : p->key_reg;
+		if( key32 == p->ptr || key32 == p->counter )
+			return false;
+	}
+
+	return true;
+}
+
+static void loop_transform(struct loop_pattern *p, uint8_t *data, uint32_t len, uint32_t key)
+{
+	uint32_t i;
+
+	if( p->width == 1 )
+	{
+		uint8_t k = key;
+
+		switch( p->op )
+		{
+		case loop_op_xor:
+			for( i = 0; i < len; i++ )
+				data[i] ^= k;
+			break;
+
+		case loop_op_add:
+			for( i = 0; i < len; i++ )
+				data[i] += k;
+			break;
+
+		case loop_op_sub:
+			for( i = 0; i < len; i++ )
+				data[i] -= k;
+			break;
+		}
+	}
+	else
+	{
+		for( i = 0; i + 4 <= len; i += 4 )
+		{
+			/* guest memory is little endian */
+			uint32_t v = data[i] | data[i+1] << 8 | data[i+2] << 16 | (uint32_t)data[i+3] << 24;
+
+			switch( p->op )
+			{
+			case loop_op_xor:
+				v ^= key;
+				break;
+
+			case loop_op_add:
+				v += key;
+				break;
+
+			case loop_op_sub:
+				v -= key;
+				break;
+			}
+
+			data[i] = v;
+			data[i+1] = v >> 8;
+			data[i+2] = v >> 16;
+			data[i+3] = v >> 24;
+		}
+	}
+}
+
+int32_t emu_cpu_loop_fastforward(struct emu_cpu *c, uint32_t branch_eip)
+{
+	struct loop_pattern p;
+	uint8_t body[LOOP_BODY_MAX + 2];
+	uint8_t data[LOOP_CHUNK_SIZE];
+	uint32_t body_start = c->eip;
+	uint32_t body_len;
+	uint32_t key;
+	uint32_t remaining;
+	uint32_t iterations;
+	uint32_t done = 0;
+
+	if( branch_eip <= body_start || branch_eip - body_start > LOOP_BODY_MAX )
+		return 0;
+
+	body_len = branch_eip - body_start;
+
+	if( emu_memory_read_block(c->mem, body_start, body, body_len + 2) != 0 )
+		return 0;
+
+	if( loop_match(body, body_len, body[body_len], &p) == false )
+		return 0;
+
+	/* the counter is non zero, as the branch was taken, leave the last
+	 * iteration to the interpreter */
+	remaining = c->reg[p.counter];
+	if( remaining <= LOOP_ITERATIONS_MIN )
+		return 0;
+
+	iterations = remaining - 1;
+
+	if( p.key_is_reg == true )
+	{
+		if( p.width == 1 )
+			key = CPU_REG8(c, p.key_reg);
+		else
+			key = c->reg[p.key_reg];
+	}
+	else
+		key = p.key;
+
+	uint32_t first = c->reg[p.ptr] + p.pre + p.disp;
+	uint32_t cells_per_chunk = LOOP_CHUNK_SIZE / p.width;
+
+	while( done < iterations )
+	{
+		uint32_t cells = iterations - done;
+		uint32_t lo;
+
+		if( cells > cells_per_chunk )
+			cells = cells_per_chunk;
+
+		if( p.stride > 0 )
+			lo = first + done * p.width;
+		else
+			lo = first - (done + cells - 1) * p.width;
+
+		uint32_t bytes = cells * p.width;
+
+		/* wrapping around or modifying the loop itself is left to the interpreter */
+		if( lo + bytes < lo )
+			break;
+
+		if( lo < branch_eip + 2 && body_start < lo + bytes )
+			break;
+
+		if( emu_memory_read_block(c->mem, lo, data, bytes) != 0 )
+			break;
+
+		loop_transform(&p, data, bytes, key);
+
+		if( emu_memory_write_block(c->mem, lo, data, bytes) != 0 )
+			break;
+
+		done += cells;
+	}
+
+	if( done == 0 )
+		return 0;
+
+	c->reg[p.ptr] += done * p.stride;
+	c->reg[p.counter] -= done;
+
+	logDebug(c->emu, "fast forwarded %i iterations of the loop at 0x%08x\n", done, body_start);
+
+	return done;
+}
@@ -0,0 +1,157 @@
+/********************************************************************************
+ *                               libemu
+ *
+ *                    - x86 shellcode emulation -
+ *
+ *
+ * Copyright (C) 2007  Paul Baecher & Markus Koetter
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *
+ *             contact nepenthesdev@users.sourceforge.net
+ *
+ *******************************************************************************/
+
+
+/*
+ * execution counters
+ *
+ * With the opcode_stats option set, emu_cpu_step counts every instruction
+ * by its opcode. opcode_stats_cycles additionally reads the timestamp
+ * counter around every 16th step, so the cost per instruction function
+ * can be compared without slowing down every step.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "emu/emu.h"
+#include "emu/emu_cpu.h"
+#include "emu/emu_cpu_data.h"
+
+/* measure one out of STATS_SAMPLE_RATE steps */
+#define STATS_SAMPLE_RATE 16
+
+static inline uint64_t stats_timestamp(void)
+{
+#if defined(__i386__) || defined(__x86_64__)
+	uint32_t lo, hi;
+	__asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+	return ((uint64_t)hi << 32) | lo;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+static struct emu_cpu_stats *stats_get(struct emu_cpu *c)
+{
+	if( c->stats == NULL )
+	{
+		c->stats = malloc(sizeof(struct emu_cpu_stats));
+		if( c->stats != NULL )
+			memset(c->stats, 0, sizeof(struct emu_cpu_stats));
+	}
+
+	return c->stats;
+}
+
+uint64_t emu_cpu_stats_step_begin(struct emu_cpu *c)
+{
+	struct emu_cpu_stats *s = stats_get(c);
+
+	if( s == NULL || !CPU_OPTION_ISSET(c, opcode_stats_cycles) || s->steps % STATS_SAMPLE_RATE != 0 )
+		return 0;
+
+	return stats_timestamp();
+}
+
+void emu_cpu_stats_step_end(struct emu_cpu *c, uint64_t start, int32_t ret)
+{
+	struct emu_cpu_stats *s = c->stats;
+	uint64_t *count, *cycles, *samples;
+	uint8_t opc;
+
+	if( s == NULL )
+		return;
+
+	if( c->instr.is_fpu == 0 && c->instr.cpu.opc == 0x0f )
+	{
+		opc = c->instr.cpu.opc_2nd;
+		count = s->twobyte;
+		cycles = s->twobyte_cycles;
+		samples = s->twobyte_samples;
+	}
+	else
+	{
+		opc = c->instr.opc;
+		count = s->onebyte;
+		cycles = s->onebyte_cycles;
+		samples = s->onebyte_samples;
+	}
+
+	if( start != 0 )
+	{
+		cycles[opc] += stats_timestamp() - start;
+		samples[opc]++;
+	}
+
+	count[opc]++;
+	s->steps++;
+
+	if( ret != 0 )
+		s->faults++;
+}
+
+void emu_cpu_stats_fault(struct emu_cpu *c)
+{
+	struct emu_cpu_stats *s = stats_get(c);
+
+	if( s != NULL )
+		s->faults++;
+}
+
+void emu_cpu_stats_hook(struct emu_cpu *c)
+{
+	if( !CPU_OPTION_ISSET(c, opcode_stats) )
+		return;
+
+	struct emu_cpu_stats *s = stats_get(c);
+
+	if( s != NULL )
+		s->hooks++;
+}
+
+const char *emu_cpu_opcode_name(uint16_t opcode)
+{
+	if( opcode > 0xff )
+		return ii_twobyte[opcode & 0xff].name;
+
+	return ii_onebyte[opcode].name;
+}
+
+const struct emu_cpu_stats *emu_cpu_stats_get(struct emu_cpu *c)
+{
+	return c->stats;
+}
+
+void emu_cpu_stats_reset(struct emu_cpu *c)
+{
+	if( c->stats != NULL )
+		memset(c->stats, 0, sizeof(struct emu_cpu_stats));
+}
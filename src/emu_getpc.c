@@ -29,12 +29,14 @@
 
 
 #include <stdlib.h>
+#include <string.h>
 
 
 #include "emu/emu.h"
 #include "emu/emu_memory.h"
 #include "emu/emu_cpu.h"
 #include "emu/emu_cpu_data.h"
+#include "emu/emu_cpu_decode.h"
 #include "emu/emu_getpc.h"
 #include "emu/emu_cpu_instruction.h"
 
@@ -46,7 +48,6 @@
 uint8_t emu_getpc_check(struct emu *e, uint8_t *data, uint32_t size, uint32_t offset)
 {
 	struct emu_cpu *c = emu_cpu_get(e);
-	struct emu_memory *m = emu_memory_get(e);
 
 
 //	uint32_t offset;
@@ -66,60 +67,43 @@ uint8_t emu_getpc_check(struct emu *e, uint8_t *data, uint32_t size, uint32_t of
 	{
 	/* call */
 	case 0xe8:
-//		emu_memory_write_block(m, 0x1000, data+offset, MIN(size-offset, 6));
-		emu_memory_write_block(m, 0x1000, data, size);
-		emu_cpu_eip_set(c, 0x1000+offset);
+	{
+		/* the code used to be parsed from a copy at 0x1000, which reads as
+		 * zero behind the data up to the end of the page */
+		uint8_t code[32];
+		uint32_t len = MIN(sizeof(code), ((size + 0xfff) & ~0xfff) - offset);
+		struct emu_decoded d;
 
+		memset(code, 0, sizeof(code));
+		memcpy(code, data + offset, MIN(len, size - offset));
 
-		if ( emu_cpu_parse(c) != 0)
-			break;
-/*		
-		printf("data %p size %x offset %x disp %x\n", data, size, offset, c->instr.cpu.disp);
-		printf("data + offset + disp %p <-> %p data + size\n",  (data + offset + c->instr.cpu.disp), data+size);
-		printf("data + offset + disp %p <-> %p data \n",  (data + offset + c->instr.cpu.disp), data);
-*/
-		
-		if (abs(c->instr.cpu.disp) > 512)
-		{
+		if ( emu_cpu_decode(code, len, 0x1000 + offset, &d) <= 0 )
 			break;
-		}
-
-		uint32_t espcopy = emu_cpu_reg32_get(c, esp);
-		int j;
-		for (j=0;j<64;j++)
-		{
-			int ret = emu_cpu_parse(emu_cpu_get(e));
-
-			if (ret != -1)
-			{
-				ret = emu_cpu_step(emu_cpu_get(e));
-			}
 
-			if ( ret == -1 )
-			{
-//				printf("cpu error %s\n", emu_strerror(e));
-				break;
-			}
-
-			if (emu_cpu_reg32_get(c, esp) == espcopy) // eip pushed by call is popped
-				return 1;
-		}
+		/* the call is taken no matter where it goes to, as long as it stays
+		 * close, running it does not tell more */
+		if ( abs(d.instr.cpu.disp) > 512 )
+			break;
 
 		return 1;
-		break;
+	}
 
 		/* fnstenv */
 	case 0xd9:
-		emu_memory_write_block(m, 0x1000, data+offset, MIN(size-offset, 64));
-		emu_cpu_eip_set(c, 0x1000);
-
-		if ( emu_cpu_parse(c) != 0 )
+	{
+		/* all registers but esp are 0, only esp adds to the ea */
+		struct emu_decoded d;
+		if ( emu_cpu_decode(data+offset, MIN(size-offset, 64), 0x1000, &d) <= 0 )
 			break;
 
-		if ( (c->instr.fpu.fpu_data[1] & 0x38) != 0x30 )
+		if ( (d.instr.fpu.fpu_data[1] & 0x38) != 0x30 )
 			break;
 
-		if ( c->instr.fpu.ea == emu_cpu_reg32_get(c, esp) - 0xc )
+		uint32_t ea = d.instr.fpu.ea;
+		if ( d.ea.base == esp )
+			ea += emu_cpu_reg32_get(c, esp);
+
+		if ( (d.flags & EMU_DECODED_MEMORY) && ea == emu_cpu_reg32_get(c, esp) - 0xc )
 		{
 //			printf("found fnstenv with ea = esp - 0xc\n");
 			return 1;
@@ -150,6 +134,7 @@ uint8_t emu_getpc_check(struct emu *e, uint8_t *data, uint32_t size, uint32_t of
 		}
 */
 		break;
+	}
 /*
 	case 0x64: // fs: prefix
 		if ( data[offset+1] == 0x8b )
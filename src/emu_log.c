@@ -93,6 +93,13 @@ void emu_log(struct emu *e, enum emu_log_level level, const char *format, ...)
 	free(message);
 }
 
+int emu_log_level_enabled(struct emu *e, enum emu_log_level level)
+{
+	struct emu_logging *el = emu_logging_get(e);
+
+	return el->loglevel != EMU_LOG_NONE && el->loglevel >= level;
+}
+
 void emu_log_set_logcb(struct emu_logging *el, emu_log_logcb logcb)
 {
 	el->logcb = logcb;
@@ -52,6 +52,17 @@
 
 #define FS_SEGMENT_DEFAULT_OFFSET 0x7ffdf000
 
+/* spares kept over a reset, a shellcode test of a whole window maps about
+ * 20 pages, a reused emu should not keep what one large run mapped */
+#define SPARE_MAX 64
+
+/* a page as it was at the checkpoint, copy is NULL if it was not mapped */
+struct memory_undo
+{
+	uint32_t addr;
+	void *copy;
+};
+
 
 
 struct emu_memory
@@ -65,6 +76,20 @@ struct emu_memory
 	uint32_t segment_table[6];
 
 	bool read_only_access;
+
+	/* number of write accesses, lets cached decodings notice modified code */
+	uint32_t writes;
+
+	/* the checkpoint, pages are copied before the first write to them */
+	bool checkpoint;
+	uint32_t **dirty;	/* per pageset, a bit for every page copied already */
+	struct memory_undo *undo;
+	uint32_t undo_count;
+	uint32_t undo_size;
+	void **spare;		/* copies to reuse */
+	uint32_t spare_count;
+	uint32_t spare_size;
+	uint32_t checkpoint_segment_table[6];
 	
 	struct emu_breakpoint *breakpoint;
 };
@@ -174,6 +199,8 @@ void emu_memory_free(struct emu_memory *m)
 	
 	emu_breakpoint_free(m->breakpoint);
 
+	emu_memory_checkpoint_drop(m);
+
 	for( i = 0; i < (1 << (32 - PAGESET_BITS - PAGE_BITS)); i++ )
 	{
 		if( m->pagetable[i] != NULL )
@@ -204,6 +231,8 @@ void emu_memory_clear(struct emu_memory *m)
 {
 	int i, j;
 	
+	emu_memory_checkpoint_drop(m);
+
 	for( i = 0; i < (1 << (32 - PAGESET_BITS - PAGE_BITS)); i++ )
 	{
 		if( m->pagetable[i] != NULL )
@@ -221,6 +250,80 @@ void emu_memory_clear(struct emu_memory *m)
 	m->segment_table[s_fs] = FS_SEGMENT_DEFAULT_OFFSET;
 
 	m->read_only_access = false;
+	m->writes++;
+}
+
+/* keep a page for page_alloc and page_save to reuse, free it if that fails */
+static void page_spare(struct emu_memory *m, void *page)
+{
+	if( m->spare_count == m->spare_size )
+	{
+		uint32_t size = m->spare_size == 0 ? 64 : m->spare_size * 2;
+		void **spare = realloc(m->spare, size * sizeof(void *));
+		if( spare == NULL )
+		{
+			free(page);
+			return;
+		}
+
+		m->spare = spare;
+		m->spare_size = size;
+	}
+
+	m->spare[m->spare_count++] = page;
+}
+
+/* free the spares beyond SPARE_MAX */
+static void spare_trim(struct emu_memory *m)
+{
+	while( m->spare_count > SPARE_MAX )
+		free(m->spare[--m->spare_count]);
+
+	if( m->spare_size > SPARE_MAX )
+	{
+		void **spare = realloc(m->spare, SPARE_MAX * sizeof(void *));
+		if( spare != NULL )
+		{
+			m->spare = spare;
+			m->spare_size = SPARE_MAX;
+		}
+	}
+}
+
+static void checkpoint_reset(struct emu_memory *m);
+
+void emu_memory_reset(struct emu_memory *m)
+{
+	int i, j;
+
+	checkpoint_reset(m);
+	m->checkpoint = false;
+
+	for( i = 0; i < (1 << (32 - PAGESET_BITS - PAGE_BITS)); i++ )
+	{
+		if( m->pagetable[i] != NULL )
+		{
+			for( j = 0; j < PAGESET_SIZE; j++ )
+			{
+				if( m->pagetable[i][j] != NULL )
+				{
+					page_spare(m, m->pagetable[i][j]);
+					m->pagetable[i][j] = NULL;
+				}
+			}
+		}
+	}
+
+	spare_trim(m);
+
+	emu_breakpoint_clear(m);
+
+	memset(m->segment_table, 0, sizeof(m->segment_table));
+	m->segment_table[s_fs] = FS_SEGMENT_DEFAULT_OFFSET;
+	emu_memory_segment_select(m, s_cs);
+
+	m->read_only_access = false;
+	m->writes++;
 }
 
 static inline int page_is_alloc(struct emu_memory *em, uint32_t addr)
@@ -236,16 +339,78 @@ static inline int page_is_alloc(struct emu_memory *em, uint32_t addr)
 	return 0;
 }
 
+/* remember the page before it is written to the first time after the checkpoint */
+static int page_save(struct emu_memory *em, uint32_t addr)
+{
+	uint32_t *dirty;
+
+	if( em->dirty == NULL )
+	{
+		em->dirty = malloc((1 << (32 - PAGE_BITS - PAGESET_BITS)) * sizeof(uint32_t *));
+		if( em->dirty == NULL )
+			goto nomem;
+
+		memset(em->dirty, 0, (1 << (32 - PAGE_BITS - PAGESET_BITS)) * sizeof(uint32_t *));
+	}
+
+	if( (dirty = em->dirty[PAGESET(addr)]) == NULL )
+	{
+		if( (dirty = em->dirty[PAGESET(addr)] = malloc(PAGESET_SIZE / 8)) == NULL )
+			goto nomem;
+
+		memset(dirty, 0, PAGESET_SIZE / 8);
+	}
+
+	if( dirty[PAGE(addr) >> 5] & (1 << (PAGE(addr) & 31)) )
+		return 0;
+
+	if( em->undo_count == em->undo_size )
+	{
+		uint32_t size = em->undo_size == 0 ? 64 : em->undo_size * 2;
+		struct memory_undo *undo = realloc(em->undo, size * sizeof(struct memory_undo));
+		if( undo == NULL )
+			goto nomem;
+
+		em->undo = undo;
+		em->undo_size = size;
+	}
+
+	struct memory_undo *u = &em->undo[em->undo_count];
+	u->addr = addr;
+	u->copy = NULL;
+
+	if( em->pagetable[PAGESET(addr)] != NULL && em->pagetable[PAGESET(addr)][PAGE(addr)] != NULL )
+	{
+		if( em->spare_count > 0 )
+			u->copy = em->spare[--em->spare_count];
+		else
+		if( (u->copy = malloc(PAGE_SIZE)) == NULL )
+			goto nomem;
+
+		memcpy(u->copy, em->pagetable[PAGESET(addr)][PAGE(addr)], PAGE_SIZE);
+	}
+
+	em->undo_count++;
+	dirty[PAGE(addr) >> 5] |= 1 << (PAGE(addr) & 31);
+	return 0;
+
+nomem:
+	emu_error_set(em->emu, ENOMEM, "out of memory\n", 0);
+	return -1;
+}
+
 static inline int page_alloc(struct emu_memory *em, uint32_t addr)
 {
+	if( em->checkpoint == true && page_save(em, addr) == -1 )
+		return -1;
+
 	if( em->pagetable[PAGESET(addr)] == NULL )
 	{
 		em->pagetable[PAGESET(addr)] = malloc(PAGESET_SIZE * sizeof(void *));
 		
 		if( em->pagetable[PAGESET(addr)] == NULL )
 		{
-			emu_errno_set(em->emu, ENOMEM);
-			emu_strerror_set(em->emu, "out of memory\n", addr);
+			emu_error_set(em->emu, ENOMEM, "out of memory\n", 0);
 			return -1;
 		}
 		
@@ -254,12 +419,14 @@ static inline int page_alloc(struct emu_memory *em, uint32_t addr)
 
 	if( em->pagetable[PAGESET(addr)][PAGE(addr)] == NULL )
 	{
-		em->pagetable[PAGESET(addr)][PAGE(addr)] = malloc(PAGE_SIZE);
+		if( em->spare_count > 0 )
+			em->pagetable[PAGESET(addr)][PAGE(addr)] = em->spare[--em->spare_count];
+		else
+			em->pagetable[PAGESET(addr)][PAGE(addr)] = malloc(PAGE_SIZE);
 		
 		if( em->pagetable[PAGESET(addr)][PAGE(addr)] == NULL )
 		{
-			emu_errno_set(em->emu, ENOMEM);
-			emu_strerror_set(em->emu, "out of memory\n", addr);
+			emu_error_set(em->emu, ENOMEM, "out of memory\n", 0);
 			return -1;
 		}
 		memset(em->pagetable[PAGESET(addr)][PAGE(addr)], 0, PAGE_SIZE);
@@ -288,8 +455,7 @@ int32_t emu_memory_read_byte(struct emu_memory *m, uint32_t addr, uint8_t *byte)
 	
 	if( address == NULL )
 	{
-		emu_errno_set(m->emu, EFAULT);
-		emu_strerror_set(m->emu, "error accessing 0x%08x not mapped\n", addr);
+		emu_error_set(m->emu, EFAULT, "error accessing 0x%08x not mapped\n", addr);
 		return -1;
 	}
 	
@@ -339,8 +505,7 @@ int32_t emu_memory_read_block(struct emu_memory *m, uint32_t addr, void *dest, s
 	
 	if( address == NULL )
 	{
-		emu_errno_set(m->emu, EFAULT);
-		emu_strerror_set(m->emu, "error accessing 0x%08x not mapped\n", addr);
+		emu_error_set(m->emu, EFAULT, "error accessing 0x%08x not mapped\n", addr);
 		return -1;
 	}
 
@@ -395,6 +560,9 @@ int32_t emu_memory_write_byte(struct emu_memory *m, uint32_t addr, uint8_t byte)
 
 	addr += m->segment_offset;
 
+	if( m->checkpoint == true && page_save(m, addr) == -1 )
+		return -1;
+
 	void *address = translate_addr(m, addr);
 	
 	if( address == NULL )
@@ -406,6 +574,7 @@ int32_t emu_memory_write_byte(struct emu_memory *m, uint32_t addr, uint8_t byte)
 	}
 	
 	*((uint8_t *)address) = byte;
+	m->writes++;
 	
 	return 0;
 }
@@ -450,9 +619,14 @@ int32_t emu_memory_write_block(struct emu_memory *m, uint32_t addr, const void *
 	if (m->read_only_access == true)
 		return 0;
 
+	m->writes++;
+
 	uint32_t oaddr = addr; /* save original addr for recursive call */
 	addr += m->segment_offset;
 
+	if( m->checkpoint == true && page_save(m, addr) == -1 )
+		return -1;
+
 	void *address = translate_addr(m, addr);
 
 	if( address == NULL )
@@ -557,6 +731,105 @@ int32_t emu_memory_alloc(struct emu_memory *m, uint32_t *addr, size_t len)
 	return -1;
 }
 
+/* forget the copies, they are kept as spares */
+static void checkpoint_reset(struct emu_memory *m)
+{
+	uint32_t i;
+
+	for( i = 0; i < m->undo_count; i++ )
+	{
+		struct memory_undo *u = &m->undo[i];
+
+		if( u->copy != NULL )
+			page_spare(m, u->copy);
+
+		m->dirty[PAGESET(u->addr)][PAGE(u->addr) >> 5] &= ~(1 << (PAGE(u->addr) & 31));
+	}
+
+	m->undo_count = 0;
+}
+
+void emu_memory_checkpoint_drop(struct emu_memory *m)
+{
+	uint32_t i;
+
+	checkpoint_reset(m);
+
+	for( i = 0; i < m->spare_count; i++ )
+		free(m->spare[i]);
+
+	if( m->spare != NULL )
+		free(m->spare);
+
+	if( m->undo != NULL )
+		free(m->undo);
+
+	if( m->dirty != NULL )
+	{
+		for( i = 0; i < (1 << (32 - PAGE_BITS - PAGESET_BITS)); i++ )
+			if( m->dirty[i] != NULL )
+				free(m->dirty[i]);
+
+		free(m->dirty);
+	}
+
+	m->spare = NULL;
+	m->spare_count = m->spare_size = 0;
+	m->undo = NULL;
+	m->undo_size = 0;
+	m->dirty = NULL;
+	m->checkpoint = false;
+}
+
+int32_t emu_memory_checkpoint(struct emu_memory *m)
+{
+	checkpoint_reset(m);
+
+	memcpy(m->checkpoint_segment_table, m->segment_table, sizeof(m->segment_table));
+	m->checkpoint = true;
+
+	return 0;
+}
+
+int32_t emu_memory_rollback(struct emu_memory *m)
+{
+	uint32_t i;
+
+	if( m->checkpoint == false )
+	{
+		emu_error_set(m->emu, EINVAL, "no memory checkpoint to roll back to\n", 0);
+		return -1;
+	}
+
+	for( i = 0; i < m->undo_count; i++ )
+	{
+		struct memory_undo *u = &m->undo[i];
+
+		if( m->pagetable[PAGESET(u->addr)] == NULL )
+			continue;
+
+		void **page = &m->pagetable[PAGESET(u->addr)][PAGE(u->addr)];
+
+		if( u->copy != NULL )
+			memcpy(*page, u->copy, PAGE_SIZE);
+		else
+		if( *page != NULL )
+		{
+			page_spare(m, *page);
+			*page = NULL;
+		}
+	}
+
+	checkpoint_reset(m);
+
+	memcpy(m->segment_table, m->checkpoint_segment_table, sizeof(m->segment_table));
+	emu_memory_segment_select(m, s_cs);
+	m->read_only_access = false;
+	m->writes++;
+
+	return 0;
+}
+
 void emu_memory_mode_ro(struct emu_memory *m)
 {
 	m->read_only_access = true;
@@ -569,6 +842,11 @@ void emu_memory_mode_rw(struct emu_memory *m)
 
 
 /*  Everything below this is ugly.  */
+uint32_t emu_memory_get_writes(struct emu_memory *m)
+{
+	return m->writes;
+}
+
 struct emu_breakpoint *emu_memory_get_breakpoint(struct emu_memory *m)
 {
 	return m->breakpoint;
@@ -0,0 +1,110 @@
+/********************************************************************************
+ *                               libemu
+ *
+ *                    - x86 shellcode emulation -
+ *
+ *
+ * Copyright (C) 2007  Paul Baecher & Markus Koetter
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ * 
+ * 
+ *             contact nepenthesdev@users.sourceforge.net  
+ *
+ *******************************************************************************/
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "emu/emu.h"
+#include "emu/emu_pool.h"
+
+struct emu_pool
+{
+	pthread_mutex_t lock;
+
+	/* the idle emus, all reset already */
+	struct emu **idle;
+	uint32_t count;
+	uint32_t max;
+};
+
+struct emu_pool *emu_pool_new(uint32_t max)
+{
+	struct emu_pool *p = (struct emu_pool *)malloc(sizeof(struct emu_pool));
+	if( p == NULL )
+		return NULL;
+
+	memset(p, 0, sizeof(struct emu_pool));
+
+	if( max > 0 && (p->idle = (struct emu **)malloc(max * sizeof(struct emu *))) == NULL )
+	{
+		free(p);
+		return NULL;
+	}
+
+	p->max = max;
+	pthread_mutex_init(&p->lock, NULL);
+
+	return p;
+}
+
+void emu_pool_free(struct emu_pool *p)
+{
+	uint32_t i;
+
+	for( i = 0; i < p->count; i++ )
+		emu_free(p->idle[i]);
+
+	if( p->idle != NULL )
+		free(p->idle);
+
+	pthread_mutex_destroy(&p->lock);
+	free(p);
+}
+
+struct emu *emu_pool_get(struct emu_pool *p)
+{
+	struct emu *e = NULL;
+
+	pthread_mutex_lock(&p->lock);
+	if( p->count > 0 )
+		e = p->idle[--p->count];
+	pthread_mutex_unlock(&p->lock);
+
+	if( e == NULL )
+		e = emu_new();
+
+	return e;
+}
+
+void emu_pool_put(struct emu_pool *p, struct emu *e)
+{
+	/* reset outside of the lock, emu_pool_get stays constant time */
+	emu_reset(e);
+
+	pthread_mutex_lock(&p->lock);
+	if( p->count < p->max )
+	{
+		p->idle[p->count++] = e;
+		e = NULL;
+	}
+	pthread_mutex_unlock(&p->lock);
+
+	if( e != NULL )
+		emu_free(e);
+}
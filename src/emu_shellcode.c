@@ -27,6 +27,11 @@
 
 #include "../config.h"
 
+#include <errno.h>
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
 #include "emu/emu_shellcode.h"
 
 #include "emu/emu.h"
@@ -36,6 +41,7 @@
 #include "emu/emu_track.h"
 #include "emu/emu_source.h"
 #include "emu/emu_getpc.h"
+#include "emu/emu_triage.h"
 #include "emu/environment/emu_env.h"
 #include "emu/environment/win32/emu_env_w32.h"
 #include "emu/environment/win32/emu_env_w32_dll_export.h"
@@ -50,6 +56,108 @@
 #define STATIC_OFFSET 0x00471000
 #define EMU_SHELLCODE_TEST_MAX_STEPS 128
 
+/**
+ * The memory and environment every tested position starts from.
+ * Writing the code and loading the dlls is done once, the memory is
+ * rolled back to a checkpoint taken afterwards for the next position.
+ * Only if a hook ran the environment is created again, as the hooks
+ * keep state outside of the memory.
+ * The colors of the static graph offsets used by the search are kept
+ * here too, so several emus can search the same graph.
+ */
+struct shellcode_env
+{
+	struct emu_env *env;
+	bool hooked;
+	enum emu_color *colors;
+
+	/* held around known_positions if it is shared between threads, the
+	 * positions a run inserts are added to known_positions only once the
+	 * run is committed then, see shellcode_pass_commit */
+	pthread_mutex_t *lock;
+
+	/* with a lock, the positions the current run inserted and the ones it
+	 * searched and did not find, claimed[offset] is the run which inserted
+	 * the position at offset */
+	struct emu_list_root *inserted;
+	struct emu_list_root *missed;
+	uint32_t *claimed;
+	uint32_t claimed_size;
+	uint32_t run;
+
+	/* the queue of the backwards traversal, kept for the next one */
+	struct emu_tracking_info *bfs;
+	uint32_t bfs_size;
+};
+
+/**
+ * Append a position to the traversal queue, the queue grows as needed.
+ * As the queue may move, the position dequeued is copied out first.
+ * 
+ * @return the position appended, NULL if out of memory
+ */
+static struct emu_tracking_info *bfs_enqueue(struct shellcode_env *se, uint32_t *tail)
+{
+	if ( *tail == se->bfs_size )
+	{
+		uint32_t size = se->bfs_size == 0 ? 64 : se->bfs_size * 2;
+		struct emu_tracking_info *bfs = realloc(se->bfs, size * sizeof(struct emu_tracking_info));
+		if ( bfs == NULL )
+			return NULL;
+
+		se->bfs = bfs;
+		se->bfs_size = size;
+	}
+
+	return &se->bfs[(*tail)++];
+}
+
+static bool known_claimed(struct shellcode_env *se, uint32_t eip)
+{
+	return eip - STATIC_OFFSET < se->claimed_size && se->claimed[eip - STATIC_OFFSET] == se->run;
+}
+
+static bool known_search(struct shellcode_env *se, struct emu_hashtable *known_positions, uint32_t eip)
+{
+	struct emu_hashtable_item *ehi;
+
+	if ( se->lock == NULL )
+		return emu_hashtable_search(known_positions, (void *)(uintptr_t)eip) != NULL;
+
+	if ( known_claimed(se, eip) == true )
+		return true;
+
+	pthread_mutex_lock(se->lock);
+	ehi = emu_hashtable_search(known_positions, (void *)(uintptr_t)eip);
+	pthread_mutex_unlock(se->lock);
+
+	/* the answer holds only as long as no earlier candidate inserts it */
+	if ( ehi == NULL )
+	{
+		struct emu_list_item *eli = emu_list_item_create();
+		eli->uint32 = eip;
+		emu_list_insert_last(se->missed, eli);
+	}
+
+	return ehi != NULL;
+}
+
+static void known_insert(struct shellcode_env *se, struct emu_hashtable *known_positions, uint32_t eip)
+{
+	if ( se->lock == NULL )
+	{
+		emu_hashtable_insert(known_positions, (void *)(uintptr_t)eip, NULL);
+		return;
+	}
+
+	if ( eip - STATIC_OFFSET < se->claimed_size )
+		se->claimed[eip - STATIC_OFFSET] = se->run;
+
+	struct emu_list_item *eli = emu_list_item_create();
+	eli->uint32 = eip;
+	emu_list_insert_last(se->inserted, eli);
+}
+
 
 int tested_positions_cmp(struct emu_list_item *a, struct emu_list_item *b)
 {
@@ -134,6 +242,9 @@ int tested_positions_cmp(struct emu_list_item *a, struct emu_list_item *b)
  * @param datasize  the data size
  * @param eipoffset the offset for eip
  * @param steps     how many steps to try running
+ * @param se        the memory checkpoint, environment and search
+ *                  colors, shared by all calls on this emu for the
+ *                  same data
  * @param etas      the track and source tree - the substantial
  *                  information to run the breath first search
  * @param known_positions
@@ -147,10 +258,10 @@ int tested_positions_cmp(struct emu_list_item *a, struct emu_list_item *b)
  */
 int32_t     emu_shellcode_run_and_track(struct emu *e, 
 										uint8_t *data, 
-										uint16_t datasize, 
-										uint16_t eipoffset,
+										uint32_t datasize, 
+										uint32_t eipoffset,
 										uint32_t steps,
-//										struct emu_env_w32 *env, 
+										struct shellcode_env *se,
 										struct emu_track_and_source *etas,
 										struct emu_hashtable *known_positions,
 										struct emu_list_root *stats_tested_positions_list,
@@ -162,25 +273,24 @@ int32_t     emu_shellcode_run_and_track(struct emu *e,
 
 
 	struct emu_queue *eq = emu_queue_new();
-	emu_queue_enqueue(eq, (void *)((uintptr_t)(uint32_t)eipoffset+STATIC_OFFSET));
+	emu_queue_enqueue(eq, (void *)((uintptr_t)eipoffset+STATIC_OFFSET));
 
 //	struct emu_list_root *tested_positions = emu_list_create();
 
-	struct emu_env *env = NULL;
+	struct emu_env *env = se->env;
+	struct emu_source_graph *graph = etas->static_graph;
 
 	{ // mark all vertexes white
-
-		struct emu_vertex *x;
-		for ( x= emu_vertexes_first(etas->static_instr_graph->vertexes); !emu_vertexes_attail(x); x = emu_vertexes_next(x))
-		{
-			x->color = white;
-		}
-
-	}		 
+		uint32_t x;
+		for ( x=0; x<datasize; x++ )
+			se->colors[x] = white;
+	}
 
 	while ( !emu_queue_empty(eq) )
 	{
-		
+		if ( emu_interrupted(e) != 0 )
+			break;
+
 		uint32_t current_offset = (uint32_t)(uintptr_t)emu_queue_dequeue(eq);
 
 		/* init the cpu/memory 
@@ -189,14 +299,25 @@ int32_t     emu_shellcode_run_and_track(struct emu *e,
         {
 			logDebug(e, "running at offset %i %08x\n", current_offset, current_offset);
 
-			emu_memory_clear(mem);
-			if (env)
-				emu_env_free(env);
+			if ( env == NULL || se->hooked == true || emu_memory_rollback(mem) != 0 )
+			{
+				emu_memory_reset(mem);
+
+				/* write the code to the offset */
+				emu_memory_write_block(mem, STATIC_OFFSET, data, datasize);
+
+				if ( env != NULL && emu_env_reset(env) != 0 )
+				{
+					emu_env_free(env);
+					env = NULL;
+				}
+
+				if ( env == NULL )
+					se->env = env = emu_env_new(e);
 
-			/* write the code to the offset */
-			emu_memory_write_block(mem, STATIC_OFFSET, data, datasize);
-			
-			env = emu_env_new(e);
+				se->hooked = false;
+				emu_memory_checkpoint(mem);
+			}
 
 			/* set the registers to the initial values */
 			int reg;
@@ -228,6 +349,7 @@ int32_t     emu_shellcode_run_and_track(struct emu *e,
 
 			if ( hook != NULL )
 			{
+				se->hooked = true;
 				if ( hook->hook.win->fnhook == NULL )
 					break;
 			}
@@ -237,14 +359,21 @@ int32_t     emu_shellcode_run_and_track(struct emu *e,
 				int32_t ret = emu_cpu_parse(emu_cpu_get(e));
 				if ( ret == -1 )
 				{
-					logDebug(e, "error at %s\n", cpu->instr_string);
+					logDebug(e, "error at %s\n", emu_cpu_instruction_string(cpu));
 					break;
 				}
 
 				ret = emu_cpu_step(emu_cpu_get(e));
 				if ( ret == -1 )
 				{
-					logDebug(e, "error at %s (%s)\n", cpu->instr_string, strerror(emu_errno(e)));
+					logDebug(e, "error at %s (%s)\n", emu_cpu_instruction_string(cpu), strerror(emu_errno(e)));
+					if ( emu_errno(e) == ELOOP )
+					{
+						/* stuck in a loop, it would have used up all steps */
+						j = steps;
+						break;
+					}
+
 					if (brute_force)
 					{
 						logDebug(e, "goto traversal\n");
@@ -257,7 +386,7 @@ int32_t     emu_shellcode_run_and_track(struct emu *e,
 				if ( emu_track_instruction_check(e, etas) == -1 )
 				{
 traversal:
-					logDebug(e, "failed instr %s\n", cpu->instr_string);
+					logDebug(e, "failed instr %s\n", emu_cpu_instruction_string(cpu));
 					logDebug(e, "tracking at eip %08x\n", eipsave);
 					if ( 0 && cpu->instr.is_fpu )
 					{
@@ -270,98 +399,101 @@ traversal:
 //						struct emu_tracking_info *instruction_needs_ti = emu_tracking_info_new();
 //						emu_tracking_info_copy(&cpu->instr.cpu.track.need, instruction_needs_ti);
 
-						struct emu_queue *bfs_queue = emu_queue_new();
+						/* the positions queued are se->bfs[bfs_head] to se->bfs[bfs_tail - 1] */
+						uint32_t bfs_head = 0;
+						uint32_t bfs_tail = 0;
 
 						/*
 						 * the current starting point is the first position used to bfs
 						 * scooped to avoid varname collisions 
 						 */
 						{ 
-							struct emu_tracking_info *eti = emu_tracking_info_new();
+							struct emu_tracking_info *eti = bfs_enqueue(se, &bfs_tail);
+							if ( eti == NULL )
+								break;
+
 							emu_tracking_info_diff(&cpu->instr.track.need, &etas->track, eti);
 							eti->eip = current_offset;
 							emu_tracking_info_debug_print(eti);
 
-							if( emu_hashtable_search(known_positions, (void *)(uintptr_t)(uint32_t)current_offset) != NULL)
+							if( known_search(se, known_positions, current_offset) == true )
 							{
 								logDebug(e, "Known %p %x\n", eti, eti->eip);
-								emu_tracking_info_free(eti);
-								emu_queue_free(bfs_queue);
 								break;
 							}
-
-							emu_queue_enqueue(bfs_queue, eti);
 						}
-						while ( !emu_queue_empty(bfs_queue) )
+						while ( bfs_head < bfs_tail )
 						{
 							logDebug(e, "loop %s:%i\n", __FILE__, __LINE__);
 
-							struct emu_tracking_info *current_pos_ti_diff = (struct emu_tracking_info *)emu_queue_dequeue(bfs_queue);
-							struct emu_hashtable_item *current_pos_ht = emu_hashtable_search(etas->static_instr_table, (void *)(uintptr_t)(uint32_t)current_pos_ti_diff->eip);
-							if (current_pos_ht == NULL)
+							struct emu_tracking_info current_pos_ti = se->bfs[bfs_head++];
+							struct emu_tracking_info *current_pos_ti_diff = &current_pos_ti;
+							struct emu_source_and_track_instr_info *current_pos_satii = emu_source_graph_instr(graph, current_pos_ti_diff->eip);
+							if (current_pos_satii == NULL)
 							{
-								logDebug(e, "current_pos_ht is NULL?\n");
+								logDebug(e, "current_pos_satii is NULL?\n");
 								exit(-1);
 							}
 
-							struct emu_vertex *current_pos_v = (struct emu_vertex *)current_pos_ht->value;
-							struct emu_source_and_track_instr_info *current_pos_satii = (struct emu_source_and_track_instr_info *)current_pos_v->data;
+							uint32_t current_pos = current_pos_satii->eip - graph->start;
 
-							if( emu_hashtable_search(known_positions, (void *)(uintptr_t)(uint32_t)current_pos_satii->eip) != NULL )
+							if( known_search(se, known_positions, current_pos_satii->eip) == true )
 							{
 								logDebug(e, "Known Again %p %x\n", current_pos_satii, current_pos_satii->eip);
-								current_pos_v->color = red;
-								emu_tracking_info_free(current_pos_ti_diff);
+								se->colors[current_pos] = red;
 								continue;
 							}
 
-							if (current_pos_v->color == red)
+							if (se->colors[current_pos] == red)
 							{
-								logDebug(e, "is red %p %x: %s\n", (uintptr_t)current_pos_v, current_pos_satii->eip, current_pos_satii->instrstring);
-								emu_tracking_info_free(current_pos_ti_diff);
+								logDebug(e, "is red %i %x: %s\n", current_pos, current_pos_satii->eip, emu_source_and_track_instr_info_string(current_pos_satii));
 								continue;
 							}
 
-							logDebug(e, "marking red %p %x: %s \n", (uintptr_t)current_pos_v, current_pos_satii->eip, current_pos_satii->instrstring);
-							current_pos_v->color = red;
+							logDebug(e, "marking red %i %x: %s \n", current_pos, current_pos_satii->eip, emu_source_and_track_instr_info_string(current_pos_satii));
+							se->colors[current_pos] = red;
 
-							emu_hashtable_insert(known_positions, (void *)(uintptr_t)(uint32_t)current_pos_satii->eip, NULL);
+							known_insert(se, known_positions, current_pos_satii->eip);
 
 							while ( !emu_tracking_info_covers(&current_pos_satii->track.init, current_pos_ti_diff) || brute_force )
 							{
 								logDebug(e, "loop %s:%i\n", __FILE__, __LINE__);
 
-								if ( current_pos_v->backlinks == 0 )
+								uint32_t *backedges = graph->pred + graph->pred_index[current_pos];
+								uint32_t backlinks = graph->pred_index[current_pos + 1] - graph->pred_index[current_pos];
+
+								if ( backlinks == 0 )
 								{
 									break;
 								}
 								else
-								if ( current_pos_v->backlinks > 1 )
+								if ( backlinks > 1 )
 								{ /* queue all to diffs to the bfs queue */
-									struct emu_edge *ee;
-									struct emu_vertex *ev;
-									for ( ee = emu_edges_first(current_pos_v->backedges); !emu_edges_attail(ee); ee=emu_edges_next(ee) )
+									uint32_t k;
+									for ( k=0; k<backlinks; k++ )
 									{
-										ev = ee->destination;
+										uint32_t ev = backedges[k];
 										/**
 										 * ignore positions we've visited already 
 										 * avoids dos for jz 0 
 										 *  
 										 * try the next position instead 
 										 */
-										if( ev->color == red )
+										if( se->colors[ev] == red )
 											continue;
 
-										struct emu_source_and_track_instr_info *next_pos_satii =  (struct emu_source_and_track_instr_info *)ev->data;
+										struct emu_source_and_track_instr_info *next_pos_satii = &graph->instr[ev];
 										
 
 										
 
-										logDebug(e, "EnqueueLoop %p %x %s\n", next_pos_satii, next_pos_satii->eip, next_pos_satii->instrstring);
-										struct emu_tracking_info *eti = emu_tracking_info_new();
+										logDebug(e, "EnqueueLoop %p %x %s\n", next_pos_satii, next_pos_satii->eip, emu_source_and_track_instr_info_string(next_pos_satii));
+										struct emu_tracking_info *eti = bfs_enqueue(se, &bfs_tail);
+										if ( eti == NULL )
+											break;
+
 										emu_tracking_info_diff(current_pos_ti_diff, &current_pos_satii->track.init, eti);
 										eti->eip = next_pos_satii->eip;
-										emu_queue_enqueue(bfs_queue, eti);
 									}
 									/**
 									 * the new possible positions and requirements got queued into the bfs queue, 
@@ -370,7 +502,7 @@ traversal:
 									break;
 								}
 								else
-								if ( current_pos_v->backlinks == 1 )
+								if ( backlinks == 1 )
 								{ /* follow the single link */
 									/**
 									 * ignore loops	to self 
@@ -378,22 +510,22 @@ traversal:
 									 * breaks the upper loop 
 									 *  
 									 */
-									if( current_pos_v == emu_edges_first(current_pos_v->backedges)->destination )
+									if( current_pos == backedges[0] )
 										break;
 									
-									current_pos_v = emu_edges_first(current_pos_v->backedges)->destination;
+									current_pos = backedges[0];
 									/**
 									 * again, ignore already visited positions 
 									 * breaks the upper loop 
 									 */
-									if( current_pos_v->color == red )
+									if( se->colors[current_pos] == red )
 										break;
 
-									current_pos_v->color = red;
+									se->colors[current_pos] = red;
 									
-									struct emu_source_and_track_instr_info *next_pos_satii =  (struct emu_source_and_track_instr_info *)current_pos_v->data;
-									logDebug(e, "FollowSingle %p %i %x %s\n", next_pos_satii, current_pos_v->color, next_pos_satii->eip, next_pos_satii->instrstring);
-									current_pos_satii = (struct emu_source_and_track_instr_info *)current_pos_v->data;
+									struct emu_source_and_track_instr_info *next_pos_satii = &graph->instr[current_pos];
+									logDebug(e, "FollowSingle %p %i %x %s\n", next_pos_satii, se->colors[current_pos], next_pos_satii->eip, emu_source_and_track_instr_info_string(next_pos_satii));
+									current_pos_satii = next_pos_satii;
 									emu_tracking_info_diff(current_pos_ti_diff, &current_pos_satii->track.init, current_pos_ti_diff);
 								}
 							}
@@ -406,21 +538,15 @@ traversal:
 								 * therefore we mark it white, so it can be processed again
 								 */
 								logDebug(e, "found position which satiesfies the requirements %i %08x\n", current_pos_satii->eip, current_pos_satii->eip);
-								current_pos_ht = emu_hashtable_search(etas->static_instr_table, (void *)(uintptr_t)(uint32_t)current_pos_satii->eip);
-								current_pos_v = (struct emu_vertex *)current_pos_ht->value;
-
 								if(current_pos_satii->eip != current_offset )
 								{
-									logDebug(e, "marking white %p %x: %s \n", (uintptr_t)current_pos_v, current_pos_satii->eip, current_pos_satii->instrstring);
-									current_pos_v->color = white;
+									logDebug(e, "marking white %i %x: %s \n", current_pos, current_pos_satii->eip, emu_source_and_track_instr_info_string(current_pos_satii));
+									se->colors[current_pos] = white;
 								}
 								emu_tracking_info_debug_print(&current_pos_satii->track.init);
 								emu_queue_enqueue(eq, (void *)((uintptr_t)(uint32_t)current_pos_satii->eip));
 							}
-//discard:
-							emu_tracking_info_free( current_pos_ti_diff);
 						}
-						emu_queue_free(bfs_queue);
 					}
 					/** 
 					 * the shellcode did not run correctly as he was missing instructions initializing required registers
@@ -430,7 +556,7 @@ traversal:
 					break;
 				}else
 				{
-					logDebug(e, "%s\n", cpu->instr_string);
+					logDebug(e, "%s\n", emu_cpu_instruction_string(cpu));
 				}
 			}
 		}
@@ -445,7 +571,9 @@ traversal:
 	}
 
 	emu_queue_free(eq);
-	emu_env_free(env);
+
+	if ( emu_list_length(stats_tested_positions_list) == 0 )
+		return -1;
 
 	/* sort all tested positions by the number of steps ascending */
 	emu_list_qsort(stats_tested_positions_list, tested_positions_cmp);
@@ -457,31 +585,343 @@ traversal:
 	return best_offset - STATIC_OFFSET;
 }
 
-enum
+enum emu_shellcode_suspect
 {
 	EMU_SCTEST_SUSPECT_GETPC,
 	EMU_SCTEST_SUSPECT_MOVFS
-} emu_shellcode_suspect;
+};
 
 
 
-int32_t emu_shellcode_test(struct emu *e, uint8_t *data, uint16_t size)
+/**
+ * The positions the run of an offset inserted and the ones it searched
+ * without finding them, until the run is committed.
+ */
+struct shellcode_claims
 {
-	logPF(e);
-/*
+	struct emu_list_root *inserted;
+	struct emu_list_root *missed;
+	bool done;
+};
 
-	
-	bool found_good_candidate_after_getpc = false;
+/**
+ * A pass over start offsets, the one over the GetPC candidates or the
+ * brute force one over the positions tested before.
+ * The workers take the offsets in order, the results of each offset
+ * are kept apart and concatenated in the order of the offsets once
+ * the pass is done, so the list does not depend on which worker tested
+ * which offset.
+ * With several workers, the positions an offset inserts are added to
+ * known_positions in the order of the offsets, and an offset is tested
+ * again if it missed a position an offset in front of it inserted, so
+ * each offset sees the positions it would see testing them one after
+ * another.
+ */
+struct shellcode_pass
+{
+	uint8_t *data;
+	uint32_t size;
+	bool brute_force;
+
+	uint32_t *offsets;
+	uint32_t count;
+	struct emu_list_root **results;
+
+	struct emu_hashtable *known_positions;
+	pthread_mutex_t known_lock;
+
+	/* held by known_lock, the offsets in front of committed are in
+	 * known_positions, a worker committing holds committing */
+	struct shellcode_claims *claims;
+	uint32_t committed;
+	bool committing;
+
+	/* the next offset to test, taken with __sync_fetch_and_add */
+	uint32_t next;
+
+	/* the number of threads still working on the pass */
+	uint32_t running;
+	pthread_mutex_t running_lock;
+	pthread_cond_t running_cond;
+};
+
+/**
+ * A worker runs its own emu, the static graph is shared with the
+ * others, the tracking state in etas is its own.
+ */
+struct shellcode_worker
+{
+	struct emu *e;
+	struct shellcode_env se;
+	struct emu_track_and_source *etas;
+	struct shellcode_pass *pass;
+	pthread_t thread;
+};
+
+static void shellcode_worker_test(struct shellcode_worker *w, uint32_t i)
+{
+	struct shellcode_pass *p = w->pass;
+
+	if ( p->claims != NULL )
+	{
+		w->se.run++;
+		w->se.inserted = p->claims[i].inserted;
+		w->se.missed = p->claims[i].missed;
+	}
+
+	logDebug(w->e, "testing offset %i %08x\n", p->offsets[i], p->offsets[i]);
+	emu_shellcode_run_and_track(w->e, p->data, p->size, p->offsets[i], 256, &w->se, w->etas,
+								p->known_positions, p->results[i], p->brute_force);
+}
+
+/**
+ * Mark the offset i done and commit the offsets done in order, the
+ * first one committing does it for all of them.
+ */
+static void shellcode_pass_commit(struct shellcode_worker *w, uint32_t i)
+{
+	struct shellcode_pass *p = w->pass;
+	struct emu_list_item *eli;
+
+	pthread_mutex_lock(&p->known_lock);
+	p->claims[i].done = true;
+
+	if ( p->committing == true )
+	{
+		pthread_mutex_unlock(&p->known_lock);
+		return;
+	}
+
+	p->committing = true;
+
+	while ( p->committed < p->count && p->claims[p->committed].done == true )
+	{
+		struct shellcode_claims *c = &p->claims[p->committed];
+
+		for ( eli = emu_list_first(c->missed); !emu_list_attail(eli); eli = emu_list_next(eli) )
+			if ( emu_hashtable_search(p->known_positions, (void *)(uintptr_t)eli->uint32) != NULL )
+				break;
+
+		/* nothing gets committed meanwhile, so the second run sees what
+		 * it would see testing the offsets one after another */
+		if ( !emu_list_attail(eli) && emu_interrupted(w->e) == 0 )
+		{
+			pthread_mutex_unlock(&p->known_lock);
+
+			logDebug(w->e, "testing offset %i again\n", p->offsets[p->committed]);
+
+			while ( !emu_list_attail(eli = emu_list_first(p->results[p->committed])) )
+			{
+				emu_stats_free(eli->data);
+				emu_list_remove(eli);
+				free(eli);
+			}
 
-	uint32_t best_eip=0;
-*/
+			emu_list_destroy(c->inserted);
+			emu_list_destroy(c->missed);
+			c->inserted = emu_list_create();
+			c->missed = emu_list_create();
+
+			shellcode_worker_test(w, p->committed);
+
+			pthread_mutex_lock(&p->known_lock);
+		}
+
+		for ( eli = emu_list_first(c->inserted); !emu_list_attail(eli); eli = emu_list_next(eli) )
+			emu_hashtable_insert(p->known_positions, (void *)(uintptr_t)eli->uint32, NULL);
+
+		emu_list_destroy(c->inserted);
+		emu_list_destroy(c->missed);
+		c->inserted = NULL;
+		c->missed = NULL;
+
+		p->committed++;
+	}
+
+	p->committing = false;
+	pthread_mutex_unlock(&p->known_lock);
+}
+
+static void shellcode_worker_run(struct shellcode_worker *w)
+{
+	struct shellcode_pass *p = w->pass;
+	uint32_t i;
+
+	while ( (i = __sync_fetch_and_add(&p->next, 1)) < p->count )
+	{
+		if ( emu_interrupted(w->e) != 0 )
+			break;
+
+		shellcode_worker_test(w, i);
+
+		if ( p->claims != NULL )
+			shellcode_pass_commit(w, i);
+	}
+}
+
+static void *shellcode_worker_thread(void *arg)
+{
+	struct shellcode_worker *w = arg;
+	struct shellcode_pass *p = w->pass;
+
+	shellcode_worker_run(w);
+
+	pthread_mutex_lock(&p->running_lock);
+	p->running--;
+	pthread_cond_signal(&p->running_cond);
+	pthread_mutex_unlock(&p->running_lock);
+
+	return NULL;
+}
+
+/**
+ * Test the offsets on the workers and append the results to the list.
+ * A single worker runs in the calling thread, otherwise the calling
+ * thread waits for the workers and cancels them once e got interrupted.
+ */
+static void shellcode_pass_run(struct emu *e, struct shellcode_pass *p,
+							   struct shellcode_worker *workers, uint32_t nworkers,
+							   struct emu_list_root *results)
+{
+	uint32_t i;
+
+	p->results = malloc(p->count * sizeof(struct emu_list_root *));
+	for ( i=0; i<p->count; i++ )
+		p->results[i] = emu_list_create();
+
+	p->next = 0;
+	p->running = 0;
+	p->claims = NULL;
+	p->committed = 0;
+	p->committing = false;
+
+	if ( nworkers > 1 )
+	{
+		p->claims = malloc(p->count * sizeof(struct shellcode_claims));
+		for ( i=0; i<p->count; i++ )
+		{
+			p->claims[i].inserted = emu_list_create();
+			p->claims[i].missed = emu_list_create();
+			p->claims[i].done = false;
+		}
+	}
+
+	for ( i=0; i<nworkers; i++ )
+	{
+		workers[i].pass = p;
+		workers[i].se.lock = nworkers > 1 ? &p->known_lock : NULL;
+	}
+
+	if ( nworkers == 1 )
+	{
+		shellcode_worker_run(&workers[0]);
+	}
+	else
+	{
+		uint32_t started = 0;
+		bool cancelled = false;
+
+		pthread_mutex_lock(&p->running_lock);
+		for ( i=0; i<nworkers; i++ )
+		{
+			if ( pthread_create(&workers[i].thread, NULL, shellcode_worker_thread, &workers[i]) != 0 )
+				break;
+
+			p->running++;
+			started++;
+		}
+
+		while ( p->running > 0 )
+		{
+			struct timespec ts;
+			clock_gettime(CLOCK_REALTIME, &ts);
+			ts.tv_nsec += 10 * 1000000;
+			if ( ts.tv_nsec >= 1000000000 )
+			{
+				ts.tv_sec++;
+				ts.tv_nsec -= 1000000000;
+			}
+
+			pthread_cond_timedwait(&p->running_cond, &p->running_lock, &ts);
+
+			if ( cancelled == false && emu_interrupted(e) != 0 )
+			{
+				for ( i=0; i<started; i++ )
+					emu_cancel(workers[i].e);
+
+				cancelled = true;
+			}
+		}
+		pthread_mutex_unlock(&p->running_lock);
+
+		for ( i=0; i<started; i++ )
+			pthread_join(workers[i].thread, NULL);
+
+		/* no thread could be started, test the offsets here */
+		if ( started == 0 )
+			shellcode_worker_run(&workers[0]);
+	}
+
+	for ( i=0; i<p->count; i++ )
+	{
+		emu_list_concat(results, p->results[i]);
+		emu_list_destroy(p->results[i]);
+	}
+
+	free(p->results);
+	p->results = NULL;
+
+	/* the ones not committed if e got interrupted */
+	if ( p->claims != NULL )
+	{
+		for ( i=p->committed; i<p->count; i++ )
+		{
+			emu_list_destroy(p->claims[i].inserted);
+			emu_list_destroy(p->claims[i].missed);
+		}
+
+		free(p->claims);
+		p->claims = NULL;
+	}
+}
+
+/**
+ * Look for GetPC candidates at the offsets from to to, the data may
+ * extend beyond to, emu_getpc_check looks at the bytes behind the
+ * candidate. The offsets found are appended to el.
+ * 
+ * @return 0 if the scan completed, -1 if the emu got interrupted
+ */
+static int32_t shellcode_getpc_scan(struct emu *e, uint8_t *data, uint32_t size, uint32_t from, uint32_t to, struct emu_list_root *el)
+{
 	uint32_t offset;
-	struct emu_list_root *el;
-	el = emu_list_create();
 
+	/* only a call or fnstenv can get the pc, look for their first byte
+	 * using memchr instead of trying every offset */
+	uint8_t *call = memchr(data + from, 0xe8, to - from);
+	uint8_t *fnstenv = memchr(data + from, 0xd9, to - from);
+	uint32_t candidates = 0;
 
-	for ( offset=0; offset<size ; offset++ )
+	while ( call != NULL || fnstenv != NULL )
 	{
+		uint8_t *p;
+
+		if ( fnstenv == NULL || (call != NULL && call < fnstenv) )
+		{
+			p = call;
+			call = memchr(p + 1, 0xe8, data + to - p - 1);
+		}
+		else
+		{
+			p = fnstenv;
+			fnstenv = memchr(p + 1, 0xd9, data + to - p - 1);
+		}
+
+		offset = p - data;
+
+		if ( (candidates++ % 64) == 0 && emu_interrupted(e) != 0 )
+			return -1;
+
 		if ( emu_getpc_check(e, (uint8_t *)data, size, offset) != 0 )
 		{
 			logDebug(e, "possible getpc at offset %i (%08x)\n", offset, offset);
@@ -491,6 +931,40 @@ int32_t emu_shellcode_test(struct emu *e, uint8_t *data, uint16_t size)
 		}
 	}
 
+	return 0;
+}
+
+/**
+ * What emu_shellcode_test_batch keeps from one buffer to the next, the
+ * static graph and the tracking state, the environment and the colors
+ * of the single worker.
+ */
+struct shellcode_batch
+{
+	struct emu_track_and_source *etas;
+	struct emu_env *env;
+	enum emu_color *colors;
+	uint32_t colors_size;
+};
+
+/**
+ * Test the GetPC candidates in el, the offset the shellcode is suspected
+ * at is returned as emu_shellcode_test does. The list is consumed.
+ * With a batch, the candidates are tested on e only, reusing what the
+ * batch kept from the last buffer. The result is filled if not NULL.
+ */
+static int32_t shellcode_test_candidates(struct emu *e, uint8_t *data, uint32_t size, struct emu_list_root *el, uint32_t threads,
+										 struct shellcode_batch *batch, struct emu_shellcode_result *result)
+{
+	uint32_t offset;
+
+	if ( result != NULL )
+	{
+		memset(result, 0, sizeof(struct emu_shellcode_result));
+		result->offset = -1;
+		result->candidates = emu_list_length(el);
+	}
+
 	if ( emu_list_length(el) == 0 )
 	{
 		emu_list_destroy(el);
@@ -501,6 +975,10 @@ int32_t emu_shellcode_test(struct emu *e, uint8_t *data, uint16_t size)
 		struct emu_cpu *cpu = emu_cpu_get(e);
 		struct emu_memory *mem = emu_memory_get(e);
 
+		/* the last buffer must not show behind this one */
+		if ( batch != NULL )
+			emu_memory_reset(mem);
+
 		/* write the code to the offset */
 		emu_memory_write_block(mem, STATIC_OFFSET, data, size);
 
@@ -516,7 +994,11 @@ int32_t emu_shellcode_test(struct emu *e, uint8_t *data, uint16_t size)
 		emu_cpu_eflags_set(cpu,0x0);
 	}
 
-	struct emu_track_and_source *etas = emu_track_and_source_new();
+	struct emu_track_and_source *etas;
+	if ( batch != NULL )
+		etas = batch->etas;
+	else
+		etas = emu_track_and_source_new();
 
 	logDebug(e, "creating static callgraph\n");
 	/* create the static analysis graph 
@@ -525,38 +1007,106 @@ int32_t emu_shellcode_test(struct emu *e, uint8_t *data, uint16_t size)
 	emu_source_instruction_graph_create(e, etas, STATIC_OFFSET, size);
 	emu_memory_mode_rw(emu_memory_get(e));
 
-	struct emu_hashtable *eh = emu_hashtable_new(size+4/4, emu_hashtable_ptr_hash, emu_hashtable_ptr_cmp);
-	struct emu_list_item *eli;
-//	struct emu_env_w32 *env = emu_env_w32_new(e);
-	
+	if ( etas->static_graph == NULL )
+	{
+		if ( batch == NULL )
+			emu_track_and_source_free(etas);
+		emu_list_destroy(el);
+		return -1;
+	}
 
-	struct emu_list_root *results = emu_list_create();
+	/* a single worker runs on e, more workers get an emu each, with the
+	 * cpu options of e, and borrow the static graph from etas */
+	uint32_t nworkers = threads;
+	if ( nworkers > emu_list_length(el) )
+		nworkers = emu_list_length(el);
+	if ( nworkers < 1 || batch != NULL )
+		nworkers = 1;
+
+	struct shellcode_worker *workers = malloc(nworkers * sizeof(struct shellcode_worker));
+	memset(workers, 0, nworkers * sizeof(struct shellcode_worker));
 
-	for ( eli = emu_list_first(el); !emu_list_attail(eli); eli = emu_list_next(eli) )
+	uint32_t i;
+	for ( i=0; i<nworkers; i++ )
 	{
-		logDebug(e, "testing offset %i %08x\n", eli->uint32, eli->uint32);
-		emu_shellcode_run_and_track(e, data, size, eli->uint32, 256, etas, eh,
-									results, false);
+		struct shellcode_worker *w = &workers[i];
+
+		if ( nworkers == 1 )
+		{
+			w->e = e;
+			w->etas = etas;
+		}
+		else
+		{
+			w->e = emu_new();
+			emu_cpu_get(w->e)->options = emu_cpu_get(e)->options;
+			w->etas = emu_track_and_source_new();
+			w->etas->static_graph = etas->static_graph;
+			w->se.claimed = calloc(size, sizeof(uint32_t));
+			w->se.claimed_size = size;
+		}
+
+		if ( batch != NULL )
+		{
+			if ( batch->colors_size < size )
+			{
+				free(batch->colors);
+				batch->colors = malloc(size * sizeof(enum emu_color));
+				batch->colors_size = size;
+			}
+
+			w->se.env = batch->env;
+			w->se.colors = batch->colors;
+		}
+		else
+			w->se.colors = malloc(size * sizeof(enum emu_color));
 	}
 
-	
+	struct emu_list_item *eli;
+
+	struct shellcode_pass pass;
+	memset(&pass, 0, sizeof(struct shellcode_pass));
+	pass.data = data;
+	pass.size = size;
+	pthread_mutex_init(&pass.known_lock, NULL);
+	pthread_mutex_init(&pass.running_lock, NULL);
+	pthread_cond_init(&pass.running_cond, NULL);
+
+	pass.count = emu_list_length(el);
+	pass.offsets = malloc(pass.count * sizeof(uint32_t));
+	for ( i=0, eli = emu_list_first(el); !emu_list_attail(eli); eli = emu_list_next(eli) )
+		pass.offsets[i++] = eli->uint32;
+
+	pass.known_positions = emu_hashtable_new(size+4/4, emu_hashtable_ptr_hash, emu_hashtable_ptr_cmp);
+	pass.brute_force = false;
+
+	struct emu_list_root *results = emu_list_create();
+
+	shellcode_pass_run(e, &pass, workers, nworkers, results);
+	free(pass.offsets);
 
 	/* for all positions we got, take the best, maybe take memory access into account later */
 	emu_list_qsort(results, tested_positions_cmp);
-	if ( ((struct emu_stats *)emu_list_first(results)->data)->cpu.steps != 256 )
+	if ( emu_list_length(results) != 0 && emu_interrupted(e) == 0 &&
+		 ((struct emu_stats *)emu_list_first(results)->data)->cpu.steps != 256 )
 	{
-		emu_hashtable_free(eh);
-		eh = emu_hashtable_new(size+4/4, emu_hashtable_ptr_hash, emu_hashtable_ptr_cmp);
+		emu_hashtable_free(pass.known_positions);
+		pass.known_positions = emu_hashtable_new(size+4/4, emu_hashtable_ptr_hash, emu_hashtable_ptr_cmp);
 		logDebug(e, "brute force!\n");
-		struct emu_list_root *new_results = emu_list_create();
-		for ( eli = emu_list_first(results); !emu_list_attail(eli); eli = emu_list_next(eli) )
+
+		pass.count = emu_list_length(results);
+		pass.offsets = malloc(pass.count * sizeof(uint32_t));
+		for ( i=0, eli = emu_list_first(results); !emu_list_attail(eli); eli = emu_list_next(eli) )
 		{
 			struct emu_stats *es = (struct emu_stats *)eli->data;
 			logDebug(e, "brute at offset 0x%08x \n",es->eip - STATIC_OFFSET);
-			emu_shellcode_run_and_track(e, data, size, es->eip - STATIC_OFFSET, 256, etas, eh,
-										new_results, true);
-			
+			pass.offsets[i++] = es->eip - STATIC_OFFSET;
 		}
+		pass.brute_force = true;
+
+		struct emu_list_root *new_results = emu_list_create();
+		shellcode_pass_run(e, &pass, workers, nworkers, new_results);
+		free(pass.offsets);
 
 		emu_list_concat(results, new_results);
 		emu_list_destroy(new_results);
@@ -578,10 +1128,41 @@ int32_t emu_shellcode_test(struct emu *e, uint8_t *data, uint16_t size)
 
 	
 
-	emu_hashtable_free(eh);
+	emu_hashtable_free(pass.known_positions);
+	pthread_mutex_destroy(&pass.known_lock);
+	pthread_mutex_destroy(&pass.running_lock);
+	pthread_cond_destroy(&pass.running_cond);
 	emu_list_destroy(el);
-//	emu_env_w32_free(env);
-	emu_track_and_source_free(etas);
+
+	for ( i=0; i<nworkers; i++ )
+	{
+		struct shellcode_worker *w = &workers[i];
+
+		free(w->se.bfs);
+		free(w->se.claimed);
+
+		if ( batch != NULL )
+		{
+			batch->env = w->se.env;
+			continue;
+		}
+
+		if ( w->se.env != NULL )
+			emu_env_free(w->se.env);
+		free(w->se.colors);
+
+		if ( w->e != e )
+		{
+			w->etas->static_graph = NULL;
+			emu_track_and_source_free(w->etas);
+			emu_free(w->e);
+		}
+	}
+	free(workers);
+
+	emu_memory_checkpoint_drop(emu_memory_get(e));
+	if ( batch == NULL )
+		emu_track_and_source_free(etas);
 
 
 	{
@@ -593,18 +1174,27 @@ int32_t emu_shellcode_test(struct emu *e, uint8_t *data, uint16_t size)
 		}
 	}
 
+	offset = -1;
 	eli = emu_list_first(results);
-	struct emu_stats *es = (struct emu_stats *)eli->data;
-
-	if ( es->cpu.steps > 100 )
-	{
-		offset = es->eip;
-	}
-	else
+	if ( !emu_list_attail(eli) )
 	{
-		offset = -1;
+		struct emu_stats *es = (struct emu_stats *)eli->data;
+
+		if ( es->cpu.steps > 100 )
+			offset = es->eip;
+
+		if ( result != NULL )
+		{
+			result->positions = emu_list_length(results);
+			result->steps = es->cpu.steps;
+			if ( es->cpu.steps > 100 )
+				result->offset = offset - STATIC_OFFSET;
+		}
 	}
 
+	/* the errno tells an interrupted run from an unsuccessful one */
+	emu_interrupted(e);
+
 	for (eli = emu_list_first(results); !emu_list_attail(eli); eli = emu_list_next(eli))
 	{
 		emu_stats_free((struct emu_stats *)eli->data);
@@ -614,6 +1204,366 @@ int32_t emu_shellcode_test(struct emu *e, uint8_t *data, uint16_t size)
 	return offset - STATIC_OFFSET;
 }
 
+int32_t emu_shellcode_test(struct emu *e, uint8_t *data, uint32_t size)
+{
+	return emu_shellcode_test_threads(e, data, size, 1);
+}
+
+int32_t emu_shellcode_test_threads(struct emu *e, uint8_t *data, uint32_t size, uint32_t threads)
+{
+	logPF(e);
+
+	struct emu_list_root *el = emu_list_create();
+
+	shellcode_getpc_scan(e, data, size, 0, size, el);
+
+	return shellcode_test_candidates(e, data, size, el, threads, NULL, NULL);
+}
+
+/**
+ * Test the buffer in windows, see emu_shellcode_test_windowed. With a
+ * batch, the windows are tested on e only, reusing what the batch kept.
+ * The result is filled if not NULL, the candidates and positions of all
+ * windows are summed up, the steps are the ones of the best position.
+ */
+static int32_t shellcode_test_windowed(struct emu *e, uint8_t *data, uint32_t size, uint32_t window, uint32_t threads,
+									   struct shellcode_batch *batch, struct emu_shellcode_result *result)
+{
+	if ( window < EMU_SHELLCODE_WINDOW_MIN )
+		window = EMU_SHELLCODE_WINDOW_MIN;
+
+	/* a window starts a quarter of its size in front of its first
+	 * candidate and takes the candidates of the half behind, so each
+	 * candidate gets a quarter of the window in front and behind it */
+	uint32_t before = window / 4;
+	uint32_t span = window / 2;
+
+	if ( result != NULL )
+	{
+		memset(result, 0, sizeof(struct emu_shellcode_result));
+		result->offset = -1;
+	}
+
+	int32_t offset = -1;
+	uint32_t steps = 0;
+	uint32_t pos = 0;
+
+	while ( pos < size )
+	{
+		uint32_t to = size - pos > span ? pos + span : size;
+		struct emu_list_root *el = emu_list_create();
+
+		/* find the first candidate behind pos */
+		if ( shellcode_getpc_scan(e, data, size, pos, to, el) != 0 )
+		{
+			emu_list_destroy(el);
+			break;
+		}
+
+		if ( emu_list_length(el) == 0 )
+		{
+			emu_list_destroy(el);
+			pos = to;
+			continue;
+		}
+
+		/* the window starts on a page of the buffer, the bytes behind the
+		 * data read as zero up to the end of the page as in a single test */
+		uint32_t first = emu_list_first(el)->uint32;
+		uint32_t start = first > before ? first - before : 0;
+		uint32_t end = size - start > window ? start + window : size;
+		start &= ~0xfff;
+
+		/* the candidates of the window, relative to its start */
+		to = size - first > span ? first + span : size;
+		if ( to > end )
+			to = end;
+
+		emu_list_destroy(el);
+		el = emu_list_create();
+		shellcode_getpc_scan(e, data + start, end - start, first - start, to - start, el);
+
+		logDebug(e, "window 0x%08x - 0x%08x, %i candidates\n", start, end, emu_list_length(el));
+
+		/* the last window must not show behind this one */
+		emu_memory_reset(emu_memory_get(e));
+
+		struct emu_shellcode_result wr;
+		shellcode_test_candidates(e, data + start, end - start, el, threads, batch, &wr);
+
+		if ( result != NULL )
+		{
+			result->candidates += wr.candidates;
+			result->positions += wr.positions;
+		}
+
+		/* take the best position as a single test would */
+		if ( wr.offset != -1 )
+		{
+			uint32_t at = start + wr.offset;
+
+			if ( offset == -1 || wr.steps > steps || (wr.steps == steps && at < (uint32_t)offset) )
+			{
+				offset = at;
+				steps = wr.steps;
+			}
+		}
+
+		if ( emu_interrupted(e) != 0 )
+			break;
+
+		pos = to;
+	}
+
+	if ( result != NULL )
+	{
+		result->offset = offset;
+		result->steps = steps;
+	}
+
+	return offset;
+}
+
+int32_t emu_shellcode_test_windowed(struct emu *e, uint8_t *data, uint32_t size, uint32_t window, uint32_t threads)
+{
+	logPF(e);
+
+	/* a single thread keeps the emu's state from one window to the next */
+	struct shellcode_batch batch;
+	memset(&batch, 0, sizeof(struct shellcode_batch));
+	if ( threads <= 1 )
+		batch.etas = emu_track_and_source_new();
+
+	int32_t offset = shellcode_test_windowed(e, data, size, window, threads, threads <= 1 ? &batch : NULL, NULL);
+
+	if ( batch.env != NULL )
+		emu_env_free(batch.env);
+	free(batch.colors);
+	if ( batch.etas != NULL )
+		emu_track_and_source_free(batch.etas);
+
+	/* the errno tells an interrupted run from an unsuccessful one */
+	emu_interrupted(e);
+
+	return offset;
+}
+
+int32_t emu_shellcode_test_triaged(struct emu *e, uint8_t *data, uint32_t size, uint32_t threshold, struct emu_triage *triage)
+{
+	struct emu_triage t;
+
+	/* no candidates, nothing the test or the triage could change */
+	if ( triage == NULL )
+	{
+		if ( emu_triage_getpc(data, size) == 0 )
+			return -1;
+
+		triage = &t;
+	}
+
+	if ( emu_triage(data, size, triage) < threshold )
+	{
+		logDebug(e, "triage score %i, not tested\n", triage->score);
+		return -1;
+	}
+
+	return emu_shellcode_test(e, data, size);
+}
+
+int32_t emu_shellcode_test_batch(struct emu *e, uint8_t **bufs, uint32_t *lens, uint32_t n, struct emu_shellcode_result *results)
+{
+	logPF(e);
+
+	struct shellcode_batch batch;
+	memset(&batch, 0, sizeof(struct shellcode_batch));
+	batch.etas = emu_track_and_source_new();
+
+	uint32_t i;
+	for ( i=0; i<n; i++ )
+	{
+		/* large buffers are tested in windows, as emu_shellcode_test does */
+		if ( lens[i] > EMU_SHELLCODE_WINDOW )
+		{
+			shellcode_test_windowed(e, bufs[i], lens[i], EMU_SHELLCODE_WINDOW, 1, &batch, &results[i]);
+
+			if ( emu_interrupted(e) != 0 )
+				break;
+
+			continue;
+		}
+
+		struct emu_list_root *el = emu_list_create();
+
+		if ( shellcode_getpc_scan(e, bufs[i], lens[i], 0, lens[i], el) != 0 )
+		{
+			emu_list_destroy(el);
+			break;
+		}
+
+		shellcode_test_candidates(e, bufs[i], lens[i], el, 1, &batch, &results[i]);
+
+		if ( emu_interrupted(e) != 0 )
+			break;
+	}
+
+	if ( batch.env != NULL )
+		emu_env_free(batch.env);
+	free(batch.colors);
+	emu_track_and_source_free(batch.etas);
+
+	return i;
+}
+
+/* the bytes behind a candidate emu_getpc_check looks at */
+#define GETPC_CONTEXT 64
+
+struct emu_shellcode_stream
+{
+	struct emu *e;
+	uint32_t window;
+
+	/* the bytes kept, data[0] is at offset base of the stream */
+	uint8_t *data;
+	uint32_t size;
+	uint32_t base;
+
+	/* the candidates in front of decided got enough bytes behind them,
+	 * the GetPC ones are in candidates, as offsets of the stream */
+	uint32_t decided;
+	struct emu_list_root *candidates;
+
+	int32_t offset;
+};
+
+struct emu_shellcode_stream *emu_shellcode_stream_new(struct emu *e, uint32_t window)
+{
+	struct emu_shellcode_stream *s = malloc(sizeof(struct emu_shellcode_stream));
+	if ( s == NULL )
+		return NULL;
+
+	memset(s, 0, sizeof(struct emu_shellcode_stream));
+	s->e = e;
+	s->window = window > EMU_SHELLCODE_STREAM_WINDOW_MAX ? EMU_SHELLCODE_STREAM_WINDOW_MAX : window;
+	s->candidates = emu_list_create();
+	s->offset = -1;
+	return s;
+}
+
+static int32_t shellcode_stream_feed(struct emu_shellcode_stream *s, uint8_t *data, uint32_t size)
+{
+	struct emu *e = s->e;
+	struct emu_list_item *eli;
+
+	uint8_t *d = realloc(s->data, s->size + size);
+	if ( d == NULL )
+	{
+		emu_error_set(e, ENOMEM, "out of memory\n", 0);
+		return -1;
+	}
+
+	memcpy(d + s->size, data, size);
+	s->data = d;
+	s->size += size;
+
+	/* decide the candidates which got enough bytes behind them now */
+	uint32_t from = s->decided - s->base;
+	uint32_t to = s->size > GETPC_CONTEXT ? s->size - GETPC_CONTEXT : 0;
+
+	if ( to > from )
+	{
+		struct emu_list_root *el = emu_list_create();
+		shellcode_getpc_scan(e, s->data, s->size, from, to, el);
+
+		for ( eli = emu_list_first(el); !emu_list_attail(eli); eli = emu_list_next(eli) )
+			eli->uint32 += s->base;
+
+		emu_list_concat(s->candidates, el);
+		emu_list_destroy(el);
+
+		s->decided = s->base + to;
+		from = to;
+	}
+
+	/* test the decided candidates and the ones at the end, which may turn
+	 * out differently once more bytes are there */
+	struct emu_list_root *el = emu_list_create();
+	for ( eli = emu_list_first(s->candidates); !emu_list_attail(eli); eli = emu_list_next(eli) )
+	{
+		struct emu_list_item *c = emu_list_item_create();
+		c->uint32 = eli->uint32 - s->base;
+		emu_list_insert_last(el, c);
+	}
+	shellcode_getpc_scan(e, s->data, s->size, from, s->size, el);
+
+	int32_t ret = shellcode_test_candidates(e, s->data, s->size, el, 1, NULL, NULL);
+	if ( ret >= 0 )
+	{
+		ret += s->base;
+		if ( s->offset < 0 )
+			s->offset = ret;
+	}
+
+	/* keep the last window bytes for the next feed */
+	if ( s->size > s->window )
+	{
+		uint32_t drop = s->size - s->window;
+
+		memmove(s->data, s->data + drop, s->window);
+		s->size = s->window;
+		s->base += drop;
+
+		if ( s->decided < s->base )
+			s->decided = s->base;
+
+		while ( !emu_list_attail(eli = emu_list_first(s->candidates)) && eli->uint32 < s->base )
+		{
+			emu_list_remove(eli);
+			free(eli);
+		}
+	}
+
+	return ret;
+}
+
+int32_t emu_shellcode_stream_feed(struct emu_shellcode_stream *s, uint8_t *data, uint32_t size)
+{
+	logPF(s->e);
+
+	/* the bytes kept and the new ones are tested at once, a window of
+	 * emu_shellcode_test_windowed at most */
+	uint32_t chunk = EMU_SHELLCODE_WINDOW - s->window;
+	int32_t ret = -1;
+
+	while ( size > 0 )
+	{
+		uint32_t len = size > chunk ? chunk : size;
+		int32_t r = shellcode_stream_feed(s, data, len);
+
+		if ( ret < 0 )
+			ret = r;
+
+		data += len;
+		size -= len;
+
+		if ( emu_interrupted(s->e) != 0 )
+			break;
+	}
+
+	return ret;
+}
+
+int32_t emu_shellcode_stream_finish(struct emu_shellcode_stream *s)
+{
+	int32_t offset = s->offset;
+
+	emu_list_destroy(s->candidates);
+
+	free(s->data);
+	free(s);
+
+	return offset;
+}
+
 struct emu_stats *emu_stats_new(void)
 {
 	struct emu_stats *es = malloc(sizeof(struct emu_stats));
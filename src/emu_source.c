@@ -26,163 +26,193 @@
  *******************************************************************************/
 
 
+#include <stdlib.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include "emu/emu.h"
 #include "emu/emu_cpu.h"
 #include "emu/emu_cpu_data.h"
+#include "emu/emu_cpu_decode.h"
+#include "emu/emu_memory.h"
 #include "emu/emu_instruction.h"
 #include "emu/emu_track.h"
 #include "emu/emu_source.h"
-#include "emu/emu_hashtable.h"
-#include "emu/emu_graph.h"
-#include "emu/emu_queue.h"
+
+static void graph_strings_free(struct emu_source_graph *g)
+{
+	uint32_t i;
+	for ( i=0; i<g->size; i++ )
+	{
+		if ( g->decoded[i] != 0 && g->instr[i].instrstring != NULL )
+			free(g->instr[i].instrstring);
+	}
+}
 
 uint32_t emu_source_instruction_graph_create(struct emu *e, struct emu_track_and_source *es, uint32_t datastart, uint32_t datasize)
 {
 //	printf("tracking from %x to %x\n", datastart, datastart+datasize);
 	struct emu_cpu *c = emu_cpu_get(e);
+	struct emu_memory *mem = emu_memory_get(e);
 
-	es->static_instr_graph = emu_graph_new();
-	es->static_instr_table = emu_hashtable_new(datasize/2, emu_hashtable_ptr_hash,  emu_hashtable_ptr_cmp);
-	es->static_instr_graph->vertex_destructor = emu_source_and_track_instr_info_free_void;
+	/* every instruction has two successors at most, the rows are sized
+	 * for that, the arrays are ordered by their alignment */
+	size_t size = sizeof(struct emu_source_graph)
+				  + datasize * sizeof(struct emu_source_and_track_instr_info)
+				  + (datasize + 1) * 2 * sizeof(uint32_t)
+				  + datasize * 2 * 2 * sizeof(uint32_t)
+				  + datasize;
 
-	uint32_t i;
-	for (i=datastart;i<datastart+datasize;i++)
-	{
-		emu_cpu_eip_set(c, i);
+	/* reuse the graph of the last call if the arrays fit */
+	struct emu_source_graph *g = es->static_graph;
+	uint32_t capacity = datasize;
 
-		if ( emu_cpu_parse(c) != 0)
-		{
-//			printf("parse error %s\n", emu_strerror(e));
-			continue;
-		}
+	if( g != NULL )
+	{
+		graph_strings_free(g);
 
-		if ( emu_cpu_step(c) != 0)
+		if( g->capacity >= datasize )
+			capacity = g->capacity;
+		else
 		{
-//			printf("step error %s\n", emu_strerror(e));
-//			continue;
+			free(g);
+			g = NULL;
 		}
-
-        struct emu_source_and_track_instr_info *etii = emu_source_and_track_instr_info_new(c,i);
-		struct emu_vertex *ev = emu_vertex_new();
-		ev->data = etii;
-		emu_hashtable_insert(es->static_instr_table, (void *)(uintptr_t)i, ev);
-		emu_graph_vertex_add(es->static_instr_graph, ev);
 	}
 
-	struct emu_vertex *ev;
-	for ( ev = emu_vertexes_first(es->static_instr_graph->vertexes); !emu_vertexes_attail(ev); ev = emu_vertexes_next(ev) )
-	{
-		struct emu_source_and_track_instr_info *etii = (struct emu_source_and_track_instr_info *)ev->data;
+	es->static_graph = NULL;
 
-		struct emu_hashtable_item *ehi = emu_hashtable_search(es->static_instr_table, (void *)(uintptr_t)etii->source.norm_pos);
-//		printf("NORM from %08x to %08x\n",((struct emu_source_and_track_instr_info *)ev->data)->eip, etii->source.norm_pos);
-		if (ehi != NULL)
-		{
-			struct emu_vertex *to = (struct emu_vertex *)ehi->value;
-			emu_vertex_edge_add(ev, to);
-			
-		}else
-		{
-//			printf("NORM IS UNKNOWN %08x\n", etii->source.norm_pos);
-		}
+	if( g == NULL )
+		g = malloc(size);
 
-		if (etii->source.has_cond_pos == 1)
-		{
-//			printf("COND from %08x to %08x\n",((struct emu_source_and_track_instr_info *)ev->data)->eip, etii->source.cond_pos);
-			ehi = emu_hashtable_search(es->static_instr_table, (void *)(uintptr_t)etii->source.cond_pos);
-			if (ehi != NULL)
-			{
-				struct emu_vertex *to = (struct emu_vertex *)ehi->value;
-				emu_vertex_edge_add(ev, to);
-				
-			}else
-			{
-//				printf("COND IS UNKNOWN\n");
-			}
-		}
-	}
-	return 0;
-}
+	if( g == NULL )
+		return -1;
 
+	memset(g, 0, sizeof(struct emu_source_graph));
+	g->capacity = capacity;
+	g->start = datastart;
+	g->size = datasize;
+	g->instr = (struct emu_source_and_track_instr_info *)(g + 1);
+	g->succ_index = (uint32_t *)(g->instr + datasize);
+	g->pred_index = g->succ_index + datasize + 1;
+	g->succ = g->pred_index + datasize + 1;
+	g->pred = g->succ + datasize * 2;
+	g->decoded = (uint8_t *)(g->pred + datasize * 2);
+	memset(g->decoded, 0, datasize);
+	memset(g->pred_index, 0, (datasize + 1) * sizeof(uint32_t));
 
+	/* read the code once, instructions at the end may reach behind it */
+	uint32_t len = datasize + 32;
+	uint8_t *code = calloc(len + 16, 1); /* padded for the instr_info bytes */
 
-void emu_source_backward_bfs(struct emu_track_and_source *et, struct emu_vertex *ev)
-{
-	struct emu_vertex *it;
-	for ( it = emu_vertexes_first(et->static_instr_graph->vertexes); !emu_vertexes_attail(it); it = emu_vertexes_next(it) )
-		it->color = white;
-    
-	it = ev;
+	if( code == NULL )
+	{
+		free(g);
+		return -1;
+	}
 
-	struct emu_queue *eq = emu_queue_new();
+	if( emu_memory_read_block(mem, datastart, code, len) != 0 )
+	{
+		for( len = 0; len < datasize + 32; len++ )
+			if( emu_memory_read_byte(mem, datastart + len, &code[len]) != 0 )
+				break;
+	}
 
-	emu_queue_enqueue(eq, ev);
+	bool debug = CPU_DEBUG_FLAG_ISSET(c, instruction_string );
 
-	while (emu_queue_empty(eq) == false)
+	uint32_t i;
+	for (i=0;i<datasize && i<len;i++)
 	{
-		ev = (struct emu_vertex *)emu_queue_dequeue(eq);
+		struct emu_decoded d;
 
-		struct emu_edge *ee;
-		for ( ee = emu_edges_first(ev->backedges); !emu_edges_attail(ee); ee = emu_edges_next(ee) )
+		if ( emu_cpu_decode(code + i, len - i, datastart + i, &d) <= 0 )
 		{
-			if (ee->destination->color != white)
-				continue;
-
-			ee->destination->color = grey;
-			emu_queue_enqueue(eq, ee->destination);
-			
+//			printf("parse error at %x\n", datastart + i);
+			continue;
 		}
 
-		if ( emu_edges_length(ev->backedges) == 0 )
-			ev->color = green;
-		else
-			ev->color = black;
-
+		emu_source_and_track_instr_info_init_decoded(&g->instr[i], &d, debug ? code + i : NULL);
+		g->decoded[i] = 1;
 	}
 
-	emu_queue_free(eq);
+	free(code);
 
-	it->color = red;
-}
+	/* the successors, counting the predecessors of each offset */
+	uint32_t n = 0;
+	for ( i=0; i<datasize; i++ )
+	{
+		g->succ_index[i] = n;
 
-void emu_source_forward_bfs(struct emu_track_and_source *et, struct emu_vertex *ev)
-{
-	struct emu_vertex *it;
-	for ( it = emu_vertexes_first(et->static_instr_graph->vertexes); !emu_vertexes_attail(it); it = emu_vertexes_next(it) )
-		it->color = white;
+		if ( g->decoded[i] == 0 )
+			continue;
 
-	it = ev;
+		struct emu_source_and_track_instr_info *etii = &g->instr[i];
+		uint32_t to = etii->source.norm_pos - datastart;
 
-	struct emu_queue *eq = emu_queue_new();
+//		printf("NORM from %08x to %08x\n", etii->eip, etii->source.norm_pos);
+		if ( to < datasize && g->decoded[to] != 0 )
+		{
+			g->succ[n++] = to;
+			g->pred_index[to]++;
+		}
 
-	emu_queue_enqueue(eq, ev);
+		if ( etii->source.has_cond_pos == 1 )
+		{
+//			printf("COND from %08x to %08x\n", etii->eip, etii->source.cond_pos);
+			uint32_t cond = etii->source.cond_pos - datastart;
+			if ( cond < datasize && g->decoded[cond] != 0 && !(n > g->succ_index[i] && g->succ[n-1] == cond) )
+			{
+				g->succ[n++] = cond;
+				g->pred_index[cond]++;
+			}
+		}
+	}
+	g->succ_index[datasize] = n;
 
-	while (emu_queue_empty(eq) == false)
+	/* the predecessors, filled in ascending order of their offset */
+	uint32_t sum = 0;
+	for ( i=0; i<=datasize; i++ )
 	{
-		ev = (struct emu_vertex *)emu_queue_dequeue(eq);
+		uint32_t count = g->pred_index[i];
+		g->pred_index[i] = sum;
+		sum += count;
+	}
 
-		struct emu_edge *ee;
-		for ( ee = emu_edges_first(ev->edges); !emu_edges_attail(ee); ee = emu_edges_next(ee) )
+	uint32_t *fill = calloc(datasize + 1, sizeof(uint32_t));
+	if( fill == NULL )
+	{
+		free(g);
+		return -1;
+	}
+
+	for ( i=0; i<datasize; i++ )
+	{
+		uint32_t j;
+		for ( j=g->succ_index[i]; j<g->succ_index[i+1]; j++ )
 		{
-			if (ee->destination->color != white)
-				continue;
+			uint32_t to = g->succ[j];
+			g->pred[g->pred_index[to] + fill[to]++] = i;
+		}
+	}
 
-			ee->destination->color = grey;
-			emu_queue_enqueue(eq, ee->destination);
+	free(fill);
 
-		}
+	es->static_graph = g;
+	return 0;
+}
 
-		if ( emu_edges_length(ev->edges) == 0 )
-			ev->color = yellow;
-		else
-			ev->color = black;
+void emu_source_graph_free(struct emu_source_graph *g)
+{
+	graph_strings_free(g);
+	free(g);
+}
 
-	}
+struct emu_source_and_track_instr_info *emu_source_graph_instr(struct emu_source_graph *g, uint32_t eip)
+{
+	uint32_t i = eip - g->start;
 
-	emu_queue_free(eq);
+	if ( i >= g->size || g->decoded[i] == 0 )
+		return NULL;
 
-	it->color = red;
+	return &g->instr[i];
 }
-
@@ -0,0 +1,449 @@
+/********************************************************************************
+ *                               libemu
+ *
+ *                    - x86 shellcode emulation -
+ *
+ *
+ * Copyright (C) 2007  Paul Baecher & Markus Koetter
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *
+ *             contact nepenthesdev@users.sourceforge.net
+ *
+ *******************************************************************************/
+
+/*
+ * execution trace
+ *
+ * record layout, all integers are LEB128 varints:
+ *
+ *   tag                  type in bits 0-1, TRACE_F_* in bits 2-5
+ *   start delta          TRACE_F_START: eip - next eip of the last record, zigzag
+ *   next delta           next eip - eip, zigzag
+ *   register mask        TRACE_F_REGS: bit 0-7 the registers, bit 8 eflags
+ *   register values      TRACE_F_REGS: new value ^ old value, for every bit in the mask
+ *   code                 TRACE_F_CODE: length byte, bytes
+ *   name                 EMU_TRACE_HOOK: length, bytes, '\0'
+ *
+ * The instruction bytes go through a direct mapped cache both the writer
+ * and the reader keep, the bytes are written only if the cache entry for
+ * the eip holds something else, so self modifying code is traced right.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "emu/emu.h"
+#include "emu/emu_cpu.h"
+#include "emu/emu_cpu_data.h"
+#include "emu/emu_memory.h"
+#include "emu/emu_trace.h"
+
+#define TRACE_MAGIC "EMUTRACE"
+#define TRACE_VERSION 1
+
+#define TRACE_TYPE_MASK	0x03
+#define TRACE_F_START	(1 << 2)
+#define TRACE_F_REGS	(1 << 3)
+#define TRACE_F_CODE	(1 << 4)
+#define TRACE_F_ERROR	(1 << 5)
+
+#define TRACE_CODE_CACHE 1024
+#define TRACE_CODE_MAX 16
+
+struct trace_code
+{
+	uint32_t eip;
+	uint32_t len;
+	uint8_t data[TRACE_CODE_MAX];
+};
+
+struct trace_state
+{
+	uint32_t eip;
+	uint32_t reg[8];
+	uint32_t eflags;
+	struct trace_code code[TRACE_CODE_CACHE];
+};
+
+struct emu_trace
+{
+	FILE *f;
+	struct trace_state state;
+
+	/* the instruction parsed last */
+	uint32_t parsed_eip;
+	uint32_t parsed_len;
+	uint8_t parsed_data[TRACE_CODE_MAX];
+};
+
+struct emu_trace_reader
+{
+	const uint8_t *data;
+	size_t len;
+	size_t pos;
+
+	void *map;
+	size_t maplen;
+
+	struct trace_state state;
+};
+
+static inline struct trace_code *trace_code_entry(struct trace_state *s, uint32_t eip)
+{
+	return &s->code[(eip ^ (eip >> 10)) & (TRACE_CODE_CACHE - 1)];
+}
+
+static inline uint32_t zigzag(int32_t v)
+{
+	return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static inline int32_t unzigzag(uint32_t v)
+{
+	return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+static inline uint8_t *varint_put(uint8_t *p, uint32_t v)
+{
+	while( v >= 0x80 )
+	{
+		*p++ = (v & 0x7f) | 0x80;
+		v >>= 7;
+	}
+	*p++ = v;
+	return p;
+}
+
+static inline int varint_get(struct emu_trace_reader *r, uint32_t *v)
+{
+	uint32_t shift = 0;
+
+	*v = 0;
+	while( r->pos < r->len && shift < 35 )
+	{
+		uint8_t b = r->data[r->pos++];
+		*v |= (uint32_t)(b & 0x7f) << shift;
+		if( (b & 0x80) == 0 )
+			return 0;
+		shift += 7;
+	}
+
+	return -1;
+}
+
+struct emu_trace *emu_trace_new(FILE *f)
+{
+	struct emu_trace *t = malloc(sizeof(struct emu_trace));
+	if( t == NULL )
+		return NULL;
+
+	memset(t, 0, sizeof(struct emu_trace));
+	t->f = f;
+
+	uint8_t header[sizeof(TRACE_MAGIC)];
+	memcpy(header, TRACE_MAGIC, sizeof(TRACE_MAGIC) - 1);
+	header[sizeof(TRACE_MAGIC) - 1] = TRACE_VERSION;
+	fwrite(header, sizeof(header), 1, f);
+
+	return t;
+}
+
+void emu_trace_free(struct emu_trace *t)
+{
+	fflush(t->f);
+	free(t);
+}
+
+static void trace_write(struct emu_trace *t, struct emu_cpu *c, enum emu_trace_type type, uint32_t flags, uint32_t eip, const char *name)
+{
+	struct trace_state *s = &t->state;
+	uint8_t buf[1 + 5 + 5 + 3 + 9 * 5 + 1 + TRACE_CODE_MAX];
+	uint8_t *p = buf + 1;
+	uint32_t mask = 0;
+	int i;
+
+	for( i = 0; i < 8; i++ )
+		if( c->reg[i] != s->reg[i] )
+			mask |= 1 << i;
+
+	if( c->eflags != s->eflags )
+		mask |= 1 << 8;
+
+	if( eip != s->eip )
+	{
+		flags |= TRACE_F_START;
+		p = varint_put(p, zigzag(eip - s->eip));
+	}
+
+	p = varint_put(p, zigzag(c->eip - eip));
+
+	if( mask != 0 )
+	{
+		flags |= TRACE_F_REGS;
+		p = varint_put(p, mask);
+
+		for( i = 0; i < 8; i++ )
+			if( mask & (1 << i) )
+			{
+				p = varint_put(p, c->reg[i] ^ s->reg[i]);
+				s->reg[i] = c->reg[i];
+			}
+
+		if( mask & (1 << 8) )
+		{
+			p = varint_put(p, c->eflags ^ s->eflags);
+			s->eflags = c->eflags;
+		}
+	}
+
+	if( type == EMU_TRACE_STEP )
+	{
+		struct trace_code *tc = trace_code_entry(s, eip);
+
+		if( t->parsed_len == 0 || tc->eip != eip || tc->len != t->parsed_len || memcmp(tc->data, t->parsed_data, t->parsed_len) != 0 )
+		{
+			flags |= TRACE_F_CODE;
+			tc->eip = eip;
+			tc->len = t->parsed_len;
+			memcpy(tc->data, t->parsed_data, TRACE_CODE_MAX);
+
+			*p++ = tc->len;
+			memcpy(p, tc->data, tc->len);
+			p += tc->len;
+		}
+	}
+
+	buf[0] = type | flags;
+	s->eip = c->eip;
+
+	fwrite(buf, p - buf, 1, t->f);
+
+	if( name != NULL )
+	{
+		uint32_t len = strlen(name);
+
+		fwrite(buf, varint_put(buf, len) - buf, 1, t->f);
+		fwrite(name, len + 1, 1, t->f);
+	}
+}
+
+void emu_cpu_trace_set(struct emu_cpu *c, struct emu_trace *t)
+{
+	c->trace = t;
+
+	if( t != NULL )
+		emu_trace_state(t, c);
+}
+
+void emu_trace_state(struct emu_trace *t, struct emu_cpu *c)
+{
+	trace_write(t, c, EMU_TRACE_STATE, 0, t->state.eip, NULL);
+}
+
+void emu_cpu_trace_hook(struct emu_cpu *c, uint32_t eip, const char *name)
+{
+	if( c->trace != NULL )
+		trace_write(c->trace, c, EMU_TRACE_HOOK, 0, eip, name);
+}
+
+void emu_trace_parse(struct emu_trace *t, struct emu_cpu *c, uint32_t eip, int32_t ret)
+{
+	if( ret != 0 )
+	{
+		trace_write(t, c, EMU_TRACE_FAULT, 0, eip, NULL);
+		return;
+	}
+
+	t->parsed_eip = eip;
+	t->parsed_len = c->eip - eip;
+	if( t->parsed_len > TRACE_CODE_MAX )
+		t->parsed_len = TRACE_CODE_MAX;
+
+	memset(t->parsed_data, 0, TRACE_CODE_MAX);
+	if( emu_memory_read_block(c->mem, eip, t->parsed_data, t->parsed_len) != 0 )
+		t->parsed_len = 0;
+}
+
+void emu_trace_step(struct emu_trace *t, struct emu_cpu *c, int32_t ret)
+{
+	trace_write(t, c, EMU_TRACE_STEP, ret != 0 ? TRACE_F_ERROR : 0, t->parsed_eip, NULL);
+}
+
+struct emu_trace_reader *emu_trace_reader_new(const uint8_t *data, size_t len)
+{
+	if( len < sizeof(TRACE_MAGIC) || memcmp(data, TRACE_MAGIC, sizeof(TRACE_MAGIC) - 1) != 0 ||
+		data[sizeof(TRACE_MAGIC) - 1] != TRACE_VERSION )
+		return NULL;
+
+	struct emu_trace_reader *r = malloc(sizeof(struct emu_trace_reader));
+	if( r == NULL )
+		return NULL;
+
+	memset(r, 0, sizeof(struct emu_trace_reader));
+	r->data = data;
+	r->len = len;
+	r->pos = sizeof(TRACE_MAGIC);
+
+	return r;
+}
+
+struct emu_trace_reader *emu_trace_reader_open(const char *path)
+{
+	struct emu_trace_reader *r;
+	struct stat st;
+	void *map;
+	int fd;
+
+	if( (fd = open(path, O_RDONLY)) == -1 )
+		return NULL;
+
+	if( fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(TRACE_MAGIC) )
+	{
+		close(fd);
+		errno = EINVAL;
+		return NULL;
+	}
+
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if( map == MAP_FAILED )
+		return NULL;
+
+	if( (r = emu_trace_reader_new(map, st.st_size)) == NULL )
+	{
+		munmap(map, st.st_size);
+		errno = EINVAL;
+		return NULL;
+	}
+
+	r->map = map;
+	r->maplen = st.st_size;
+	return r;
+}
+
+void emu_trace_reader_free(struct emu_trace_reader *r)
+{
+	if( r->map != NULL )
+		munmap(r->map, r->maplen);
+
+	free(r);
+}
+
+int emu_trace_reader_next(struct emu_trace_reader *r, struct emu_trace_record *rec)
+{
+	struct trace_state *s = &r->state;
+	uint32_t v, mask = 0;
+	uint8_t tag;
+	int i;
+
+	if( r->pos == r->len )
+		return 0;
+
+	memset(rec, 0, sizeof(struct emu_trace_record));
+
+	tag = r->data[r->pos++];
+	rec->type = tag & TRACE_TYPE_MASK;
+	rec->error = (tag & TRACE_F_ERROR) != 0;
+
+	rec->eip = s->eip;
+	if( tag & TRACE_F_START )
+	{
+		if( varint_get(r, &v) != 0 )
+			return -1;
+		rec->eip += unzigzag(v);
+	}
+
+	if( varint_get(r, &v) != 0 )
+		return -1;
+	s->eip = rec->eip + unzigzag(v);
+
+	if( tag & TRACE_F_REGS )
+	{
+		if( varint_get(r, &mask) != 0 )
+			return -1;
+
+		for( i = 0; i < 8; i++ )
+			if( mask & (1 << i) )
+			{
+				if( varint_get(r, &v) != 0 )
+					return -1;
+				s->reg[i] ^= v;
+			}
+
+		if( mask & (1 << 8) )
+		{
+			if( varint_get(r, &v) != 0 )
+				return -1;
+			s->eflags ^= v;
+		}
+	}
+
+	if( rec->type == EMU_TRACE_STEP )
+	{
+		struct trace_code *tc = trace_code_entry(s, rec->eip);
+
+		if( tag & TRACE_F_CODE )
+		{
+			if( r->pos == r->len || r->data[r->pos] > TRACE_CODE_MAX || r->len - r->pos - 1 < r->data[r->pos] )
+				return -1;
+
+			tc->eip = rec->eip;
+			tc->len = r->data[r->pos++];
+			memset(tc->data, 0, TRACE_CODE_MAX);
+			memcpy(tc->data, r->data + r->pos, tc->len);
+			r->pos += tc->len;
+		}
+		else
+		if( tc->eip != rec->eip || tc->len == 0 )
+			return -1;
+
+		rec->code = tc->data;
+		rec->code_len = tc->len;
+	}
+
+	if( rec->type == EMU_TRACE_HOOK )
+	{
+		if( varint_get(r, &v) != 0 || r->len - r->pos < (size_t)v + 1 || r->data[r->pos + v] != '\0' )
+			return -1;
+
+		rec->name = (const char *)r->data + r->pos;
+		r->pos += v + 1;
+	}
+
+	rec->next_eip = s->eip;
+	memcpy(rec->reg, s->reg, sizeof(rec->reg));
+	rec->eflags = s->eflags;
+
+	return 1;
+}
+
+uint32_t emu_trace_record_string(const struct emu_trace_record *rec, char *str)
+{
+	uint8_t data[32];
+
+	memset(data, 0, sizeof(data));
+	memcpy(data, rec->code, rec->code_len);
+
+	memset(str, 0, EMU_TRACE_STRING_SIZE);
+	return dasm_print_instruction(rec->eip, data, 0, str);
+}
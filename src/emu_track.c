@@ -31,6 +31,7 @@
 #include "emu/emu.h"
 #include "emu/emu_cpu.h"
 #include "emu/emu_cpu_data.h"
+#include "emu/emu_cpu_decode.h"
 #include "emu/emu_instruction.h"
 #include "emu/emu_track.h"
 #include "emu/emu_source.h"
@@ -41,17 +42,14 @@ struct emu_track_and_source *emu_track_and_source_new(void)
 {
 	struct emu_track_and_source *et = (struct emu_track_and_source *)malloc(sizeof(struct emu_track_and_source));
 	memset(et, 0, sizeof(struct emu_track_and_source));
-	et->track.reg[esp] = 0xffffffff;
+	et->track.reg[esp] = TRACK_REG32;
 	return et;
 }
 
 void emu_track_and_source_free(struct emu_track_and_source *et)
 {
-	if (et->static_instr_table != NULL)
-		emu_hashtable_free(et->static_instr_table);
-
-	if (et->static_instr_graph != NULL)
-		emu_graph_free(et->static_instr_graph);
+	if (et->static_graph != NULL)
+		emu_source_graph_free(et->static_graph);
 
 	if (et->run_instr_table != NULL)
 		emu_hashtable_free(et->run_instr_table);
@@ -69,10 +67,31 @@ void debug_instruction(struct emu_instruction *i);
 
 #include "emu/emu_cpu_functions.h"
 
+/* the top bit of each register byte, all of them and all but esp's,
+ * esp is not tracked */
+static const union
+{
+	uint8_t reg[8];
+	uint64_t regs;
+} regs_guard = { .reg = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 } },
+  regs_guard_no_esp = { .reg = { [eax] = 0x80, [ecx] = 0x80, [edx] = 0x80, [ebx] = 0x80,
+								 [ebp] = 0x80, [esi] = 0x80, [edi] = 0x80 } };
+
+/**
+ * Check if the byte of each register but esp is at least as high in a
+ * as in b, read as numbers, like the 32 bit masks were compared.
+ * All bytes are subtracted at once, a byte keeps its guard bit if it
+ * did not borrow, the bytes are 0x0f at most, so the guard bits stop
+ * the borrows from reaching the next byte.
+ */
+static inline bool regs_cover(uint64_t a, uint64_t b)
+{
+	return (((a | regs_guard.regs) - b) & regs_guard_no_esp.regs) == regs_guard_no_esp.regs;
+}
+
 int32_t emu_track_instruction_check(struct emu *e, struct emu_track_and_source *et)
 {
 	struct emu_cpu *c = emu_cpu_get(e);
-	int i;
 
 	if (c->instr.is_fpu)
 	{
@@ -92,29 +111,13 @@ int32_t emu_track_instruction_check(struct emu *e, struct emu_track_and_source *
 			et->reg[c->instr.cpu.opc & 7] = reg1;
 		}
 */
-		for (i=0;i<8;i++)
-		{
-			if (i == esp)
-				continue;
-
-//			printf("0x%08x 0x%08x\n", c->instr.track.need.reg[i], et->track.reg[i]);
-			if (c->instr.track.need.reg[i] > et->track.reg[i])
-				return -1;
-		}
-
-		for (i=0;i<8;i++)
-		{
-//			printf("0x%1x 0x%1x\n", (c->instr.track.need.eflags & 1 << i), (et->track.eflags & 1 << i));
-			if ( (c->instr.track.need.eflags & 1 << i) > (et->track.eflags & 1 << i))
-				return -1;
-		}
+		if ( !regs_cover(et->track.regs, c->instr.track.need.regs) )
+			return -1;
 
-		for (i=0;i<8;i++)
-		{
-//			printf("reg %i before %08x after %08x\n", i, et->track.reg[i], c->instr.track.init.reg[i]);
-			et->track.reg[i] |= c->instr.track.init.reg[i];
-		}
+		if ( (c->instr.track.need.eflags & ~et->track.eflags & 0xff) != 0 )
+			return -1;
 
+		et->track.regs |= c->instr.track.init.regs;
 		et->track.eflags |= c->instr.track.init.eflags;
 
 	}
@@ -124,40 +127,88 @@ int32_t emu_track_instruction_check(struct emu *e, struct emu_track_and_source *
 }
 
 
-struct emu_source_and_track_instr_info *emu_source_and_track_instr_info_new(struct emu_cpu *cpu, uint32_t eip_before_instruction)
+static void instr_info_init(struct emu_source_and_track_instr_info *etii, struct emu_instruction *instr, uint32_t eip_before_instruction, const uint8_t *data)
 {
-	struct emu_source_and_track_instr_info *etii = (struct emu_source_and_track_instr_info *)malloc(sizeof(struct emu_source_and_track_instr_info));
-	if( etii == NULL )
-	{
-		return NULL;
-	}
 	memset(etii, 0, sizeof(struct emu_source_and_track_instr_info));
 
 	etii->eip = eip_before_instruction;
-	if( CPU_DEBUG_FLAG_ISSET(cpu, instruction_string ) || CPU_DEBUG_FLAG_ISSET(cpu, instruction_size ) )
-		etii->instrstring = strdup(cpu->instr_string);
-	else
-		etii->instrstring = NULL;
+	etii->instrstring = NULL;
+	if( data != NULL )
+	{
+		memcpy(etii->instrdata, data, sizeof(etii->instrdata));
+		etii->has_instrdata = true;
+	}
 
-	if ( cpu->instr.is_fpu )
+	if ( instr->is_fpu )
 	{
-		etii->source.norm_pos 		= cpu->instr.source.norm_pos;
-		etii->track.init.fpu 		= cpu->instr.track.init.fpu;
+		etii->source.norm_pos 		= instr->source.norm_pos;
+		etii->track.init.fpu 		= instr->track.init.fpu;
 	}else
 	{
-		etii->source.has_cond_pos 	= cpu->instr.source.has_cond_pos;
-		etii->source.cond_pos 		= cpu->instr.source.cond_pos;
-		etii->source.norm_pos 		= cpu->instr.source.norm_pos;
+		etii->source.has_cond_pos 	= instr->source.has_cond_pos;
+		etii->source.cond_pos 		= instr->source.cond_pos;
+		etii->source.norm_pos 		= instr->source.norm_pos;
 
-		etii->track.init.eflags 	= cpu->instr.track.init.eflags;
-		memcpy(etii->track.init.reg, cpu->instr.track.init.reg, sizeof(uint32_t)*8);
+		etii->track.init.eflags 	= instr->track.init.eflags;
+		etii->track.init.regs 		= instr->track.init.regs;
 
-		etii->track.need.eflags 	= cpu->instr.track.need.eflags;
-		memcpy(etii->track.need.reg, cpu->instr.track.need.reg, sizeof(uint32_t)*8);
+		etii->track.need.eflags 	= instr->track.need.eflags;
+		etii->track.need.regs 		= instr->track.need.regs;
+	}
+}
+
+static struct emu_source_and_track_instr_info *instr_info_new(struct emu_instruction *instr, uint32_t eip_before_instruction, const uint8_t *data)
+{
+	struct emu_source_and_track_instr_info *etii = (struct emu_source_and_track_instr_info *)malloc(sizeof(struct emu_source_and_track_instr_info));
+	if( etii == NULL )
+	{
+		return NULL;
 	}
+
+	instr_info_init(etii, instr, eip_before_instruction, data);
 	return etii;
 }
 
+struct emu_source_and_track_instr_info *emu_source_and_track_instr_info_new(struct emu_cpu *cpu, uint32_t eip_before_instruction)
+{
+	if( CPU_DEBUG_FLAG_ISSET(cpu, instruction_string ) )
+		return instr_info_new(&cpu->instr, eip_before_instruction, cpu->instr_data);
+
+	return instr_info_new(&cpu->instr, eip_before_instruction, NULL);
+}
+
+struct emu_source_and_track_instr_info *emu_source_and_track_instr_info_new_decoded(struct emu_decoded *d, const uint8_t *data)
+{
+	return instr_info_new(&d->instr, d->va, data);
+}
+
+void emu_source_and_track_instr_info_init_decoded(struct emu_source_and_track_instr_info *etii, struct emu_decoded *d, const uint8_t *data)
+{
+	instr_info_init(etii, &d->instr, d->va, data);
+}
+
+const char *emu_source_and_track_instr_info_string(struct emu_source_and_track_instr_info *etii)
+{
+	if( etii->has_instrdata == false )
+		return "";
+
+	if( etii->instrstring == NULL )
+	{
+		uint8_t data[32];
+		memset(data, 0, sizeof(data));
+		memcpy(data, etii->instrdata, sizeof(etii->instrdata));
+
+		etii->instrstring = malloc(92);
+		if( etii->instrstring == NULL )
+			return "";
+
+		etii->instrstring[0] = '\0';
+		dasm_print_instruction(etii->eip, data, 0, etii->instrstring);
+	}
+
+	return etii->instrstring;
+}
+
 void emu_source_and_track_instr_info_free(struct emu_source_and_track_instr_info *etii)
 {
 	if (etii->instrstring != NULL)
@@ -173,11 +224,7 @@ void emu_source_and_track_instr_info_free_void(void *x)
 
 void emu_tracking_info_diff(struct emu_tracking_info *a, struct emu_tracking_info *b, struct emu_tracking_info *result)
 {
-	int i;
-	for (i=0;i<8;i++)
-	{
-		result->reg[i] = a->reg[i] & ~b->reg[i];
-	}
+	result->regs = a->regs & ~b->regs;
 	result->eflags = a->eflags & ~b->eflags;
 	result->fpu = a->fpu & ~b->fpu;
 }
@@ -186,7 +233,7 @@ struct emu_tracking_info *emu_tracking_info_new(void)
 {
 	struct emu_tracking_info *eti = malloc(sizeof(struct emu_tracking_info));
 	memset(eti, 0, sizeof(struct emu_tracking_info));
-	eti->reg[esp] = 0xffffffff;
+	eti->reg[esp] = TRACK_REG32;
 	return eti;
 }
 
@@ -198,7 +245,7 @@ void emu_tracking_info_free(struct emu_tracking_info *eti)
 void emu_tracking_info_clear(struct emu_tracking_info *eti)
 {
 	memset(eti, 0, sizeof(struct emu_tracking_info));
-	eti->reg[esp] = 0xffffffff;
+	eti->reg[esp] = TRACK_REG32;
 }
 
 void emu_tracking_info_copy(struct emu_tracking_info *from, struct emu_tracking_info *to)
@@ -208,21 +255,11 @@ void emu_tracking_info_copy(struct emu_tracking_info *from, struct emu_tracking_
 
 bool emu_tracking_info_covers(struct emu_tracking_info *a, struct emu_tracking_info *b)
 {
-	int i;
-	for (i=0;i<8;i++)
-	{
-		if (i == esp)
-			continue;
-
-		if (b->reg[i] > a->reg[i])
-			return false;
-	}
+	if ( !regs_cover(a->regs, b->regs) )
+		return false;
 
-	for (i=0;i<8;i++)
-	{
-		if ( (b->eflags & 1 << i) > (a->eflags & 1 << i))
-			return false;
-	}
+	if ( (b->eflags & ~a->eflags & 0xff) != 0 )
+		return false;
 
 	if ( b->fpu > a->fpu )
 		return false;
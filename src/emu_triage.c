@@ -0,0 +1,333 @@
+/********************************************************************************
+ *                               libemu
+ *
+ *                    - x86 shellcode emulation -
+ *
+ *
+ * Copyright (C) 2007  Paul Baecher & Markus Koetter
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ * 
+ * 
+ *             contact nepenthesdev@users.sourceforge.net  
+ *
+ *******************************************************************************/
+
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "emu/emu_cpu_decode.h"
+#include "emu/emu_triage.h"
+
+/* the size of the windows the entropy is taken of */
+#define TRIAGE_WINDOW 256
+
+/* what each reason adds to the score */
+#define SCORE_GETPC     50
+#define SCORE_NOPSLED   20
+#define SCORE_ENTROPY   15
+#define SCORE_DECODABLE 15
+
+/* where the reasons start to apply */
+#define NOPSLED_MIN     8
+#define ENTROPY_MIN     550
+#define DECODABLE_MIN   90
+#define PRINTABLE_MIN   90
+
+/* c * log2(c) in 1/65536 for the counts of a byte within a window, as
+ * c * log2_fixed(c) gives it, libemu does not link the math library */
+static const uint32_t entropy_table[TRIAGE_WINDOW + 1] = {
+	0, 0, 131072, 311616, 524288, 760845,
+	1016448, 1287874, 1572864, 1869696, 2177050, 2493887,
+	2819328, 3152643, 3493252, 3840615, 4194304, 4553875,
+	4919040, 5289448, 5664820, 6044934, 6429566, 6818465,
+	7211520, 7608475, 8009222, 8413632, 8821512, 9232788,
+	9647310, 10065018, 10485760, 10909437, 11335974, 11765320,
+	12197376, 12632022, 13069264, 13508976, 13951080, 14395592,
+	14842380, 15291445, 15742716, 16196085, 16651586, 17109175,
+	17568768, 18030285, 18493750, 18959097, 19426316, 19895352,
+	20366208, 20838730, 21313040, 21788991, 22266664, 22745916,
+	23226780, 23709236, 24193268, 24678738, 25165824, 25654265,
+	26144250, 26635582, 27128396, 27622632, 28118160, 28615059,
+	29113344, 29612888, 30113708, 30615825, 31119264, 31623823,
+	32129760, 32636796, 33145040, 33654528, 34165136, 34676902,
+	35189784, 35703825, 36218986, 36735228, 37252600, 37770977,
+	38290410, 38810954, 39332484, 39855057, 40378734, 40903295,
+	41428992, 41955507, 42483098, 43011639, 43541100, 44071552,
+	44602866, 45135218, 45668376, 46202520, 46737520, 47273456,
+	47810304, 48347931, 48886420, 49425858, 49966112, 50507158,
+	51049086, 51591875, 52135504, 52679835, 53225080, 53771102,
+	54317880, 54865514, 55413864, 55963032, 56513000, 57063625,
+	57615012, 58167270, 58720256, 59273823, 59828210, 60383402,
+	60939252, 61495742, 62052988, 62610975, 63169688, 63729112,
+	64289232, 64849894, 65411360, 65973477, 66536230, 67099747,
+	67663872, 68228590, 68794032, 69360039, 69926744, 70494135,
+	71062050, 71630625, 72200000, 72769860, 73340190, 73911285,
+	74483136, 75055263, 75628280, 76201704, 76775840, 77350518,
+	77925888, 78501615, 79078176, 79655235, 80232780, 80810966,
+	81389616, 81968887, 82548770, 83129256, 83710164, 84291655,
+	84873720, 85456350, 86039536, 86623092, 87207362, 87792161,
+	88377300, 88963129, 89549460, 90136284, 90723592, 91311560,
+	91899810, 92488704, 93078236, 93668211, 94258430, 94849454,
+	95440896, 96032747, 96624998, 97217835, 97811252, 98405046,
+	98999406, 99594127, 100189400, 100785219, 101381376, 101978065,
+	102575076, 103172810, 103770852, 104369400, 104968240, 105567781,
+	106167600, 106767899, 107368672, 107969913, 108571616, 109173775,
+	109776384, 110379220, 110982710, 111586632, 112190760, 112795527,
+	113400708, 114006297, 114612288, 115218675, 115825452, 116432840,
+	117040380, 117648521, 118257030, 118865901, 119475360, 120085171,
+	120695094, 121305825, 121916656, 122528052, 123139772, 123751810,
+	124364400, 124977298, 125590740, 126204480, 126818512, 127433075,
+	128047920, 128663041, 129278928, 129894834, 130511250, 131127922,
+	131745096, 132362769, 132980684, 133598835, 134217728,
+};
+
+/* what a byte can be, the bits of byte_class */
+#define CLASS_NOP       (1 << 0)	/* nop, inc and dec */
+#define CLASS_PRINTABLE (1 << 1)
+
+#define N  CLASS_NOP
+#define P  CLASS_PRINTABLE
+#define NP (CLASS_NOP | CLASS_PRINTABLE)
+
+static const uint8_t byte_class[256] = {
+	/* 00 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, P, P, 0, 0, P, 0, 0,
+	/* 10 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	/* 20 */ P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,
+	/* 30 */ P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,
+	/* 40 */ NP, NP, NP, NP, NP, NP, NP, NP, NP, NP, NP, NP, NP, NP, NP, NP,
+	/* 50 */ P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,
+	/* 60 */ P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,
+	/* 70 */ P, P, P, P, P, P, P, P, P, P, P, P, P, P, P, 0,
+	/* 80 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	/* 90 */ N, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	/* a0 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	/* b0 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	/* c0 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	/* d0 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	/* e0 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	/* f0 */ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+#undef N
+#undef P
+#undef NP
+
+/* log2(x) in 1/65536, x must not be 0 */
+static uint32_t log2_fixed(uint32_t x)
+{
+	uint32_t msb = 31 - __builtin_clz(x);
+	uint64_t z = ((uint64_t)x << 16) >> msb; /* x / 2^msb, in [1, 2) */
+	uint32_t y = msb << 16;
+	int i;
+
+	/* squaring z doubles its log2, the bit shows if it reaches 2 */
+	for ( i=15; i>=0; i-- )
+	{
+		z = (z * z) >> 16;
+		if ( z >= (2 << 16) )
+		{
+			z >>= 1;
+			y |= 1 << i;
+		}
+	}
+
+	return y;
+}
+
+/* the entropy of size bytes, TRIAGE_WINDOW at most, in 1/100 bits per byte */
+static uint32_t triage_entropy(uint8_t *data, uint32_t size)
+{
+	uint32_t count[256];
+	uint64_t sum = 0;
+	uint32_t i;
+
+	memset(count, 0, sizeof(count));
+	for ( i=0; i<size; i++ )
+		count[data[i]]++;
+
+	for ( i=0; i<256; i++ )
+		sum += entropy_table[count[i]];
+
+	return ((log2_fixed(size) - (uint32_t)(sum / size)) * 100) >> 16;
+}
+
+/* the byte at offset, emu_getpc_check reads 0 behind the buffer */
+static inline uint8_t triage_byte(uint8_t *data, uint32_t size, uint32_t offset)
+{
+	return offset < size ? data[offset] : 0;
+}
+
+/**
+ * Check for the candidates emu_getpc_check takes, with all registers
+ * but esp 0: a call not further than 512 bytes away or a fnstenv to
+ * esp - 0xc.
+ */
+static bool triage_getpc(uint8_t *data, uint32_t size, uint32_t offset)
+{
+	if ( data[offset] == 0xe8 )
+	{
+		int32_t disp = (int32_t)(triage_byte(data, size, offset + 1) |
+								 triage_byte(data, size, offset + 2) << 8 |
+								 triage_byte(data, size, offset + 3) << 16 |
+								 (uint32_t)triage_byte(data, size, offset + 4) << 24);
+
+		return disp >= -512 && disp <= 512;
+	}
+
+	if ( data[offset] == 0xd9 && size - offset >= 4 )
+	{
+		uint8_t modrm = data[offset + 1];
+		uint8_t sib = data[offset + 2];
+
+		/* fnstenv, addressed by a sib with esp as base */
+		if ( (modrm & 0x38) != 0x30 || (modrm & 0x07) != 4 || (sib & 0x07) != 4 )
+			return false;
+
+		if ( (modrm & 0xc0) == 0x40 )
+			return data[offset + 3] == 0xf4;
+
+		if ( (modrm & 0xc0) == 0x80 && size - offset >= 7 )
+			return data[offset + 3] == 0xf4 && data[offset + 4] == 0xff &&
+				data[offset + 5] == 0xff && data[offset + 6] == 0xff;
+	}
+
+	return false;
+}
+
+uint32_t emu_triage_getpc(uint8_t *data, uint32_t size)
+{
+	static const uint8_t first[] = { 0xe8, 0xd9 };
+	uint32_t getpc = 0;
+	int i;
+
+	for ( i=0; i<sizeof(first); i++ )
+	{
+		uint8_t *p = memchr(data, first[i], size);
+
+		while ( p != NULL )
+		{
+			if ( triage_getpc(data, size, p - data) )
+				getpc++;
+
+			p = memchr(p + 1, first[i], data + size - p - 1);
+		}
+	}
+
+	return getpc;
+}
+
+uint32_t emu_triage(uint8_t *data, uint32_t size, struct emu_triage *t)
+{
+	uint32_t i;
+
+	memset(t, 0, sizeof(struct emu_triage));
+
+	if ( size == 0 )
+		return 0;
+
+	/* the byte patterns, a single pass */
+	uint32_t run = 0;
+	uint32_t printable = 0;
+
+	for ( i=0; i<size; i++ )
+	{
+		uint8_t class = byte_class[data[i]];
+
+		if ( class & CLASS_NOP )
+		{
+			if ( ++run > t->nopsled )
+				t->nopsled = run;
+		}
+		else
+			run = 0;
+
+		if ( class & CLASS_PRINTABLE )
+			printable++;
+
+	}
+
+	t->printable = (uint64_t)printable * 100 / size;
+	t->getpc = emu_triage_getpc(data, size);
+
+	/* the entropy of the windows, the last one ends with the buffer */
+	if ( size <= TRIAGE_WINDOW )
+		t->entropy = triage_entropy(data, size);
+	else
+	{
+		for ( i=0; i<size; i+=TRIAGE_WINDOW )
+		{
+			uint32_t start = size - i < TRIAGE_WINDOW ? size - TRIAGE_WINDOW : i;
+			uint32_t entropy = triage_entropy(data + start, TRIAGE_WINDOW);
+
+			if ( entropy > t->entropy )
+				t->entropy = entropy;
+		}
+	}
+
+	/* a linear sweep, skipping a byte where no instruction decodes,
+	 * zeros decode as add [eax],al, they are not counted */
+	uint32_t decoded = 0;
+
+	for ( i=0; i<size; )
+	{
+		int32_t len = emu_cpu_decode_length(data + i, size - i);
+
+		if ( len > 0 )
+		{
+			if ( len != 2 || data[i] != 0 || data[i + 1] != 0 )
+				decoded += len;
+			i += len;
+		}
+		else
+			i++;
+	}
+
+	t->decodable = (uint64_t)decoded * 100 / size;
+
+	if ( t->getpc > 0 )
+	{
+		t->score += SCORE_GETPC;
+		t->reasons |= EMU_TRIAGE_GETPC;
+	}
+
+	if ( t->nopsled >= NOPSLED_MIN )
+	{
+		t->score += SCORE_NOPSLED;
+		t->reasons |= EMU_TRIAGE_NOPSLED;
+	}
+
+	if ( t->entropy >= ENTROPY_MIN )
+	{
+		t->score += SCORE_ENTROPY;
+		t->reasons |= EMU_TRIAGE_ENTROPY;
+	}
+
+	if ( t->decodable >= DECODABLE_MIN )
+	{
+		t->score += SCORE_DECODABLE;
+		t->reasons |= EMU_TRIAGE_DECODABLE;
+	}
+
+	/* text has nothing to get the pc with */
+	if ( t->printable >= PRINTABLE_MIN && t->getpc == 0 )
+	{
+		t->score /= 2;
+		t->reasons |= EMU_TRIAGE_TEXT;
+	}
+
+	return t->score;
+}
@@ -51,3 +51,8 @@ void emu_env_free(struct emu_env *env)
 		emu_profile_free(env->profile);
 	free(env);
 }
+
+int32_t emu_env_reset(struct emu_env *env)
+{
+	return emu_env_w32_reset(env->env.win);
+}
@@ -161,7 +161,7 @@ void emu_profile_argument_add_short(struct emu_profile *profile, char *argtype,
 }
 
 
-void emu_profile_argument_add_string(struct emu_profile *profile, char *argtype, char *argname, char *value)
+void emu_profile_argument_add_string(struct emu_profile *profile, const char *argtype, const char *argname, const char *value)
 {
 
     struct emu_profile_argument *argument = emu_profile_argument_new(render_string, argtype, argname);
@@ -539,22 +539,17 @@ void emu_profile_argument_free(struct emu_profile_argument *argument)
 	free(argument);
 }
 
-char *indents(int i)
-{
-	static char indents[255];
-	memset(indents, ' ', 255);
-	indents[i*4] = '\0';
-	return indents;
-}
+/* printf("%*s", INDENT(i), "") */
+#define INDENT(i) ((i) * 4), ""
 
 
 void emu_profile_argument_debug(struct emu_profile_argument *argument, int indent)
 {
-//	printf("%s %s = ", indents(indent), argument->argname);
+//	printf("%*s %s = ", INDENT(indent), argument->argname);
 	switch(argument->render)
 	{
 	case render_struct:
-		printf("%s struct %s %s = {\n", indents(indent), argument->argtype, argument->argname);
+		printf("%*s struct %s %s = {\n", INDENT(indent), argument->argtype, argument->argname);
 
 
 		struct emu_profile_argument *argumentit;
@@ -565,35 +560,35 @@ void emu_profile_argument_debug(struct emu_profile_argument *argument, int inden
 			emu_profile_argument_debug(argumentit,indent+1);
 		}
 
-		printf("%s };\n", indents(indent));
+		printf("%*s };\n", INDENT(indent));
 		break;
 
 	case render_array:
-		printf("%s %s %s = [\n", indents(indent), argument->argtype, argument->argname);
+		printf("%*s %s %s = [\n", INDENT(indent), argument->argtype, argument->argname);
 		for (argumentit = emu_profile_arguments_first(argument->value.tstruct.arguments); 
 			  !emu_profile_arguments_istail(argumentit); 
 			  argumentit = emu_profile_arguments_next(argumentit))
 		{
 			emu_profile_argument_debug(argumentit,indent+1);
 		}
-		printf("%s ];\n", indents(indent));
+		printf("%*s ];\n", INDENT(indent));
 		break;
 
 	case render_int:
-		printf("%s %s %s = %i;\n", indents(indent), argument->argtype, argument->argname, argument->value.tint);
+		printf("%*s %s %s = %i;\n", INDENT(indent), argument->argtype, argument->argname, argument->value.tint);
 		break;
 
 	case render_short:
-		printf("%s %s %s = %i;\n", indents(indent), argument->argtype, argument->argname, argument->value.tshort);
+		printf("%*s %s %s = %i;\n", INDENT(indent), argument->argtype, argument->argname, argument->value.tshort);
 		break;
 
 
 	case render_string:
-		printf("%s %s %s = \"%s\";\n", indents(indent), argument->argtype, argument->argname, argument->value.tchar);
+		printf("%*s %s %s = \"%s\";\n", INDENT(indent), argument->argtype, argument->argname, argument->value.tchar);
 		break;
 
 	case render_bytea:
-		printf("%s %s %s = \"%s\" (%i bytes);\n", indents(indent), argument->argtype, argument->argname, ".binary.", argument->value.bytea.size);
+		printf("%*s %s %s = \"%s\" (%i bytes);\n", INDENT(indent), argument->argtype, argument->argname, ".binary.", argument->value.bytea.size);
 		break;
 
 	case render_ptr:
@@ -605,24 +600,28 @@ void emu_profile_argument_debug(struct emu_profile_argument *argument, int inden
 			}
 
 			if (argit->render == render_struct)
-				printf("%s struct %s %s = 0x%08x => \n", indents(indent), argument->argtype, argument->argname, argument->value.tptr.addr);
+				printf("%*s struct %s %s = 0x%08x => \n", INDENT(indent), argument->argtype, argument->argname, argument->value.tptr.addr);
 			else
-				printf("%s %s %s = 0x%08x => \n", indents(indent), argument->argtype, argument->argname, argument->value.tptr.addr);
+				printf("%*s %s %s = 0x%08x => \n", INDENT(indent), argument->argtype, argument->argname, argument->value.tptr.addr);
 
 			emu_profile_argument_debug(argument->value.tptr.ptr, indent+1);
 		}
 		break;
 
 	case render_ip:
-		printf("%s %s %s = %i (host=%s);\n", indents(indent), argument->argtype, argument->argname, argument->value.tint, inet_ntoa(*(struct in_addr *)&argument->value.tint));
+		{
+			char host[INET_ADDRSTRLEN];
+			inet_ntop(AF_INET, &argument->value.tint, host, sizeof(host));
+			printf("%*s %s %s = %i (host=%s);\n", INDENT(indent), argument->argtype, argument->argname, argument->value.tint, host);
+		}
 		break;
 
 	case render_port:
-		printf("%s %s %s = %i (port=%i);\n", indents(indent), argument->argtype, argument->argname, argument->value.tint, ntohs((uint16_t)argument->value.tint));
+		printf("%*s %s %s = %i (port=%i);\n", INDENT(indent), argument->argtype, argument->argname, argument->value.tint, ntohs((uint16_t)argument->value.tint));
 		break;
 
 	case render_none:
-		printf("%s none;\n", indents(indent));
+		printf("%*s none;\n", INDENT(indent));
 		break;
 	}
 }
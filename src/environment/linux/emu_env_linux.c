@@ -25,9 +25,12 @@
  *
  *******************************************************************************/
 
+#include <pthread.h>
+
 #include "emu/emu.h"
 #include "emu/emu_cpu.h"
 #include "emu/emu_memory.h"
+#include "emu/emu_trace.h"
 
 
 #include "emu/environment/emu_env.h"
@@ -35,13 +38,36 @@
 #include "emu/environment/linux/emu_env_linux.h"
 #include "emu/environment/linux/env_linux_syscalls.h"
 
+/* the syscall names map to the index of the hook, the table is the same
+ * for every env and built once */
+static struct emu_hashtable *syscall_index;
+static pthread_mutex_t syscall_index_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static struct emu_hashtable *syscall_index_get(void)
+{
+	pthread_mutex_lock(&syscall_index_lock);
+
+	if ( syscall_index == NULL )
+	{
+		int i;
+		syscall_index = emu_hashtable_new(256, emu_hashtable_string_hash,  emu_hashtable_string_cmp);
+
+		for (i=0;i<sizeof(syscall_hooks)/sizeof(struct emu_env_linux_syscall);i++)
+			emu_hashtable_insert(syscall_index, (void *)syscall_hooks[i].name, (void *)(uintptr_t)i);
+	}
+
+	pthread_mutex_unlock(&syscall_index_lock);
+
+	return syscall_index;
+}
+
 struct emu_env_linux *emu_env_linux_new(struct emu *e)
 {
 	struct emu_env_linux *eel = malloc(sizeof(struct emu_env_linux));
 	memset(eel, 0, sizeof(struct emu_env_linux));
 	eel->emu = e;
 
-	eel->syscall_hooks_by_name = emu_hashtable_new(256, emu_hashtable_string_hash,  emu_hashtable_string_cmp);
+	eel->syscall_hooks_by_name = syscall_index_get();
 	int i;
 	eel->syscall_hookx = malloc(sizeof(syscall_hooks));
 	eel->hooks = malloc(sizeof(struct emu_env_hook)*(sizeof(syscall_hooks)/sizeof(struct emu_env_linux_syscall)));
@@ -51,7 +77,6 @@ struct emu_env_linux *emu_env_linux_new(struct emu *e)
 	{
 		eel->hooks[i].type = emu_env_type_linux;
 		eel->hooks[i].hook.lin = &eel->syscall_hookx[i];
-		emu_hashtable_insert(eel->syscall_hooks_by_name, (void *)eel->syscall_hookx[i].name, (void *)&eel->hooks[i]);
 	}
 
 //	eel->profile = emu_profile_new();
@@ -62,7 +87,6 @@ struct emu_env_linux *emu_env_linux_new(struct emu *e)
 
 void emu_env_linux_free(struct emu_env_linux *eel)
 {
-	emu_hashtable_free(eel->syscall_hooks_by_name);
 	free(eel->syscall_hookx);
 	free(eel->hooks);
 //	emu_profile_free(eel->profile);
@@ -77,7 +101,7 @@ struct emu_env_hook *emu_env_linux_syscall_check(struct emu_env *env)
 		 &&  cpu->instr.opc == 0xcd 
 		 &&  *cpu->instr.cpu.imm8 == 0x80 )
 	{
-		uint8_t callnum = *cpu->reg8[al];
+		uint8_t callnum = CPU_REG8(cpu, al);
 		if ( callnum < sizeof(env_linux_syscalls) / sizeof(struct emu_env_linux_syscall_entry) )
 		{
 			const char *name = NULL ;
@@ -96,7 +120,10 @@ struct emu_env_hook *emu_env_linux_syscall_check(struct emu_env *env)
 				struct emu_hashtable_item *ehi = emu_hashtable_search(env->env.lin->syscall_hooks_by_name, (void *)name);
 				if ( ehi != NULL )
 				{
-					return (struct emu_env_hook *)ehi->value;
+					emu_cpu_stats_hook(cpu);
+					/* int 0x80 was parsed already */
+					emu_cpu_trace_hook(cpu, cpu->eip - 2, name);
+					return &env->env.lin->hooks[(uintptr_t)ehi->value];
 				}
 			}
 		}
@@ -115,7 +142,7 @@ int32_t emu_env_linux_syscall_hook(struct emu_env *env, const char *syscallname,
 	if (ehi != NULL)
 	{
 
-		struct emu_env_hook *hook = (struct emu_env_hook *)ehi->value;
+		struct emu_env_hook *hook = &env->env.lin->hooks[(uintptr_t)ehi->value];
 		hook->hook.lin->userhook = userhook;
 		hook->hook.lin->userdata = userdata;
 		return 0;
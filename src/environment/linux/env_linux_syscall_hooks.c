@@ -186,7 +186,7 @@ int32_t env_linux_hook_socketcall(struct emu_env *env, struct emu_env_hook *hook
 	struct emu_cpu *c = emu_cpu_get(env->emu);
 
 #define AL(x) (x)
-	static unsigned char nargs[18]={AL(0),AL(3),AL(3),AL(3),AL(2),AL(3),
+	static const unsigned char nargs[18]={AL(0),AL(3),AL(3),AL(3),AL(2),AL(3),
 		AL(3),AL(3),AL(4),AL(4),AL(4),AL(6),
 		AL(6),AL(2),AL(5),AL(5),AL(3),AL(3)};
 #undef AL
@@ -28,10 +28,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#include <pthread.h>
 
 #include "emu/emu.h"
 #include "emu/emu_cpu.h"
 #include "emu/emu_memory.h"
+#include "emu/emu_trace.h"
 #include "emu/emu_hashtable.h"
 #include "emu/environment/emu_env.h"
 #include "emu/environment/emu_profile.h"
@@ -68,7 +70,7 @@ extern const char shdocvw_7E290000[];
 extern const char shdocvw_7E2A4480[];
 
 
-struct emu_env_w32_known_dll_segment kernel32_segments[] = 
+static const struct emu_env_w32_known_dll_segment kernel32_segments[] = 
 {
 	{
 		.address = 0x7c800000,
@@ -83,7 +85,7 @@ struct emu_env_w32_known_dll_segment kernel32_segments[] =
 	{ 0, NULL, 0 }
 };
 
-struct emu_env_w32_known_dll_segment ws2_32_segments[] = 
+static const struct emu_env_w32_known_dll_segment ws2_32_segments[] = 
 {
 	{
 		.address = 0x71a10000,
@@ -98,7 +100,7 @@ struct emu_env_w32_known_dll_segment ws2_32_segments[] =
 	{ 0, NULL, 0 }
 };
 
-struct emu_env_w32_known_dll_segment msvcrt_segments[] = 
+static const struct emu_env_w32_known_dll_segment msvcrt_segments[] = 
 {
 	{
 		.address = 0x77be0000,
@@ -113,7 +115,7 @@ struct emu_env_w32_known_dll_segment msvcrt_segments[] =
 	{ 0, NULL, 0 }
 };
 
-struct emu_env_w32_known_dll_segment urlmon_segments[] = 
+static const struct emu_env_w32_known_dll_segment urlmon_segments[] = 
 {
 	{
 		.address = 0x7DF20000,
@@ -129,7 +131,7 @@ struct emu_env_w32_known_dll_segment urlmon_segments[] =
 };
 
 //dzzie 1-26-11
-struct emu_env_w32_known_dll_segment user32_segments[] = 
+static const struct emu_env_w32_known_dll_segment user32_segments[] = 
 {
 	{
 		.address = 0x7E410000,
@@ -145,7 +147,7 @@ struct emu_env_w32_known_dll_segment user32_segments[] =
 };
 
 //dzzie 1-26-11
-struct emu_env_w32_known_dll_segment shell32_segments[] = 
+static const struct emu_env_w32_known_dll_segment shell32_segments[] = 
 {
 	{
 		.address = 0x7C9C0000,
@@ -161,7 +163,7 @@ struct emu_env_w32_known_dll_segment shell32_segments[] =
 };
 
 //dzzie 2-2-11
-struct emu_env_w32_known_dll_segment wininet_segments[] = 
+static const struct emu_env_w32_known_dll_segment wininet_segments[] = 
 {
 	{
 		.address = 0x3D930000,
@@ -176,7 +178,7 @@ struct emu_env_w32_known_dll_segment wininet_segments[] =
 	{ 0, NULL, 0 }
 };
 
-struct emu_env_w32_known_dll_segment ntdll_segments[] = 
+static const struct emu_env_w32_known_dll_segment ntdll_segments[] = 
 {
 	{
 		.address = 0x7C900000,
@@ -191,7 +193,7 @@ struct emu_env_w32_known_dll_segment ntdll_segments[] =
 	{ 0, NULL, 0 }
 };
 
-struct emu_env_w32_known_dll_segment shlwapi_segments[] = 
+static const struct emu_env_w32_known_dll_segment shlwapi_segments[] = 
 {
 	{
 		.address = 0x77F60000,
@@ -206,7 +208,7 @@ struct emu_env_w32_known_dll_segment shlwapi_segments[] =
 	{ 0, NULL, 0 }
 };
 
-struct emu_env_w32_known_dll_segment advapi32_segments[] = 
+static const struct emu_env_w32_known_dll_segment advapi32_segments[] = 
 {
 	{
 		.address = 0x77DD0000,
@@ -221,7 +223,7 @@ struct emu_env_w32_known_dll_segment advapi32_segments[] =
 	{ 0, NULL, 0 }
 };
 
-struct emu_env_w32_known_dll_segment shdocvw_segments[] = 
+static const struct emu_env_w32_known_dll_segment shdocvw_segments[] = 
 {
 	{
 		.address = 0x7E290000,
@@ -237,7 +239,7 @@ struct emu_env_w32_known_dll_segment shdocvw_segments[] =
 };
 
 
-struct emu_env_w32_known_dll known_dlls[] = 
+static const struct emu_env_w32_known_dll known_dlls[] = 
 {
 	{ /* dummy entry for the PEB/LDR lists 
 	   * shares base address with kernel32
@@ -335,14 +337,9 @@ struct emu_env_w32_known_dll known_dlls[] =
 };
 
 
-struct emu_env_w32 *emu_env_w32_new(struct emu *e)
+/* write the TEB, PEB and the loader lists to the memory */
+static void env_w32_process_write(struct emu *e)
 {
-	struct emu_env_w32 *env = (struct emu_env_w32 *)malloc(sizeof(struct emu_env_w32));
-	memset(env,0,sizeof(struct emu_env_w32));
-//	env->profile = emu_profile_new();
-	env->emu = e;
-	// write TEB and linklist
-
 	struct emu_memory *mem = emu_memory_get(e);
 	enum emu_segment oldseg = emu_memory_segment_get(mem);
 
@@ -447,7 +444,7 @@ struct emu_env_w32 *emu_env_w32_new(struct emu *e)
 	int i;
 	for ( i=0; known_dlls[i].dllname != NULL; i++ )
 	{
-		struct emu_env_w32_known_dll *from = known_dlls+i;
+		const struct emu_env_w32_known_dll *from = known_dlls+i;
 		struct _LDR_DATA_TABLE_ENTRY *to = tables+i;
 		
 		to->DllBase = from->baseaddress;
@@ -472,11 +469,73 @@ struct emu_env_w32 *emu_env_w32_new(struct emu *e)
 	}
 	emu_memory_write_block(mem, magic_offset, tables, sizeof(tables));
 	emu_memory_write_block(mem, magic_offset+sizeof(tables), names, sizeof(names));
+}
+
+/**
+ * The exports of every known dll are copied into a dll once per process,
+ * the dlls loaded later share its lookup tables, they are never freed.
+ * Keyed by the position in known_dlls, only the const built-in exports
+ * are shared.
+ */
+static struct emu_env_w32_dll *known_dll_exports[sizeof(known_dlls) / sizeof(known_dlls[0])];
+static pthread_mutex_t known_dll_exports_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static struct emu_env_w32_dll *known_dll_exports_get(int i)
+{
+	struct emu_env_w32_dll *dll;
+
+	pthread_mutex_lock(&known_dll_exports_lock);
+
+	dll = known_dll_exports[i];
+	if ( dll == NULL && (dll = emu_env_w32_dll_new()) != NULL )
+	{
+		if ( emu_env_w32_dll_exports_copy(dll, known_dlls[i].exports) == 0 )
+			known_dll_exports[i] = dll;
+		else
+		{
+			emu_env_w32_dll_free(dll);
+			dll = NULL;
+		}
+	}
+
+	pthread_mutex_unlock(&known_dll_exports_lock);
+
+	return dll;
+}
+
+static void env_w32_dll_write(struct emu_env_w32 *env, const struct emu_env_w32_known_dll *known)
+{
+	struct emu_memory *mem = emu_memory_get(env->emu);
+	int j;
+
+	for ( j=0; known->memory_segments[j].address != 0; j++ )
+	{
+		logDebug(env->emu, " 0x%08x %i bytes\n", known->memory_segments[j].address, 
+			   known->memory_segments[j].segment_size);
+		emu_memory_write_block(mem,
+							   known->memory_segments[j].address,
+							   (void *)known->memory_segments[j].segment,
+							   known->memory_segments[j].segment_size);
+	}
+}
+
+struct emu_env_w32 *emu_env_w32_new(struct emu *e)
+{
+	struct emu_env_w32 *env = (struct emu_env_w32 *)malloc(sizeof(struct emu_env_w32));
+	memset(env,0,sizeof(struct emu_env_w32));
+//	env->profile = emu_profile_new();
+	env->emu = e;
+
+	// write TEB and linklist
+	env_w32_process_write(e);
 
 	// map kernel32.dll to emu's memory at 0x7c800000
 	if (emu_env_w32_load_dll(env,"kernel32.dll") == -1 || emu_env_w32_load_dll(env,"ws2_32.dll") == -1 )
     {
-		free(env);
+		if (env->loaded_dlls != NULL)
+			emu_env_w32_free(env);
+		else
+			free(env);
 		return NULL;
 	}
 
@@ -484,6 +543,44 @@ struct emu_env_w32 *emu_env_w32_new(struct emu *e)
 	return env;
 }
 
+/* the number of dlls emu_env_w32_new loads */
+#define ENV_W32_INITIAL_DLLS 2
+
+int32_t emu_env_w32_reset(struct emu_env_w32 *env)
+{
+	int numdlls = 0;
+	while (env->loaded_dlls[numdlls] != NULL)
+	{
+		if (numdlls >= ENV_W32_INITIAL_DLLS)
+		{
+			emu_env_w32_dll_free(env->loaded_dlls[numdlls]);
+			env->loaded_dlls[numdlls] = NULL;
+		}
+		numdlls++;
+	}
+
+	env->last_good_eip = 0;
+	env->lastExceptionHandler = 0;
+	env->exception_count = 0;
+
+	env_w32_process_write(env->emu);
+
+	for ( numdlls=0; env->loaded_dlls[numdlls] != NULL; numdlls++ )
+	{
+		int i;
+		for ( i=1; known_dlls[i].dllname != NULL; i++ )
+			if ( strcmp(env->loaded_dlls[numdlls]->dllname, known_dlls[i].dllname) == 0 )
+				break;
+
+		if ( known_dlls[i].dllname == NULL )
+			return -1;
+
+		env_w32_dll_write(env, &known_dlls[i]);
+	}
+
+	return 0;
+}
+
 void emu_env_w32_free(struct emu_env_w32 *env)
 {
 	int numdlls = 0;
@@ -511,24 +608,22 @@ int32_t emu_env_w32_load_dll(struct emu_env_w32 *env, char *dllname)
 		if ( strncasecmp(dllname, known_dlls[i].dllname, strlen(known_dlls[i].dllname)) == 0 )
 		{
 			logDebug(env->emu, "loading dll %s\n",dllname);
+			struct emu_env_w32_dll *exports = known_dll_exports_get(i);
 			struct emu_env_w32_dll *dll = emu_env_w32_dll_new();
-			struct emu_memory *mem = emu_memory_get(env->emu);
 
-			dll->dllname = strdup(known_dlls[i].dllname);
-			dll->baseaddr = known_dlls[i].baseaddress;
-			dll->imagesize = known_dlls[i].imagesize;
-			int j;
-			for ( j=0; known_dlls[i].memory_segments[j].address != 0; j++ )
+			if ( exports == NULL || dll == NULL || emu_env_w32_dll_exports_share(dll, exports) != 0 )
 			{
-				logDebug(env->emu, " 0x%08x %i bytes\n", known_dlls[i].memory_segments[j].address, 
-					   known_dlls[i].memory_segments[j].segment_size);
-				emu_memory_write_block(mem,
-									   known_dlls[i].memory_segments[j].address,
-									   (void *)known_dlls[i].memory_segments[j].segment,
-									   known_dlls[i].memory_segments[j].segment_size);
+				if ( dll != NULL )
+					emu_env_w32_dll_free(dll);
+				emu_errno_set(env->emu, ENOMEM);
+				emu_strerror_set(env->emu, "could not copy the exports of %s\n", known_dlls[i].dllname);
+				return -1;
 			}
 
-			emu_env_w32_dll_exports_copy(dll, known_dlls[i].exports);
+			dll->dllname = strdup(known_dlls[i].dllname);
+			dll->baseaddr = known_dlls[i].baseaddress;
+			dll->imagesize = known_dlls[i].imagesize;
+			env_w32_dll_write(env, &known_dlls[i]);
 
 			int numdlls=0;
 			if ( env->loaded_dlls != NULL )
@@ -569,25 +664,28 @@ struct emu_env_hook *emu_env_w32_eip_check(struct emu_env *env)
 			logDebug(env->env.win->emu, "eip %08x is within %s\n",eip, env->env.win->loaded_dlls[numdlls]->dllname);
 			struct emu_env_w32_dll *dll = env->env.win->loaded_dlls[numdlls];
 
-			struct emu_hashtable_item *ehi = emu_hashtable_search(dll->exports_by_fnptr, (void *)(uintptr_t)(eip - dll->baseaddr));
+			struct emu_env_hook *hook = emu_env_w32_dll_hook_by_fnptr(dll, eip - dll->baseaddr);
 
-			if ( ehi == NULL )
+			if ( hook == NULL )
 			{
 				logDebug(env->emu, "unknown call to %08x\n", eip);
 				return NULL;
 			}
 
-		
-			struct emu_env_hook *hook = (struct emu_env_hook *)ehi->value;
+
+			struct emu_cpu *cpu = emu_cpu_get(env->emu);
+			emu_cpu_stats_hook(cpu);
 
 			if ( hook->hook.win->fnhook != NULL )
 			{
 				hook->hook.win->fnhook(env, hook);
+				emu_cpu_trace_hook(cpu, eip, hook->hook.win->fnname);
 				return hook;
 			}
 			else
 			{
 				logDebug(env->emu, "unhooked call to %s\n", hook->hook.win->fnname);
+				emu_cpu_trace_hook(cpu, eip, hook->hook.win->fnname);
 				return hook;
 			}
 		}
@@ -607,13 +705,12 @@ int32_t emu_env_w32_export_hook(struct emu_env *env,
 	{
 		if (1)//dllname == NULL || strncasecmp(env->loaded_dlls[numdlls]->dllname, dllname, strlen(env->loaded_dlls[numdlls]->dllname)) == 0)
 		{
-			struct emu_hashtable_item *ehi = emu_hashtable_search(env->env.win->loaded_dlls[numdlls]->exports_by_fnname, (void *)exportname);
-			if (ehi != NULL)
+			struct emu_env_hook *hook = emu_env_w32_dll_hook_by_fnname(env->env.win->loaded_dlls[numdlls], exportname);
+			if (hook != NULL)
 			{
 #if 0
 				printf("hooked %s\n",  exportname);
 #endif
-				struct emu_env_hook *hook = (struct emu_env_hook *)ehi->value;
 				hook->hook.win->userhook = fnhook;
 				hook->hook.win->userdata = userdata;
 				return 0;
@@ -37,44 +37,108 @@
 struct emu_env_w32_dll *emu_env_w32_dll_new(void)
 {
 	struct emu_env_w32_dll *dll = (struct emu_env_w32_dll *)malloc(sizeof(struct emu_env_w32_dll));
+	if (dll == NULL)
+		return NULL;
 	memset(dll,0,sizeof(struct emu_env_w32_dll));
     return dll;
 }
 
 void emu_env_w32_dll_free(struct emu_env_w32_dll *dll)
 {
-	emu_hashtable_free(dll->exports_by_fnptr);
-	emu_hashtable_free(dll->exports_by_fnname);
+	if (dll->exports_shared == false)
+	{
+		if (dll->exports_by_fnptr != NULL)
+			emu_hashtable_free(dll->exports_by_fnptr);
+		if (dll->exports_by_fnname != NULL)
+			emu_hashtable_free(dll->exports_by_fnname);
+	}
 	free(dll->exportx);
 	free(dll->hooks);
 	free(dll->dllname);
 	free(dll);
 }
 
-void emu_env_w32_dll_exports_copy(struct emu_env_w32_dll *to,struct emu_env_w32_dll_export *from)
+/* copy the exports and point the hooks to them */
+static int32_t exports_hooks_copy(struct emu_env_w32_dll *to, const struct emu_env_w32_dll_export *from, uint32_t size)
 {
-	uint32_t size;
 	uint32_t i;
-	for (i=0;from[i].fnname != 0; i++);
-
-	size = i;
 
 	to->exportx = malloc(sizeof(struct emu_env_w32_dll_export) * size);
 	to->hooks = malloc(sizeof(struct emu_env_hook) * size);
-	memcpy(to->exportx, from, sizeof(struct emu_env_w32_dll_export) * size);
-
+	if (to->exportx == NULL || to->hooks == NULL)
+		return -1;
 
-	to->exports_by_fnptr = emu_hashtable_new(size, emu_hashtable_ptr_hash,emu_hashtable_ptr_cmp);
-	to->exports_by_fnname = emu_hashtable_new(size, emu_hashtable_string_hash, emu_hashtable_string_cmp);
+	memcpy(to->exportx, from, sizeof(struct emu_env_w32_dll_export) * size);
+	to->exports_count = size;
 
-	for (i=0;from[i].fnname != 0; i++)
+	for (i=0;i<size; i++)
 	{
-		struct emu_env_w32_dll_export *ex = &to->exportx[i];
 		struct emu_env_hook *hook = &to->hooks[i];
 		hook->type = emu_env_type_win32;
-		hook->hook.win = ex;
+		hook->hook.win = &to->exportx[i];
+	}
+
+	return 0;
+}
+
+int32_t emu_env_w32_dll_exports_copy(struct emu_env_w32_dll *to, const struct emu_env_w32_dll_export *from)
+{
+	uint32_t size;
+	uint32_t i;
+	for (i=0;from[i].fnname != 0; i++);
+
+	size = i;
 
-		emu_hashtable_insert(to->exports_by_fnptr, (void *)(uintptr_t)from[i].virtualaddr, hook);
-		emu_hashtable_insert(to->exports_by_fnname, (void *)(uintptr_t)from[i].fnname, hook);
+	if (exports_hooks_copy(to, from, size) != 0)
+		return -1;
+
+	to->exports_by_fnptr = emu_hashtable_new(size, emu_hashtable_ptr_hash, emu_hashtable_ptr_cmp);
+	to->exports_by_fnname = emu_hashtable_new(size, emu_hashtable_string_hash, emu_hashtable_string_cmp);
+	to->exports_shared = false;
+	if (to->exports_by_fnptr == NULL || to->exports_by_fnname == NULL)
+		return -1;
+
+	for (i=0;i<size; i++)
+	{
+		emu_hashtable_insert(to->exports_by_fnptr, (void *)(uintptr_t)from[i].virtualaddr, (void *)(uintptr_t)i);
+		emu_hashtable_insert(to->exports_by_fnname, (void *)(uintptr_t)from[i].fnname, (void *)(uintptr_t)i);
 	}
+
+	return 0;
+}
+
+int32_t emu_env_w32_dll_exports_share(struct emu_env_w32_dll *to, const struct emu_env_w32_dll *from)
+{
+	if (exports_hooks_copy(to, from->exportx, from->exports_count) != 0)
+		return -1;
+
+	to->exports_by_fnptr = from->exports_by_fnptr;
+	to->exports_by_fnname = from->exports_by_fnname;
+	to->exports_shared = true;
+
+	return 0;
+}
+
+struct emu_env_hook *emu_env_w32_dll_hook_by_fnptr(struct emu_env_w32_dll *dll, uint32_t fnptr)
+{
+	if (dll->exports_by_fnptr == NULL)
+		return NULL;
+
+	struct emu_hashtable_item *ehi = emu_hashtable_search(dll->exports_by_fnptr, (void *)(uintptr_t)fnptr);
+	if (ehi == NULL)
+		return NULL;
+
+	return &dll->hooks[(uintptr_t)ehi->value];
+}
+
+struct emu_env_hook *emu_env_w32_dll_hook_by_fnname(struct emu_env_w32_dll *dll, const char *fnname)
+{
+	if (dll->exports_by_fnname == NULL)
+		return NULL;
+
+	struct emu_hashtable_item *ehi = emu_hashtable_search(dll->exports_by_fnname, (void *)fnname);
+	if (ehi == NULL)
+		return NULL;
+
+	return &dll->hooks[(uintptr_t)ehi->value];
 }
@@ -825,10 +825,9 @@ FFARPROC WINAPI GetProcAddress(
 			struct emu_env_w32_dll *dll = env->env.win->loaded_dlls[i];
 			if( emu_string_char(procname) != NULL && p_procname >= 0x1000 )
 			{ /* 2nd argument is a string */
-				struct emu_hashtable_item *ehi = emu_hashtable_search(dll->exports_by_fnname, (void *)emu_string_char(procname));
-				if ( ehi != NULL )
+				struct emu_env_hook *hook = emu_env_w32_dll_hook_by_fnname(dll, emu_string_char(procname));
+				if ( hook != NULL )
 				{
-					struct emu_env_hook *hook = (struct emu_env_hook *)ehi->value;
 					logDebug(env->emu, "found %s at addr %08x\n",emu_string_char(procname), dll->baseaddr + hook->hook.win->virtualaddr );
 					emu_cpu_reg32_set(c, eax, dll->baseaddr + hook->hook.win->virtualaddr);
 				}
@@ -898,7 +897,7 @@ UINT GetSystemDirectory(
 	uint32_t size;
 	POP_DWORD(c, &size);
 
-	static char *sysdir = "c:\\WINDOWS\\system32";
+	const char *sysdir = "c:\\WINDOWS\\system32";
 	emu_memory_write_block(emu_memory_get(env->emu), p_buffer, sysdir, 20);
 	emu_cpu_reg32_set(c, eax, 19);
 
@@ -939,7 +938,7 @@ DWORD WINAPI GetTempPath(
 	uint32_t p_buffer;
 	POP_DWORD(c, &p_buffer);
 
-	static char *path = "c:\\tmp\\";
+	const char *path = "c:\\tmp\\";
 
 	emu_memory_write_block(emu_memory_get(env->emu), p_buffer, path, 8);
 	emu_cpu_reg32_set(c, eax, 7);
@@ -41,10 +41,10 @@ int32_t instr_aaa_37(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	 * AAA
 	 */
 
-	if ( ((*c->reg8[al] & 0x0f) > 9) || CPU_FLAG_ISSET(c,f_af))
+	if ( ((CPU_REG8(c, al) & 0x0f) > 9) || CPU_FLAG_ISSET(c,f_af))
 	{
-		*c->reg8[al] = *c->reg8[al] + 6;
-		*c->reg8[ah] = *c->reg8[ah] + 1;
+		CPU_REG8(c, al) = CPU_REG8(c, al) + 6;
+		CPU_REG8(c, ah) = CPU_REG8(c, ah) + 1;
 		CPU_FLAG_SET(c,f_af);
 		CPU_FLAG_SET(c,f_cf);
 	}else
@@ -52,7 +52,7 @@ int32_t instr_aaa_37(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		CPU_FLAG_UNSET(c,f_af);
 		CPU_FLAG_UNSET(c,f_cf);
 	}
-	*c->reg8[al] = (*c->reg8[al] & 0x0f);
+	CPU_REG8(c, al) = (CPU_REG8(c, al) & 0x0f);
 
 	return 0;
 }
@@ -105,18 +105,8 @@ INSTR_SET_FLAG_CF(cpu, operation)
 
 
 
-#define TRACK_INIT_ALL_FLAGS(instruction_p) \
-TRACK_INIT_EFLAG(instruction_p, f_zf); \
-TRACK_INIT_EFLAG(instruction_p, f_pf); \
-TRACK_INIT_EFLAG(instruction_p, f_sf); \
-TRACK_INIT_EFLAG(instruction_p, f_of); \
-TRACK_INIT_EFLAG(instruction_p, f_cf); 
-
-
 int32_t instr_adc_10(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	/* 10 /r
 	 * Add with carry byte register to r/m8
 	 * ADC r/m8,r8     
@@ -128,7 +118,7 @@ int32_t instr_adc_10(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
 								 dst, 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
 								 dst, 
 								 +)
 		MEM_BYTE_WRITE(c, i->modrm.ea, dst);
@@ -137,9 +127,9 @@ int32_t instr_adc_10(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	{
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.rm], 
-								 *c->reg8[i->modrm.opc], 
-								 *c->reg8[i->modrm.rm], 
+								 CPU_REG8(c, i->modrm.rm), 
+								 CPU_REG8(c, i->modrm.opc), 
+								 CPU_REG8(c, i->modrm.rm), 
 								 +)
 	}
 
@@ -148,8 +138,6 @@ int32_t instr_adc_10(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_adc_11(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -163,7 +151,7 @@ int32_t instr_adc_11(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
 									 dst, 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.opc), 
 									 dst, 
 									 +)
 			MEM_WORD_WRITE(c, i->modrm.ea, dst);
@@ -195,9 +183,9 @@ int32_t instr_adc_11(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
-									 *c->reg16[i->modrm.opc], 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
+									 CPU_REG16(c, i->modrm.opc), 
+									 CPU_REG16(c, i->modrm.rm), 
 									 +)
 		}
 		else
@@ -220,8 +208,6 @@ int32_t instr_adc_11(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_adc_12(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	/* 12 /r
 	 * Add with carry r/m8 to byte register
 	 * ADC r8,r/m8     
@@ -235,17 +221,17 @@ int32_t instr_adc_12(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
 								 op, 
-								 *c->reg8[i->modrm.opc], 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
+								 CPU_REG8(c, i->modrm.opc), 
 								 +)
 	}
 	else
 	{
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.opc], 
-								 *c->reg8[i->modrm.rm], 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
+								 CPU_REG8(c, i->modrm.rm), 
+								 CPU_REG8(c, i->modrm.opc), 
 								 +)
 	}
 
@@ -254,8 +240,6 @@ int32_t instr_adc_12(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_adc_13(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -270,8 +254,8 @@ int32_t instr_adc_13(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
 									 op,
-									 *c->reg16[i->modrm.opc], 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.opc), 
+									 CPU_REG16(c, i->modrm.opc), 
 									 +)
 		}
 		else
@@ -301,9 +285,9 @@ int32_t instr_adc_13(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
-									 *c->reg16[i->modrm.opc], 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.rm), 
+									 CPU_REG16(c, i->modrm.opc), 
+									 CPU_REG16(c, i->modrm.opc), 
 									 +)
 		}
 		else
@@ -326,25 +310,21 @@ int32_t instr_adc_13(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_adc_14(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	/* 14 ib 
 	 * Add with carry imm8 to AL
 	 * ADC AL,imm8
 	 */
 	INSTR_CALC_AND_SET_FLAGS(8, 
 							 c, 
-							 *c->reg8[al], 
+							 CPU_REG8(c, al), 
 							 *i->imm8, 
-							 *c->reg8[al], 
+							 CPU_REG8(c, al), 
 							 +)
 	return 0;
 }
 
 int32_t instr_adc_15(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->prefixes & PREFIX_OPSIZE )
 	{
 		/* 15 iw
@@ -353,9 +333,9 @@ int32_t instr_adc_15(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */
 		INSTR_CALC_AND_SET_FLAGS(16, 
 								 c, 
-								 *c->reg16[ax], 
+								 CPU_REG16(c, ax), 
 								 *i->imm16, 
-								 *c->reg16[ax], 
+								 CPU_REG16(c, ax), 
 								 +)
 	}
 	else
@@ -378,8 +358,6 @@ int32_t instr_adc_15(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_1_80_adc(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if( i->modrm.mod != 3 )
 	{
 		uint8_t dst;
@@ -400,9 +378,9 @@ int32_t instr_group_1_80_adc(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		/* reg8[rm] <-- reg8[rm] <OPC> imm8 */
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.rm], 
+								 CPU_REG8(c, i->modrm.rm), 
 								 *i->imm8, 
-								 *c->reg8[i->modrm.rm],
+								 CPU_REG8(c, i->modrm.rm),
 								 +)
 	}
 
@@ -413,8 +391,6 @@ int32_t instr_group_1_80_adc(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_1_81_adc(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -471,9 +447,9 @@ int32_t instr_group_1_81_adc(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 *i->imm16, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 +)
 
 		}
@@ -499,8 +475,6 @@ int32_t instr_group_1_81_adc(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_1_83_adc(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -560,9 +534,9 @@ int32_t instr_group_1_83_adc(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			int16_t sexd = (int8_t)*i->imm8;
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 sexd, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 +)
 
 
@@ -46,18 +46,8 @@ INSTR_SET_FLAG_CF(cpu, operation)								\
 INSTR_SET_FLAG_OF(cpu, operation,bits)								
 
 
-#define TRACK_INIT_ALL_FLAGS(instruction_p) \
-TRACK_INIT_EFLAG(instruction_p, f_zf); \
-TRACK_INIT_EFLAG(instruction_p, f_pf); \
-TRACK_INIT_EFLAG(instruction_p, f_sf); \
-TRACK_INIT_EFLAG(instruction_p, f_cf); \
-TRACK_INIT_EFLAG(instruction_p, f_of); 
-
-
 int32_t instr_add_00(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	/* 00 /r
 	 * Add r8 to r/m8
 	 * ADD r/m8,r8     
@@ -69,7 +59,7 @@ int32_t instr_add_00(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
 								 dst, 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
 								 dst, 
 								 +)
 		MEM_BYTE_WRITE(c, i->modrm.ea, dst);
@@ -78,9 +68,9 @@ int32_t instr_add_00(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	{
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.rm], 
-								 *c->reg8[i->modrm.opc], 
-								 *c->reg8[i->modrm.rm], 
+								 CPU_REG8(c, i->modrm.rm), 
+								 CPU_REG8(c, i->modrm.opc), 
+								 CPU_REG8(c, i->modrm.rm), 
 								 +)
 	}
 
@@ -89,8 +79,6 @@ int32_t instr_add_00(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_add_01(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -104,7 +92,7 @@ int32_t instr_add_01(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
 									 dst, 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.opc), 
 									 dst, 
 									 +)
 			MEM_WORD_WRITE(c, i->modrm.ea, dst);
@@ -136,9 +124,9 @@ int32_t instr_add_01(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
-									 *c->reg16[i->modrm.opc], 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
+									 CPU_REG16(c, i->modrm.opc), 
+									 CPU_REG16(c, i->modrm.rm), 
 									 +)
 		}
 		else
@@ -161,8 +149,6 @@ int32_t instr_add_01(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_add_02(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	/* 02 /r
 	 * Add r/m8 to r8
 	 * ADD r8,r/m8
@@ -176,18 +162,18 @@ int32_t instr_add_02(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
 								 op, 
-								 *c->reg8[i->modrm.opc], 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
+								 CPU_REG8(c, i->modrm.opc), 
 								 +)
 	}
 	else
 	{
-//		*c->reg8[i->modrm.opc] += *c->reg8[i->modrm.rm];
+//		CPU_REG8(c, i->modrm.opc) += CPU_REG8(c, i->modrm.rm);
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.opc], 
-								 *c->reg8[i->modrm.rm], 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
+								 CPU_REG8(c, i->modrm.rm), 
+								 CPU_REG8(c, i->modrm.opc), 
 								 +)
 	}
 
@@ -196,8 +182,6 @@ int32_t instr_add_02(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_add_03(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {	
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -212,8 +196,8 @@ int32_t instr_add_03(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
 									 op,
-									 *c->reg16[i->modrm.opc], 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.opc), 
+									 CPU_REG16(c, i->modrm.opc), 
 									 +)
 		}
 		else
@@ -242,9 +226,9 @@ int32_t instr_add_03(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
-									 *c->reg16[i->modrm.opc], 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.rm), 
+									 CPU_REG16(c, i->modrm.opc), 
+									 CPU_REG16(c, i->modrm.opc), 
 									 +)
 		}
 		else
@@ -267,25 +251,21 @@ int32_t instr_add_03(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_add_04(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	/* 04 ib                    
 	 * Add imm8 to AL
 	 * ADD AL,imm8
 	 */
 	INSTR_CALC_AND_SET_FLAGS(8, 
 							 c, 
-							 *c->reg8[al], 
+							 CPU_REG8(c, al), 
 							 *i->imm8, 
-							 *c->reg8[al], 
+							 CPU_REG8(c, al), 
 							 +)
 	return 0;
 }
 
 int32_t instr_add_05(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->prefixes & PREFIX_OPSIZE )
 	{
 		/* 05 iw
@@ -294,9 +274,9 @@ int32_t instr_add_05(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */
 		INSTR_CALC_AND_SET_FLAGS(16, 
 								 c, 
-								 *c->reg16[ax], 
+								 CPU_REG16(c, ax), 
 								 *i->imm16, 
-								 *c->reg16[ax], 
+								 CPU_REG16(c, ax), 
 								 +)
 	}
 	else
@@ -319,8 +299,6 @@ int32_t instr_add_05(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_1_80_add(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if( i->modrm.mod != 3 )
 	{
 		uint8_t dst;
@@ -341,9 +319,9 @@ int32_t instr_group_1_80_add(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		/* reg8[rm] <-- reg8[rm] <OPC> imm8 */
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.rm], 
+								 CPU_REG8(c, i->modrm.rm), 
 								 *i->imm8, 
-								 *c->reg8[i->modrm.rm],
+								 CPU_REG8(c, i->modrm.rm),
 								 +)
 	}
 
@@ -357,8 +335,6 @@ int32_t instr_group_1_80_add(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_1_81_add(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -413,9 +389,9 @@ int32_t instr_group_1_81_add(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 *i->imm16, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 +)
 
 		}
@@ -442,8 +418,6 @@ int32_t instr_group_1_81_add(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_1_83_add(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -503,9 +477,9 @@ int32_t instr_group_1_83_add(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			int16_t sexd = (int8_t)*i->imm8;
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 sexd, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 +)
 
 		}
@@ -46,17 +46,8 @@ INSTR_SET_FLAG_PF(cpu)											\
 INSTR_SET_FLAG_SF(cpu)											
 
 
-#define TRACK_INIT_ALL_FLAGS(instruction_p) \
-TRACK_INIT_EFLAG(instruction_p, f_of); \
-TRACK_INIT_EFLAG(instruction_p, f_cf); \
-TRACK_INIT_EFLAG(instruction_p, f_zf); \
-TRACK_INIT_EFLAG(instruction_p, f_pf); \
-TRACK_INIT_EFLAG(instruction_p, f_sf); 
-
 int32_t instr_and_20(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	/* 20 /r
 	 * r/m8 AND r8
 	 * AND r/m8,r8  
@@ -69,7 +60,7 @@ int32_t instr_and_20(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
 								 dst, 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
 								 dst, 
 								 &)
 		MEM_BYTE_WRITE(c, i->modrm.ea, dst);
@@ -78,9 +69,9 @@ int32_t instr_and_20(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	{
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.rm], 
-								 *c->reg8[i->modrm.opc], 
-								 *c->reg8[i->modrm.rm], 
+								 CPU_REG8(c, i->modrm.rm), 
+								 CPU_REG8(c, i->modrm.opc), 
+								 CPU_REG8(c, i->modrm.rm), 
 								 &)
 	}
 
@@ -89,8 +80,6 @@ int32_t instr_and_20(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_and_21(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -105,7 +94,7 @@ int32_t instr_and_21(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
 									 dst, 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.opc), 
 									 dst, 
 									 &)
 			MEM_WORD_WRITE(c, i->modrm.ea, dst);
@@ -137,9 +126,9 @@ int32_t instr_and_21(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
-									 *c->reg16[i->modrm.opc], 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
+									 CPU_REG16(c, i->modrm.opc), 
+									 CPU_REG16(c, i->modrm.rm), 
 									 &)
 		}
 		else
@@ -162,8 +151,6 @@ int32_t instr_and_21(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_and_22(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	/* 22 /r
 	 * r8 AND r/m8
 	 * AND r8,r/m8     
@@ -177,17 +164,17 @@ int32_t instr_and_22(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
 								 op, 
-								 *c->reg8[i->modrm.opc], 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
+								 CPU_REG8(c, i->modrm.opc), 
 								 &)
 	}
 	else
 	{
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.opc], 
-								 *c->reg8[i->modrm.rm], 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
+								 CPU_REG8(c, i->modrm.rm), 
+								 CPU_REG8(c, i->modrm.opc), 
 								 &)
 	}
 
@@ -196,8 +183,6 @@ int32_t instr_and_22(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_and_23(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-	
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -213,8 +198,8 @@ int32_t instr_and_23(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
 									 op,
-									 *c->reg16[i->modrm.opc], 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.opc), 
+									 CPU_REG16(c, i->modrm.opc), 
 									 &)
 		}
 		else
@@ -245,9 +230,9 @@ int32_t instr_and_23(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
-									 *c->reg16[i->modrm.opc], 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.rm), 
+									 CPU_REG16(c, i->modrm.opc), 
+									 CPU_REG16(c, i->modrm.opc), 
 									 &)
 		}
 		else
@@ -270,8 +255,6 @@ int32_t instr_and_23(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_and_24(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	/* 24 ib
 	 * AL AND imm8
 	 * AND AL,imm8
@@ -279,17 +262,15 @@ int32_t instr_and_24(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 	INSTR_CALC_AND_SET_FLAGS(8, 
 							 c, 
-							 *c->reg8[eax], 
+							 CPU_REG8(c, eax), 
 							 *i->imm8, 
-							 *c->reg8[eax], 
+							 CPU_REG8(c, eax), 
 							 &)
 	return 0;
 }
 
 int32_t instr_and_25(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->prefixes & PREFIX_OPSIZE )
 	{
 		/* 25 iw    
@@ -298,9 +279,9 @@ int32_t instr_and_25(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */
 		INSTR_CALC_AND_SET_FLAGS(16, 
 								 c, 
-								 *c->reg16[ax], 
+								 CPU_REG16(c, ax), 
 								 *i->imm16, 
-								 *c->reg16[ax], 
+								 CPU_REG16(c, ax), 
 								 &)
 	}
 	else
@@ -323,8 +304,6 @@ int32_t instr_and_25(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_1_80_and(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if( i->modrm.mod != 3 )
 	{
 		uint8_t dst;
@@ -345,9 +324,9 @@ int32_t instr_group_1_80_and(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		/* reg8[rm] <-- reg8[rm] <OPC> imm8 */
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.rm], 
+								 CPU_REG8(c, i->modrm.rm), 
 								 *i->imm8, 
-								 *c->reg8[i->modrm.rm],
+								 CPU_REG8(c, i->modrm.rm),
 								 &)
 	}
 
@@ -357,8 +336,6 @@ int32_t instr_group_1_80_and(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_1_81_and(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -412,9 +389,9 @@ int32_t instr_group_1_81_and(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 *i->imm16, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 &)
 
 		}
@@ -439,8 +416,6 @@ int32_t instr_group_1_81_and(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_1_83_and(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {	
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -499,9 +474,9 @@ int32_t instr_group_1_83_and(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			int16_t sexd = (int8_t)*i->imm8;
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 sexd, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 &)
 
 		}
@@ -122,10 +122,9 @@ int32_t instr_group_5_ff_call(struct emu_cpu *c, struct emu_cpu_instruction *i)
 				 * Call near, absolute indirect, address given in r/m16   
 				 */
 
-				c->eip = *c->reg16[i->modrm.rm];
+				c->eip = CPU_REG16(c, i->modrm.rm);
 
 				SOURCE_NORM_POS(c->instr, c->eip);
-				TRACK_NEED_REG16(c->instr, i->modrm.rm);
 			}
 			else
 			{
@@ -137,7 +136,6 @@ int32_t instr_group_5_ff_call(struct emu_cpu *c, struct emu_cpu_instruction *i)
 				c->eip = c->reg[i->modrm.rm];
 
 				SOURCE_NORM_POS(c->instr, c->eip);
-				TRACK_NEED_REG32(c->instr, i->modrm.rm);
 			}
 		}
 	}
@@ -76,7 +76,7 @@ int32_t instr_cmp_38(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
 								 dst, 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
 								 -)
 //		MEM_BYTE_WRITE(c, i->modrm.ea, dst);
 	}
@@ -84,8 +84,8 @@ int32_t instr_cmp_38(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	{
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.rm], 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.rm), 
+								 CPU_REG8(c, i->modrm.opc), 
 								 -)
 	}
 	return 0;
@@ -107,7 +107,7 @@ int32_t instr_cmp_39(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
 									 dst, 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.opc), 
 									 -)
 //			MEM_WORD_WRITE(c, i->modrm.ea, dst);
 		}
@@ -139,8 +139,8 @@ int32_t instr_cmp_39(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.rm), 
+									 CPU_REG16(c, i->modrm.opc), 
 									 -)
 		}
 		else
@@ -176,7 +176,7 @@ int32_t instr_cmp_3a(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-                                 *c->reg8[i->modrm.opc], 
+                                 CPU_REG8(c, i->modrm.opc), 
 								 op, 
 								 -)
 	}
@@ -184,8 +184,8 @@ int32_t instr_cmp_3a(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	{
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.opc], 
-								 *c->reg8[i->modrm.rm], 
+								 CPU_REG8(c, i->modrm.opc), 
+								 CPU_REG8(c, i->modrm.rm), 
 								 -)
 	}
 
@@ -207,7 +207,7 @@ int32_t instr_cmp_3b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			MEM_WORD_READ(c, i->modrm.ea, &op);
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.opc), 
 									 op,
 									 -)
 		}
@@ -236,8 +236,8 @@ int32_t instr_cmp_3b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.opc], 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.opc), 
+									 CPU_REG16(c, i->modrm.rm), 
                                      -)
 		}
 		else
@@ -265,7 +265,7 @@ int32_t instr_cmp_3c(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	 */
 	INSTR_CALC_AND_SET_FLAGS(8, 
 							 c, 
-							 *c->reg8[al], 
+							 CPU_REG8(c, al), 
 							 *i->imm8, 
 							 -)
 	return 0;
@@ -281,7 +281,7 @@ int32_t instr_cmp_3d(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */
 		INSTR_CALC_AND_SET_FLAGS(16, 
 								 c, 
-								 *c->reg16[ax], 
+								 CPU_REG16(c, ax), 
 								 *i->imm16, 
 								 -)
 	}
@@ -326,7 +326,7 @@ int32_t instr_group_1_80_cmp(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		/* reg8[rm] <-- reg8[rm] <OPC> imm8 */
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.rm], 
+								 CPU_REG8(c, i->modrm.rm), 
 								 *i->imm8, 
 								 -)
 	}
@@ -382,7 +382,7 @@ int32_t instr_group_1_81_cmp(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 *i->imm16, 
 									 -)
 
@@ -484,7 +484,7 @@ int32_t instr_group_1_83_cmp(struct emu_cpu *c, struct emu_cpu_instruction *i)
 						
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm],
+									 CPU_REG16(c, i->modrm.rm),
 									 sexd,
 									 -)
 		}
@@ -81,7 +81,7 @@ int32_t instr_dec_4x(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 * Decrement r16 by 1
 		 * DEC r16 
 		 */
-		INSTR_CALC_AND_SET_FLAGS(16, c, *c->reg16[i->opc & 7])
+		INSTR_CALC_AND_SET_FLAGS(16, c, CPU_REG16(c, i->opc & 7))
 	}else
 	{
 		/* 48+rw
@@ -113,7 +113,7 @@ int32_t instr_group_4_fe_dec(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	}
 	else
 	{
-		INSTR_CALC_AND_SET_FLAGS(8, c, *c->reg8[i->modrm.rm])
+		INSTR_CALC_AND_SET_FLAGS(8, c, CPU_REG8(c, i->modrm.rm))
 	}
 	return 0;
 }
@@ -159,7 +159,7 @@ int32_t instr_group_5_ff_dec(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 * Decrement r/m16 by 1
 			 * DEC r/m16 
 			 */   
-			INSTR_CALC_AND_SET_FLAGS(16, c, *c->reg16[i->modrm.rm])
+			INSTR_CALC_AND_SET_FLAGS(16, c, CPU_REG16(c, i->modrm.rm))
 		}
 		else
 		{
@@ -33,8 +33,7 @@
 {\
 	if (divisor == 0) \
 	{ \
-		emu_strerror_set(cpu->emu,"div by zero (%i bits)\n",bits); \
-		emu_errno_set(cpu->emu,EINVAL); \
+		emu_error_set(cpu->emu,EINVAL,"div by zero (%i bits)\n",bits); \
 		return -1; \
 	} \
 	UINTOF(dbits) q_result = dividend / divisor; \
@@ -44,8 +43,7 @@
 	remainder = r_result; \
 	if ( q_result >  max_inttype_borders[bits/8][1][1]) \
 	{ \
-		emu_strerror_set(cpu->emu,"div quotient larger than intborder (%i bits)\n",bits); \
-		emu_errno_set(cpu->emu,EINVAL); \
+		emu_error_set(cpu->emu,EINVAL,"div quotient larger than intborder (%i bits)\n",bits); \
 		return -1; \
 	} \
 } 
@@ -72,10 +70,10 @@ int32_t instr_group_3_f6_div(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC(16, 
 				   8,
 				   c,
-				   *c->reg16[ax],
+				   CPU_REG16(c, ax),
 				   m8,
-				   *c->reg8[al],
-				   *c->reg8[ah])
+				   CPU_REG8(c, al),
+				   CPU_REG8(c, ah))
 	}
 	else
 	{
@@ -86,10 +84,10 @@ int32_t instr_group_3_f6_div(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC(16, 
 				   8,
 				   c,
-				   *c->reg16[ax],
-				   *c->reg8[i->modrm.rm],
-				   *c->reg8[al],
-				   *c->reg8[ah])
+				   CPU_REG16(c, ax),
+				   CPU_REG8(c, i->modrm.rm),
+				   CPU_REG8(c, al),
+				   CPU_REG8(c, ah))
 	}
 	return 0;
 }
@@ -108,15 +106,15 @@ int32_t instr_group_3_f7_div(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			MEM_WORD_READ(c, i->modrm.ea, &m16);
 
 			uint32_t dividend;
-			DWORD_FROM_WORDS(dividend,*c->reg16[dx],*c->reg16[ax]);
+			DWORD_FROM_WORDS(dividend,CPU_REG16(c, dx),CPU_REG16(c, ax));
 
 			INSTR_CALC(32, 
 					   16,
 					   c,
 					   dividend,
 					   m16,
-					   *c->reg16[ax],
-					   *c->reg16[dx])
+					   CPU_REG16(c, ax),
+					   CPU_REG16(c, dx))
 
 		}
 		else
@@ -150,15 +148,15 @@ int32_t instr_group_3_f7_div(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 
 			uint32_t dividend;
-			DWORD_FROM_WORDS(dividend,*c->reg16[dx],*c->reg16[ax]);
+			DWORD_FROM_WORDS(dividend,CPU_REG16(c, dx),CPU_REG16(c, ax));
 
 			INSTR_CALC(32, 
 					   16,
 					   c,
 					   dividend,
-					   *c->reg16[i->modrm.rm],
-					   *c->reg16[ax],
-					   *c->reg16[dx])
+					   CPU_REG16(c, i->modrm.rm),
+					   CPU_REG16(c, ax),
+					   CPU_REG16(c, dx))
 
 		}
 		else
@@ -34,7 +34,7 @@
 
 int32_t instr_group_1_80(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	static int32_t (*group_1_80_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
+	static int32_t (* const group_1_80_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
 		/* 0 */ instr_group_1_80_add,
 		/* 1 */ instr_group_1_80_or,
 		/* 2 */ instr_group_1_80_adc,
@@ -51,7 +51,7 @@ int32_t instr_group_1_80(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_group_1_81(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 
-	static int32_t (*group_1_81_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
+	static int32_t (* const group_1_81_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
 		/* 0 */ instr_group_1_81_add,
 		/* 1 */ instr_group_1_81_or,
 		/* 2 */ instr_group_1_81_adc,
@@ -72,7 +72,7 @@ int32_t instr_group_1_82(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_1_83(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	static int32_t (*group_1_83_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
+	static int32_t (* const group_1_83_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
 		/* 0 */ instr_group_1_83_add,
 		/* 1 */ instr_group_1_83_or,
 		/* 2 */ instr_group_1_83_adc,
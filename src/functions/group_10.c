@@ -63,7 +63,7 @@ int32_t instr_group_10_8f_pop(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_group_10_8f(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 
-	static int32_t (*group_10_8f_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
+	static int32_t (* const group_10_8f_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
 		/* 0 */ instr_group_10_8f_pop,
 		/* 1 */ NULL,
 		/* 2 */ NULL,
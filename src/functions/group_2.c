@@ -35,7 +35,7 @@
 
 int32_t instr_group_2_c0(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	static int32_t (*group_2_c0_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
+	static int32_t (* const group_2_c0_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
 		/* 0 */ instr_group_2_c0_rol,
 		/* 1 */ instr_group_2_c0_ror,
 		/* 2 */ instr_group_2_c0_rcl,
@@ -52,7 +52,7 @@ int32_t instr_group_2_c0(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_2_c1(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	static int32_t (*group_2_c1_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
+	static int32_t (* const group_2_c1_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
 		/* 0 */ instr_group_2_c1_rol,
 		/* 1 */ instr_group_2_c1_ror,
 		/* 2 */ instr_group_2_c1_rcl,
@@ -69,7 +69,7 @@ int32_t instr_group_2_c1(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_2_d0(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	static int32_t (*group_2_d0_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
+	static int32_t (* const group_2_d0_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
 		/* 0 */ instr_group_2_d0_rol,
 		/* 1 */ instr_group_2_d0_ror,
 		/* 2 */ instr_group_2_d0_rcl,
@@ -85,7 +85,7 @@ int32_t instr_group_2_d0(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_2_d1(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	static int32_t (*group_2_d1_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
+	static int32_t (* const group_2_d1_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
 		/* 0 */ instr_group_2_d1_rol,
 		/* 1 */ instr_group_2_d1_ror,
 		/* 2 */ instr_group_2_d1_rcl,
@@ -102,7 +102,7 @@ int32_t instr_group_2_d1(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_2_d2(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	static int32_t (*group_2_d2_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
+	static int32_t (* const group_2_d2_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
 		/* 0 */ instr_group_2_d2_rol,
 		/* 1 */ instr_group_2_d2_ror,
 		/* 2 */ instr_group_2_d2_rcl,
@@ -119,7 +119,7 @@ int32_t instr_group_2_d2(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_2_d3(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	static int32_t (*group_2_d3_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
+	static int32_t (* const group_2_d3_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
 		/* 0 */ instr_group_2_d3_rol,
 		/* 1 */ instr_group_2_d3_ror,
 		/* 2 */ instr_group_2_d3_rcl,
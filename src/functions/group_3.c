@@ -35,7 +35,7 @@
 
 int32_t instr_group_3_f6(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	static int32_t (*group_3_f6_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
+	static int32_t (* const group_3_f6_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
 		/* 0 */ instr_group_3_f6_test,
 		/* 1 */ instr_group_3_f6_test,
 		/* 2 */ instr_group_3_f6_not,
@@ -52,7 +52,7 @@ int32_t instr_group_3_f6(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_3_f7(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	static int32_t (*group_3_f7_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
+	static int32_t (* const group_3_f7_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
 		/* 0 */ instr_group_3_f7_test,
 		/* 1 */ instr_group_3_f7_test,
 		/* 2 */ instr_group_3_f7_not,
@@ -40,7 +40,7 @@
 
 int32_t instr_group_5_ff(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	static int32_t (*group_5_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
+	static int32_t (* const group_5_fn[8])(struct emu_cpu *c, struct emu_cpu_instruction *i) = {
 		/* 0 */ instr_group_5_ff_inc,
 		/* 1 */ instr_group_5_ff_dec,
 		/* 2 */ instr_group_5_ff_call,
@@ -32,8 +32,7 @@
 {\
 	if (divisor == 0) \
 	{ \
-		emu_strerror_set(cpu->emu,"div by zero (%i bits)\n",bits); \
-		emu_errno_set(cpu->emu,EINVAL); \
+		emu_error_set(cpu->emu,EINVAL,"div by zero (%i bits)\n",bits); \
 		return -1; \
 	} \
 	INTOF(dbits) q_result = (INTOF(dbits))dividend / (INTOF(bits))divisor; \
@@ -44,8 +43,7 @@
 	if ( q_result < max_inttype_borders[bits/8][0][0] || \
 		 q_result > max_inttype_borders[bits/8][0][1] ) \
 	{ \
-		emu_strerror_set(cpu->emu,"div quotient larger than intborder (%i bits)\n",bits); \
-		emu_errno_set(cpu->emu,EINVAL); \
+		emu_error_set(cpu->emu,EINVAL,"div quotient larger than intborder (%i bits)\n",bits); \
 		return -1; \
 	} \
 }
@@ -72,10 +70,10 @@ int32_t instr_group_3_f6_idiv(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC(16, 
 				   8,
 				   c,
-				   *c->reg16[ax],
+				   CPU_REG16(c, ax),
 				   m8,
-				   *c->reg8[al],
-				   *c->reg8[ah])
+				   CPU_REG8(c, al),
+				   CPU_REG8(c, ah))
 	}
 	else
 	{
@@ -86,10 +84,10 @@ int32_t instr_group_3_f6_idiv(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC(16, 
 				   8,
 				   c,
-				   *c->reg16[ax],
-				   *c->reg8[i->modrm.rm],
-				   *c->reg8[al],
-				   *c->reg8[ah])
+				   CPU_REG16(c, ax),
+				   CPU_REG8(c, i->modrm.rm),
+				   CPU_REG8(c, al),
+				   CPU_REG8(c, ah))
 
 	}
 	return 0;
@@ -110,15 +108,15 @@ int32_t instr_group_3_f7_idiv(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			MEM_WORD_READ(c, i->modrm.ea, &m16);
 
 			uint32_t dividend;
-			DWORD_FROM_WORDS(dividend,*c->reg16[dx],*c->reg16[ax]);
+			DWORD_FROM_WORDS(dividend,CPU_REG16(c, dx),CPU_REG16(c, ax));
 
 			INSTR_CALC(32, 
 					   16,
 					   c,
 					   dividend,
 					   m16,
-					   *c->reg16[ax],
-					   *c->reg16[dx])
+					   CPU_REG16(c, ax),
+					   CPU_REG16(c, dx))
 
 		}
 		else
@@ -151,15 +149,15 @@ int32_t instr_group_3_f7_idiv(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 * IDIV r/m16 
 			 */
 			uint32_t dividend;
-			DWORD_FROM_WORDS(dividend,*c->reg16[dx],*c->reg16[ax]);
+			DWORD_FROM_WORDS(dividend,CPU_REG16(c, dx),CPU_REG16(c, ax));
 
 			INSTR_CALC(32, 
 					   16,
 					   c,
 					   dividend,
-					   *c->reg16[i->modrm.rm],
-					   *c->reg16[ax],
-					   *c->reg16[dx])
+					   CPU_REG16(c, i->modrm.rm),
+					   CPU_REG16(c, ax),
+					   CPU_REG16(c, dx))
 
 		}
 		else
@@ -82,7 +82,7 @@ int32_t instr_imul_69(struct emu_cpu *c, struct emu_cpu_instruction *i)
 					   m16,
 					   sexd) 
 
-			*c->reg16[i->modrm.opc] = operation_result;
+			CPU_REG16(c, i->modrm.opc) = operation_result;
 
 			uint8_t high;
 			WORD_UPPER_TO_BYTE(high,operation_result);
@@ -138,9 +138,9 @@ int32_t instr_imul_69(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC(16,
 					   32,
 					   c, 
-					   *c->reg16[i->modrm.rm],
+					   CPU_REG16(c, i->modrm.rm),
 					   sexd)
-			*c->reg16[i->modrm.opc] = operation_result;
+			CPU_REG16(c, i->modrm.opc) = operation_result;
 
 			uint8_t high;
 			WORD_UPPER_TO_BYTE(high,operation_result);
@@ -196,7 +196,7 @@ int32_t instr_imul_6b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 					   m16,
 					   sexd) 
 
-			*c->reg16[i->modrm.opc] = operation_result;
+			CPU_REG16(c, i->modrm.opc) = operation_result;
 
 			uint8_t high;
 			WORD_UPPER_TO_BYTE(high,operation_result);
@@ -243,9 +243,9 @@ int32_t instr_imul_6b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC(16,
 					   32,
 					   c, 
-					   *c->reg16[i->modrm.rm],
+					   CPU_REG16(c, i->modrm.rm),
 					   sexd)
-			*c->reg16[i->modrm.opc] = operation_result;
+			CPU_REG16(c, i->modrm.opc) = operation_result;
 
 			uint8_t high;
 			WORD_UPPER_TO_BYTE(high,operation_result);
@@ -294,10 +294,10 @@ int32_t instr_imul_0f_af(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC(16,
 					   32,
 					   c, 
-					   *c->reg16[i->modrm.opc],
+					   CPU_REG16(c, i->modrm.opc),
 					   m16)
 
-			*c->reg16[i->modrm.opc] = operation_result;
+			CPU_REG16(c, i->modrm.opc) = operation_result;
 
 			uint8_t high;
 			WORD_UPPER_TO_BYTE(high,operation_result);
@@ -336,10 +336,10 @@ int32_t instr_imul_0f_af(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC(16,
 					   32,
 					   c, 
-					   *c->reg16[i->modrm.opc],
-					   *c->reg16[i->modrm.rm])
+					   CPU_REG16(c, i->modrm.opc),
+					   CPU_REG16(c, i->modrm.rm))
 
-			*c->reg16[i->modrm.opc] = operation_result;
+			CPU_REG16(c, i->modrm.opc) = operation_result;
 
 			uint8_t high;
 			WORD_UPPER_TO_BYTE(high,operation_result);
@@ -383,9 +383,9 @@ int32_t instr_group_3_f6_imul(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC(8, 
 				   16,
 				   c,
-				   *c->reg8[al],
+				   CPU_REG8(c, al),
 				   m8)
-		*c->reg16[ax] = operation_result;
+		CPU_REG16(c, ax) = operation_result;
 		uint8_t high;
 		WORD_UPPER_TO_BYTE(high,operation_result);
 		INSTR_SET_FLAGS(c,high);
@@ -399,10 +399,10 @@ int32_t instr_group_3_f6_imul(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC(8,
 				   16,
 				   c,
-				   *c->reg8[al],
-				   *c->reg8[i->modrm.rm])
+				   CPU_REG8(c, al),
+				   CPU_REG8(c, i->modrm.rm))
 
-		*c->reg16[ax] = operation_result;
+		CPU_REG16(c, ax) = operation_result;
 		uint8_t high;
 		WORD_UPPER_TO_BYTE(high,operation_result);
 		INSTR_SET_FLAGS(c,high);
@@ -425,13 +425,13 @@ int32_t instr_group_3_f7_imul(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC(16,
 					   32,
 					   c,
-					   *c->reg16[al],
+					   CPU_REG16(c, al),
 					   m16)
 
-			DWORD_UPPER_TO_WORD(*c->reg16[dx],operation_result);
-			DWORD_LOWER_TO_WORD(*c->reg16[ax],operation_result);
+			DWORD_UPPER_TO_WORD(CPU_REG16(c, dx),operation_result);
+			DWORD_LOWER_TO_WORD(CPU_REG16(c, ax),operation_result);
 
-			INSTR_SET_FLAGS(c,*c->reg16[dx]);
+			INSTR_SET_FLAGS(c,CPU_REG16(c, dx));
 		}
 		else
 		{
@@ -465,12 +465,12 @@ int32_t instr_group_3_f7_imul(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC(16,
 					   32,
 					   c,
-					   *c->reg16[al],
-					   *c->reg16[i->modrm.rm])
-			DWORD_UPPER_TO_WORD(*c->reg16[dx],operation_result);
-			DWORD_LOWER_TO_WORD(*c->reg16[ax],operation_result);
+					   CPU_REG16(c, al),
+					   CPU_REG16(c, i->modrm.rm))
+			DWORD_UPPER_TO_WORD(CPU_REG16(c, dx),operation_result);
+			DWORD_LOWER_TO_WORD(CPU_REG16(c, ax),operation_result);
 
-			INSTR_SET_FLAGS(c,*c->reg16[dx]);
+			INSTR_SET_FLAGS(c,CPU_REG16(c, dx));
 
 		}
 		else
@@ -81,7 +81,7 @@ int32_t instr_inc_4x(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 * Increment word register by 1
 		 * INC r16 
 		 */
-		INSTR_CALC_AND_SET_FLAGS(16, c, *c->reg16[i->opc & 7])
+		INSTR_CALC_AND_SET_FLAGS(16, c, CPU_REG16(c, i->opc & 7))
 	}else
 	{
 		/* 40+ rd 
@@ -112,7 +112,7 @@ int32_t instr_group_4_fe_inc(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	}
 	else
 	{
-		INSTR_CALC_AND_SET_FLAGS(8, c, *c->reg8[i->modrm.rm])
+		INSTR_CALC_AND_SET_FLAGS(8, c, CPU_REG8(c, i->modrm.rm))
 	}
 	return 0;
 }
@@ -157,7 +157,7 @@ int32_t instr_group_5_ff_inc(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 * Increment r/m word by 1
 			 * INC r/m16 
 			 */   
-			INSTR_CALC_AND_SET_FLAGS(16, c, *c->reg16[i->modrm.rm])
+			INSTR_CALC_AND_SET_FLAGS(16, c, CPU_REG16(c, i->modrm.rm))
 		}
 		else
 		{
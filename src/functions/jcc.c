@@ -53,7 +53,6 @@
 int32_t instr_jcc_70(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_of);
 
 	/* 70 cb       Jump short if overflow (OF=1)                           JO rel8         */
 	if (OF_IS_ONE(c))
@@ -66,7 +65,6 @@ int32_t instr_jcc_70(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_71(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_of);
 
 	/* 71 cb       Jump short if not overflow (OF=0)                       JNO rel8        */
 	if (OF_IS_ZERO(c))
@@ -79,7 +77,6 @@ int32_t instr_jcc_71(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_72(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_cf);
 
 	/* 72 cb       Jump short if below (CF=1)                              JB rel8         */
 	/* 72 cb       Jump short if carry (CF=1)                              JC rel8         */
@@ -94,7 +91,6 @@ int32_t instr_jcc_72(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_73(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_cf);
 
 	/* 73 cb       Jump short if above or equal (CF=0)                     JAE rel8        */
 	/* 73 cb       Jump short if not below (CF=0)                          JNB rel8        */
@@ -110,15 +106,13 @@ int32_t instr_jcc_73(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_setcc_0f94(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
     uint8_t b;
-	TRACK_NEED_EFLAG(c->instr, f_zf);
 	b = ZF_IS_ONE(c) ? 1 : 0;
 
 	/* 0f 94 sete r/m8 Set byte if equal (ZF = 1) */
 	if (i->modrm.mod != 3) {
 	    MEM_BYTE_WRITE(c, i->modrm.ea, b);
 	} else {
-	    *c->reg8[i->modrm.rm] = b;
-	    TRACK_INIT_REG8(c->instr, i->modrm.rm);
+	    CPU_REG8(c, i->modrm.rm) = b;
 	}
 	return 0;
 }
@@ -126,15 +120,13 @@ int32_t instr_setcc_0f94(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_setcc_0f95(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
     uint8_t b;
-	TRACK_NEED_EFLAG(c->instr, f_zf);
 	b = ZF_IS_ZERO(c) ? 1 : 0;
 
 	/* 0f 94 setne r/m8 Set byte if not equal (ZF = 0) */
 	if (i->modrm.mod != 3) {
 	    MEM_BYTE_WRITE(c, i->modrm.ea, b);
 	} else {
-	    *c->reg8[i->modrm.rm] = b;
-	    TRACK_INIT_REG8(c->instr, i->modrm.rm);
+	    CPU_REG8(c, i->modrm.rm) = b;
 	}
 	return 0;
 }
@@ -142,7 +134,6 @@ int32_t instr_setcc_0f95(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_74(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_zf);
 
 	/* 74 cb       Jump short if equal (ZF=1)                              JE rel8         */
 	/* 74 cb       Jump short if zero (ZF = 1)                             JZ rel8         */
@@ -157,7 +148,6 @@ int32_t instr_jcc_74(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_75(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_zf);
 
 	/* 75 cb       Jump short if not equal (ZF=0)                          JNE rel8        */
 	/* 75 cb       Jump short if not zero (ZF=0)                           JNZ rel8        */
@@ -172,8 +162,6 @@ int32_t instr_jcc_75(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_76(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_cf);
-	TRACK_NEED_EFLAG(c->instr, f_zf);
 
 	/* 76 cb       Jump short if below or equal (CF=1 or ZF=1)             JBE rel8        */
 	/* 76 cb       Jump short if not above (CF=1 or ZF=1)                  JNA rel8        */
@@ -188,8 +176,6 @@ int32_t instr_jcc_76(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_77(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_cf);
-	TRACK_NEED_EFLAG(c->instr, f_zf);
 
     /* 77 cb       Jump short if above (CF=0 and ZF=0)                     JA rel8         */
 	/* 77 cb       Jump short if not below or equal (CF=0 and ZF=0)        JNBE rel8       */
@@ -205,7 +191,6 @@ int32_t instr_jcc_77(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_78(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_sf);
 
 	/* 78 cb       Jump short if sign (SF=1)                               JS rel8         */
 	if (SF_IS_ONE(c))
@@ -219,7 +204,6 @@ int32_t instr_jcc_78(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_79(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_sf);
 
 	/* 79 cb       Jump short if not sign (SF=0)                           JNS rel8        */
 	if (SF_IS_ZERO(c))
@@ -233,7 +217,6 @@ int32_t instr_jcc_79(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_7a(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_pf);
 
 	/* 7A cb       Jump short if parity even (PF=1)                        JPE rel8        */
 	/* 7A cb       Jump short if parity (PF=1)                             JP rel8         */
@@ -248,7 +231,6 @@ int32_t instr_jcc_7a(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_7b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_pf);
 
 	/* 7B cb       Jump short if not parity (PF=0)                         JNP rel8        */
 	/* 7B cb       Jump short if parity odd (PF=0)                         JPO rel8        */
@@ -264,8 +246,6 @@ int32_t instr_jcc_7b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_7c(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_sf);
-	TRACK_NEED_EFLAG(c->instr, f_of);
 
 	/* 7C cb       Jump short if less (SF<>OF)                             JL rel8         */
 	/* 7C cb       Jump short if not greater or equal (SF<>OF)             JNGE rel8       */
@@ -281,8 +261,6 @@ int32_t instr_jcc_7c(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_7d(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_sf);
-	TRACK_NEED_EFLAG(c->instr, f_of);
 
 	/* 7D cb       Jump short if greater or equal (SF=OF)                  JGE rel8        */
 	/* 7D cb       Jump short if not less (SF=OF)                          JNL rel8        */
@@ -297,9 +275,6 @@ int32_t instr_jcc_7d(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_7e(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_zf);
-	TRACK_NEED_EFLAG(c->instr, f_sf);
-	TRACK_NEED_EFLAG(c->instr, f_of);
 
 	/* 7E cb       Jump short if less or equal (ZF=1 or SF<>OF)            JLE rel8        */
 	/* 7E cb       Jump short if not greater (ZF=1 or SF<>OF)              JNG rel8        */
@@ -315,9 +290,6 @@ int32_t instr_jcc_7e(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_7f(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_zf);
-	TRACK_NEED_EFLAG(c->instr, f_sf);
-	TRACK_NEED_EFLAG(c->instr, f_of);
 
 	/* 7F cb       Jump short if greater (ZF=0 and SF=OF)                  JG rel8         */
 	/* 7F cb       Jump short if not less or equal (ZF=0 and SF=OF)        JNLE rel8       */
@@ -338,14 +310,12 @@ int32_t instr_jcc_e3(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	/* E3 cb       Jump short if ECX register is 0                         JECXZ rel8      */
 	if ( i->prefixes & PREFIX_OPSIZE )
 	{
-		TRACK_NEED_REG16(c->instr, cx);
-		if (*c->reg16[cx] == 0)
+		if (CPU_REG16(c, cx) == 0)
 		{
 			c->eip += i->disp;		
 		}
 	}else
 	{
-		TRACK_NEED_REG32(c->instr, ecx);
 		if (c->reg[ecx] == 0)
 		{
 			c->eip += i->disp;		
@@ -358,7 +328,6 @@ int32_t instr_jcc_e3(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_0f80(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_of);
 
 	/* 0F 80 cw/cd  Jump near if overflow (OF=1)                           JO rel16/32     */
 	if (OF_IS_ONE(c))
@@ -372,7 +341,6 @@ int32_t instr_jcc_0f80(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_0f81(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_of);
 
 	/* 0F 81 cw/cd  Jump near if not overflow (OF=0)                       JNO rel16/32    */
 	if (OF_IS_ZERO(c))
@@ -386,7 +354,6 @@ int32_t instr_jcc_0f81(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_0f82(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_cf);
 
 	/* 0F 82 cw/cd  Jump near if below (CF=1)                              JB rel16/32     */
 	/* 0F 82 cw/cd  Jump near if carry (CF=1)                              JC rel16/32     */
@@ -402,7 +369,6 @@ int32_t instr_jcc_0f82(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_0f83(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_cf);
 
 	/* 0F 83 cw/cd  Jump near if above or equal (CF=0)                     JAE rel16/32    */
 	/* 0F 83 cw/cd  Jump near if not below (CF=0)                          JNB rel16/32    */
@@ -418,7 +384,6 @@ int32_t instr_jcc_0f83(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_0f84(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_zf);
 
 	/* 0F 84 cw/cd  Jump near if equal (ZF=1)                              JE rel16/32     */
 	/* 0F 84 cw/cd  Jump near if zero (ZF=1)                               JZ rel16/32     */
@@ -433,7 +398,6 @@ int32_t instr_jcc_0f84(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_0f85(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_zf);
 
 	/* 0F 85 cw/cd  Jump near if not equal (ZF=0)                          JNE rel16/32    */
 	/* 0F 85 cw/cd  Jump near if not zero (ZF=0)                           JNZ rel16/32    */
@@ -448,8 +412,6 @@ int32_t instr_jcc_0f85(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_0f86(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_cf);
-	TRACK_NEED_EFLAG(c->instr, f_zf);
 
 	/* 0F 86 cw/cd  Jump near if below or equal (CF=1 or ZF=1)             JBE rel16/32    */
 	/* 0F 86 cw/cd  Jump near if not above (CF=1 or ZF=1)                  JNA rel16/32    */
@@ -464,8 +426,6 @@ int32_t instr_jcc_0f86(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_0f87(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_cf);
-	TRACK_NEED_EFLAG(c->instr, f_zf);
 
 	/* 0F 87 cw/cd  Jump near if above (CF=0 and ZF=0)                     JA rel16/32     */
 	/* 0F 87 cw/cd  Jump near if not below or equal (CF=0 and ZF=0)        JNBE rel16/32   */
@@ -481,7 +441,6 @@ int32_t instr_jcc_0f87(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_0f88(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_sf);
 
 	/* 0F 88 cw/cd  Jump near if sign (SF=1)                               JS rel16/32     */
 	if (SF_IS_ONE(c))
@@ -495,7 +454,6 @@ int32_t instr_jcc_0f88(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_0f89(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_sf);
 
 	/* 0F 89 cw/cd  Jump near if not sign (SF=0)                           JNS rel16/32    */
 	if (SF_IS_ZERO(c))
@@ -509,7 +467,6 @@ int32_t instr_jcc_0f89(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_0f8a(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_pf);
 
 	/* 0F 8A cw/cd  Jump near if parity even (PF=1)                        JPE rel16/32    */
 	/* 0F 8A cw/cd  Jump near if parity (PF=1)                             JP rel16/32     */
@@ -524,7 +481,6 @@ int32_t instr_jcc_0f8a(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_0f8b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_pf);
 
 	/* 0F 8B cw/cd  Jump near if not parity (PF=0)                         JNP rel16/32    */
 	/* 0F 8B cw/cd  Jump near if parity odd (PF=0)                         JPO rel16/32    */
@@ -539,8 +495,6 @@ int32_t instr_jcc_0f8b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_0f8c(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_sf);
-	TRACK_NEED_EFLAG(c->instr, f_of);
 
 	/* 0F 8C cw/cd  Jump near if less (SF<>OF)                             JL rel16/32     */
 	/* 0F 8C cw/cd  Jump near if not greater or equal (SF<>OF)             JNGE rel16/32   */
@@ -555,8 +509,6 @@ int32_t instr_jcc_0f8c(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_0f8d(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_sf);
-	TRACK_NEED_EFLAG(c->instr, f_of);
 
 	/* 0F 8D cw/cd  Jump near if greater or equal (SF=OF)                  JGE rel16/32    */
 	/* 0F 8D cw/cd  Jump near if not less (SF=OF)                          JNL rel16/32    */
@@ -571,9 +523,6 @@ int32_t instr_jcc_0f8d(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_0f8e(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_zf);
-	TRACK_NEED_EFLAG(c->instr, f_sf);
-	TRACK_NEED_EFLAG(c->instr, f_of);
 
 	/* 0F 8E cw/cd  Jump near if less or equal (ZF=1 or SF<>OF)            JLE rel16/32    */
 	/* 0F 8E cw/cd  Jump near if not greater (ZF=1 or SF<>OF)              JNG rel16/32    */
@@ -588,9 +537,6 @@ int32_t instr_jcc_0f8e(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_jcc_0f8f(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	SOURCE_COND_POS(c->instr, c->eip + i->disp);
-	TRACK_NEED_EFLAG(c->instr, f_zf);
-	TRACK_NEED_EFLAG(c->instr, f_sf);
-	TRACK_NEED_EFLAG(c->instr, f_of);
 
 	/* 0F 8F cw/cd  Jump near if greater (ZF=0 and SF=OF)                  JG rel16/32     */
 	/* 0F 8F cw/cd  Jump near if not less or equal (ZF=0 and SF=OF)        JNLE rel16/32   */
@@ -134,10 +134,9 @@ int32_t instr_group_5_ff_jmp(struct emu_cpu *c, struct emu_cpu_instruction *i)
 				 * JMP r/m16    
 				 */
 
-				c->eip = *c->reg16[i->modrm.rm];
+				c->eip = CPU_REG16(c, i->modrm.rm);
 
 				SOURCE_NORM_POS(c->instr, c->eip);
-				TRACK_NEED_REG16(c->instr, i->modrm.rm);
 			}
 			else
 			{
@@ -149,7 +148,6 @@ int32_t instr_group_5_ff_jmp(struct emu_cpu *c, struct emu_cpu_instruction *i)
 				c->eip = c->reg[i->modrm.rm];
 
 				SOURCE_NORM_POS(c->instr, c->eip);
-				TRACK_NEED_REG32(c->instr, i->modrm.rm);
 			}
 		}
 	}
@@ -50,12 +50,12 @@ int32_t instr_lods_ac(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 	if ( i->prefixes & PREFIX_ADSIZE )
 	{
-//    	MEM_BYTE_READ(c, c->reg16[si], c->reg8[al]);
+//    	MEM_BYTE_READ(c, &CPU_REG16(c, si), &CPU_REG8(c, al));
 		UNIMPLEMENTED(c, SST);
 	}
 	else
 	{
-		MEM_BYTE_READ(c, c->reg[esi], c->reg8[al]);
+		MEM_BYTE_READ(c, c->reg[esi], &CPU_REG8(c, al));
 
 		if ( CPU_FLAG_ISSET(c,f_df) )
 		{ /* decrement */
@@ -65,8 +65,6 @@ int32_t instr_lods_ac(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		{ /* increment */
 			c->reg[esi] += 1;
 		}
-
-		TRACK_INIT_REG8(c->instr, al);
 	}
 
 
@@ -90,12 +88,12 @@ int32_t instr_lods_ad(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */
 		if ( i->prefixes & PREFIX_ADSIZE )
 		{
-//        	MEM_WORD_READ(c, c->reg16[si], c->reg16[ax]);
+//        	MEM_WORD_READ(c, &CPU_REG16(c, si), &CPU_REG16(c, ax));
 			UNIMPLEMENTED(c, SST);
 		}
 		else
 		{
-			MEM_WORD_READ(c, c->reg[esi], c->reg16[ax]);
+			MEM_WORD_READ(c, c->reg[esi], &CPU_REG16(c, ax));
 			if (CPU_FLAG_ISSET(c,f_df))
 			{ /* decrement */
 				c->reg[esi] -= 2;
@@ -121,7 +119,7 @@ int32_t instr_lods_ad(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */
 		if ( i->prefixes & PREFIX_ADSIZE )
 		{
-//			MEM_DWORD_READ(c, c->reg16[si], &c->reg[eax]);
+//			MEM_DWORD_READ(c, &CPU_REG16(c, si), &c->reg[eax]);
 			UNIMPLEMENTED(c, SST);
 
 		}
@@ -135,8 +133,6 @@ int32_t instr_lods_ad(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			{ /* increment */
 				c->reg[esi] += 4;
 			}
-
-			TRACK_INIT_REG32(c->instr, eax);
 		}
 	}
 
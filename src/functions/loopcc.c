@@ -44,19 +44,13 @@ int32_t instr_loopcc_e0(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	 */
 	if ( i->prefixes & PREFIX_OPSIZE)
 	{
-		TRACK_NEED_REG16(c->instr, cx);
-		TRACK_NEED_EFLAG(c->instr, f_zf);
-
-		*c->reg16[cx] = *c->reg16[cx]-1;
-		if (*c->reg16[cx] != 0 && !CPU_FLAG_ISSET(c,f_zf))
+		CPU_REG16(c, cx) = CPU_REG16(c, cx)-1;
+		if (CPU_REG16(c, cx) != 0 && !CPU_FLAG_ISSET(c,f_zf))
 		{
 			c->eip += i->disp;
 		}
 	}else
 	{
-		TRACK_NEED_REG32(c->instr, ecx);
-		TRACK_NEED_EFLAG(c->instr, f_zf);
-
 		c->reg[ecx]--;
 		if (c->reg[ecx] != 0 && !CPU_FLAG_ISSET(c,f_zf))
 		{
@@ -79,19 +73,13 @@ int32_t instr_loopcc_e1(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	 */				   
 	if ( i->prefixes & PREFIX_OPSIZE)
 	{
-		TRACK_NEED_REG16(c->instr, cx);
-		TRACK_NEED_EFLAG(c->instr, f_zf);
-
-		*c->reg16[cx] = *c->reg16[cx]-1;
-		if (*c->reg16[cx] != 0 && CPU_FLAG_ISSET(c,f_zf))
+		CPU_REG16(c, cx) = CPU_REG16(c, cx)-1;
+		if (CPU_REG16(c, cx) != 0 && CPU_FLAG_ISSET(c,f_zf))
 		{
 			c->eip += i->disp;
 		}
 	}else
 	{
-		TRACK_NEED_REG32(c->instr, ecx);
-		TRACK_NEED_EFLAG(c->instr, f_zf);
-
 		c->reg[ecx]--;
 		if (c->reg[ecx] != 0 && CPU_FLAG_ISSET(c,f_zf))
 		{
@@ -114,17 +102,13 @@ int32_t instr_loop_e2(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 	if ( i->prefixes & PREFIX_OPSIZE)
 	{
-		TRACK_NEED_REG16(c->instr, cx);
-
-		*c->reg16[cx] = *c->reg16[cx]-1;
-		if (*c->reg16[cx] != 0 )
+		CPU_REG16(c, cx) = CPU_REG16(c, cx)-1;
+		if (CPU_REG16(c, cx) != 0 )
 		{
 			c->eip += i->disp;
 		}
 	}else
 	{
-		TRACK_NEED_REG32(c->instr, ecx);
-
 		c->reg[ecx]--;
 		if (c->reg[ecx] != 0)
 		{
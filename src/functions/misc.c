@@ -215,7 +215,6 @@ int32_t instr_lea_8d(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 * LEA r32,m 
 		 */
 		c->reg[i->modrm.opc] = i->modrm.ea;
-		TRACK_INIT_REG32(c->instr, i->modrm.opc);
 	}
 	return 0;
 
@@ -232,7 +231,7 @@ int32_t instr_cbw_98(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 * AX <- sign-extend of AL
 		 * CBW  
 		 */
-		*c->reg16[ax] = (int8_t)*c->reg8[al];
+		CPU_REG16(c, ax) = (int8_t)CPU_REG8(c, al);
 	}
 	else
 	{
@@ -240,7 +239,7 @@ int32_t instr_cbw_98(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 * EAX <- sign-extend of AX
 		 * CWDE 
 		 */
-		c->reg[eax] = (int16_t)*c->reg16[ax];
+		c->reg[eax] = (int16_t)CPU_REG16(c, ax);
 	}
 	return 0;
 }
@@ -258,9 +257,9 @@ int32_t instr_cwd_99(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 * CWD 
 		 */
 		uint32_t sexd; 
-		sexd = (int16_t)*c->reg16[ax];
-		DWORD_UPPER_TO_WORD(*c->reg16[dx],sexd);
-		DWORD_LOWER_TO_WORD(*c->reg16[ax],sexd);
+		sexd = (int16_t)CPU_REG16(c, ax);
+		DWORD_UPPER_TO_WORD(CPU_REG16(c, dx),sexd);
+		DWORD_LOWER_TO_WORD(CPU_REG16(c, ax),sexd);
 		
 	}
 	else
@@ -303,7 +302,7 @@ int32_t instr_sldt_0f00(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		}
 		else
 		{
-			*c->reg16[i->modrm.rm] = 0;
+			CPU_REG16(c, i->modrm.rm) = 0;
 		}
 	}
 	else
@@ -335,9 +334,9 @@ int32_t instr_cpuid_0fa2(struct emu_cpu *c, struct emu_cpu_instruction *i)
 int32_t instr_salc_d6(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
 	if( CPU_FLAG_ISSET(c, f_cf) )
-		*c->reg8[al] = 0xff;
+		CPU_REG8(c, al) = 0xff;
 	else
-		*c->reg8[al] = 0;
+		CPU_REG8(c, al) = 0;
 	return 0;
 }
 
@@ -47,11 +47,11 @@ int32_t instr_mov_88(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 	if( i->modrm.mod != 3 )
 	{
-		MEM_BYTE_WRITE(c, i->modrm.ea, *c->reg8[i->modrm.opc]);
+		MEM_BYTE_WRITE(c, i->modrm.ea, CPU_REG8(c, i->modrm.opc));
 	}
 	else
 	{
-		*c->reg8[i->modrm.rm] = *c->reg8[i->modrm.opc];
+		CPU_REG8(c, i->modrm.rm) = CPU_REG8(c, i->modrm.opc);
 	}
 
 	return 0;
@@ -75,11 +75,11 @@ int32_t instr_mov_89(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	{
 		if( i->modrm.mod != 3 )
 		{
-			MEM_WORD_WRITE(c, i->modrm.ea, *c->reg16[i->modrm.opc]);
+			MEM_WORD_WRITE(c, i->modrm.ea, CPU_REG16(c, i->modrm.opc));
 		}
 		else
 		{
-			*c->reg16[i->modrm.rm] = *c->reg16[i->modrm.opc];
+			CPU_REG16(c, i->modrm.rm) = CPU_REG16(c, i->modrm.opc);
 		}
 	}
 	else
@@ -91,9 +91,6 @@ int32_t instr_mov_89(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		else
 		{
 			c->reg[i->modrm.rm] = c->reg[i->modrm.opc];
-
-			TRACK_NEED_REG32(c->instr, i->modrm.opc);
-			TRACK_INIT_REG32(c->instr, i->modrm.rm);
 		}
 	}
 
@@ -109,12 +106,11 @@ int32_t instr_mov_8a(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 	if( i->modrm.mod != 3 )
 	{
-		MEM_BYTE_READ(c, i->modrm.ea, c->reg8[i->modrm.opc]);
-		TRACK_INIT_REG16(c->instr, i->modrm.opc);
+		MEM_BYTE_READ(c, i->modrm.ea, &CPU_REG8(c, i->modrm.opc));
 	}
 	else
 	{
-		*c->reg8[i->modrm.opc] = *c->reg8[i->modrm.rm];
+		CPU_REG8(c, i->modrm.opc) = CPU_REG8(c, i->modrm.rm);
 	}
 
 	return 0;
@@ -131,12 +127,11 @@ int32_t instr_mov_8b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 		if( i->modrm.mod != 3 )
 		{
-			MEM_WORD_READ(c, i->modrm.ea, c->reg16[i->modrm.opc]);
-			TRACK_INIT_REG16(c->instr, i->modrm.opc);
+			MEM_WORD_READ(c, i->modrm.ea, &CPU_REG16(c, i->modrm.opc));
 		}
 		else
 		{
-			*c->reg16[i->modrm.opc] = *c->reg16[i->modrm.rm];
+			CPU_REG16(c, i->modrm.opc) = CPU_REG16(c, i->modrm.rm);
 		}
 	}
 	else
@@ -149,14 +144,11 @@ int32_t instr_mov_8b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		if( i->modrm.mod != 3 )
 		{
 			MEM_DWORD_READ(c, i->modrm.ea, &c->reg[i->modrm.opc]);
-			TRACK_INIT_REG32(c->instr, i->modrm.opc);
 		}
 		else
 		{
 			c->reg[i->modrm.opc] = c->reg[i->modrm.rm];
 
-			TRACK_INIT_REG32(c->instr, i->modrm.opc);
-
 			if ( c->tracking != NULL )
 			{
 				c->tracking->track.reg[i->modrm.opc] = c->tracking->track.reg[i->modrm.rm];
@@ -193,7 +185,7 @@ int32_t instr_mov_a0(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	 * Move byte at (seg:offset) to AL                  
 	 * MOV AL,moffs8*   
 	 */																		 
-	MEM_BYTE_READ(c, i->disp, c->reg8[al]);
+	MEM_BYTE_READ(c, i->disp, &CPU_REG8(c, al));
 
 	return 0;
 }
@@ -208,7 +200,7 @@ int32_t instr_mov_a1(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 * MOV AX,moffs16*  
 		 */                                                                      
 
-		MEM_WORD_READ(c, i->disp, c->reg16[ax]);
+		MEM_WORD_READ(c, i->disp, &CPU_REG16(c, ax));
 	}
 	else
 	{
@@ -217,8 +209,6 @@ int32_t instr_mov_a1(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 * MOV EAX,moffs32* 
 		 */
 		MEM_DWORD_READ(c, i->disp, &c->reg[eax]);
-		
-		TRACK_INIT_REG32(c->instr, eax);
 	}
 	return 0;
 }
@@ -229,7 +219,7 @@ int32_t instr_mov_a2(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	 * Move AL to (seg:offset)                          
 	 * MOV moffs8*,AL   
 	 */																		 
-	MEM_BYTE_WRITE(c, i->imm, *c->reg8[al]);
+	MEM_BYTE_WRITE(c, i->imm, CPU_REG8(c, al));
 
 	return 0;
 }
@@ -244,7 +234,7 @@ int32_t instr_mov_a3(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 * Move AX to (seg:offset)                          
 		 * MOV moffs16*,AX  
 		 */
-		MEM_WORD_WRITE(c, i->imm, *c->reg16[ax]);
+		MEM_WORD_WRITE(c, i->imm, CPU_REG16(c, ax));
 	}
 	else
 	{
@@ -308,7 +298,7 @@ int32_t instr_mov_bx_1(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	 * Move imm8 to r8                                  
 	 * MOV r8,imm8      
 	 */
-	*c->reg8[i->opc & 7] = *i->imm8;
+	CPU_REG8(c, i->opc & 7) = *i->imm8;
 
 	return 0;
 }
@@ -324,9 +314,9 @@ int32_t instr_mov_bx_2(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 * MOV r16,imm16    
 		 */
 #if BYTE_ORDER == BIG_ENDIAN
-		bcopy(i->imm16, c->reg16[i->opc & 7], 2);
+		bcopy(i->imm16, &CPU_REG16(c, i->opc & 7), 2);
 #else
-		*c->reg16[i->opc & 7] = *i->imm16;
+		CPU_REG16(c, i->opc & 7) = *i->imm16;
 #endif
 
 
@@ -339,7 +329,6 @@ int32_t instr_mov_bx_2(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */                         
 
 		c->reg[i->opc & 7] = i->imm;
-		TRACK_INIT_REG32(c->instr, i->opc & 7);
 	}
 
 	return 0;
@@ -360,7 +349,7 @@ int32_t instr_mov_c6(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	}
 	else
 	{
-		*c->reg8[i->modrm.rm] = *i->imm8;
+		CPU_REG8(c, i->modrm.rm) = *i->imm8;
 	}																	 
 
 	return 0;
@@ -387,9 +376,9 @@ int32_t instr_mov_c7(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		else
 		{
 #if BYTE_ORDER == BIG_ENDIAN
-			bcopy(i->imm16, c->reg16[i->modrm.rm], 2);
+			bcopy(i->imm16, &CPU_REG16(c, i->modrm.rm), 2);
 #else
-			*c->reg16[i->modrm.rm] = *i->imm16;
+			CPU_REG16(c, i->modrm.rm) = *i->imm16;
 #endif
 		}                                                                    
 	}
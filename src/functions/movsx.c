@@ -50,7 +50,7 @@ int32_t instr_movsx_0fbe(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */       
 			uint8_t m8;
 			MEM_BYTE_READ(c, i->modrm.ea, &m8);
-			*c->reg16[i->modrm.opc] = (int8_t)m8;
+			CPU_REG16(c, i->modrm.opc) = (int8_t)m8;
 		}
 		else
 		{
@@ -71,7 +71,7 @@ int32_t instr_movsx_0fbe(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 * Move byte to word with sign-extension
 			 * MOVSX r16,r8  
 			 */       
-			*c->reg16[i->modrm.opc] = (int8_t)*c->reg8[i->modrm.rm];
+			CPU_REG16(c, i->modrm.opc) = (int8_t)CPU_REG8(c, i->modrm.rm);
 		}
 		else
 		{
@@ -79,7 +79,7 @@ int32_t instr_movsx_0fbe(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 * Move byte to doubleword, sign-extension
 			 * MOVSX r32,r8  
 			 */       
-			c->reg[i->modrm.opc] = (int8_t)*c->reg8[i->modrm.rm];
+			c->reg[i->modrm.opc] = (int8_t)CPU_REG8(c, i->modrm.rm);
 		}
 	}
 	return 0;
@@ -104,7 +104,7 @@ int32_t instr_movsx_0fbf(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 * Move word to doubleword, sign-extension
 		 * MOVSX r32,r16 
 		 */
-		c->reg[i->modrm.opc] = (int16_t)*c->reg16[i->modrm.rm];
+		c->reg[i->modrm.opc] = (int16_t)CPU_REG16(c, i->modrm.rm);
 	}
 	return 0;
 }
@@ -50,7 +50,7 @@ int32_t instr_movzx_0fb6(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			uint8_t m8;
 			MEM_BYTE_READ(c, i->modrm.ea, &m8);
-			*c->reg16[i->modrm.opc] = m8;
+			CPU_REG16(c, i->modrm.opc) = m8;
 		}
 		else
 		{
@@ -71,7 +71,7 @@ int32_t instr_movzx_0fb6(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 * Move byte to word with zero-extension
 			 * MOVZX r16,r/m8 
 			 */
-			*c->reg16[i->modrm.opc] = *c->reg8[i->modrm.rm];
+			CPU_REG16(c, i->modrm.opc) = CPU_REG8(c, i->modrm.rm);
 		}
 		else
 		{
@@ -79,7 +79,7 @@ int32_t instr_movzx_0fb6(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 * Move byte to doubleword, zero-extension
 			 * MOVZX r32,r/m8
 			 */
-			c->reg[i->modrm.opc] = *c->reg8[i->modrm.rm];
+			c->reg[i->modrm.opc] = CPU_REG8(c, i->modrm.rm);
 		}
 	}
 	return 0;
@@ -104,7 +104,7 @@ int32_t instr_movzx_0fb7(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 * Move word to doubleword, zero-extension
 		 * MOVZX r32,r16
 		 */
-		c->reg[i->modrm.opc] = *c->reg16[i->modrm.rm];
+		c->reg[i->modrm.opc] = CPU_REG16(c, i->modrm.rm);
 	}
 	return 0;
 }
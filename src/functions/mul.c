@@ -71,9 +71,9 @@ int32_t instr_group_3_f6_mul(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC(8, 
 				   16,
 				   c,
-				   *c->reg8[al],
+				   CPU_REG8(c, al),
 				   m8)
-		*c->reg16[ax] = operation_result;
+		CPU_REG16(c, ax) = operation_result;
 		uint8_t high;
 		WORD_UPPER_TO_BYTE(high,operation_result);
 		INSTR_SET_FLAGS(c,high);
@@ -88,10 +88,10 @@ int32_t instr_group_3_f6_mul(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC(8,
 				   16,
 				   c,
-				   *c->reg8[al],
-				   *c->reg8[i->modrm.rm])
+				   CPU_REG8(c, al),
+				   CPU_REG8(c, i->modrm.rm))
 
-		*c->reg16[ax] = operation_result;
+		CPU_REG16(c, ax) = operation_result;
 		uint8_t high;
 		WORD_UPPER_TO_BYTE(high,operation_result);
 		INSTR_SET_FLAGS(c,high);
@@ -115,13 +115,13 @@ int32_t instr_group_3_f7_mul(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC(16,
 					   32,
 					   c,
-					   *c->reg16[al],
+					   CPU_REG16(c, al),
 					   m16)
 
-			DWORD_UPPER_TO_WORD(*c->reg16[dx],operation_result);
-			DWORD_LOWER_TO_WORD(*c->reg16[ax],operation_result);
+			DWORD_UPPER_TO_WORD(CPU_REG16(c, dx),operation_result);
+			DWORD_LOWER_TO_WORD(CPU_REG16(c, ax),operation_result);
 
-			INSTR_SET_FLAGS(c,*c->reg16[dx]);
+			INSTR_SET_FLAGS(c,CPU_REG16(c, dx));
 		}
 		else
 		{
@@ -154,12 +154,12 @@ int32_t instr_group_3_f7_mul(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC(16,
 					   32,
 					   c,
-					   *c->reg16[al],
-					   *c->reg16[i->modrm.rm])
-			DWORD_UPPER_TO_WORD(*c->reg16[dx],operation_result);
-			DWORD_LOWER_TO_WORD(*c->reg16[ax],operation_result);
+					   CPU_REG16(c, al),
+					   CPU_REG16(c, i->modrm.rm))
+			DWORD_UPPER_TO_WORD(CPU_REG16(c, dx),operation_result);
+			DWORD_LOWER_TO_WORD(CPU_REG16(c, ax),operation_result);
 
-			INSTR_SET_FLAGS(c,*c->reg16[dx]);
+			INSTR_SET_FLAGS(c,CPU_REG16(c, dx));
 		}
 		else
 		{
@@ -105,7 +105,7 @@ int32_t instr_group_3_f6_neg(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 * Two's complement negate r/m8
 		 * NEG r/m8  
 		 */
-		INSTR_CALC_AND_SET_FLAGS(8,c,*c->reg8[i->modrm.rm]);
+		INSTR_CALC_AND_SET_FLAGS(8,c,CPU_REG8(c, i->modrm.rm));
 	}
 	return 0;
 }
@@ -154,7 +154,7 @@ int32_t instr_group_3_f7_neg(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16,
 									 c,
-									 *c->reg16[i->modrm.rm])
+									 CPU_REG16(c, i->modrm.rm))
 		}
 		else
 		{
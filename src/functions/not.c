@@ -67,7 +67,7 @@ int32_t instr_group_3_f6_not(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 * Reverse each bit of r/m8
 		 * NOT r/m8    
 		 */
-		INSTR_CALC_AND_SET_FLAGS(8,c,*c->reg8[i->modrm.rm]);
+		INSTR_CALC_AND_SET_FLAGS(8,c,CPU_REG8(c, i->modrm.rm));
 	}
 
 	return 0;
@@ -116,7 +116,7 @@ int32_t instr_group_3_f7_not(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */   
 			INSTR_CALC_AND_SET_FLAGS(16,
 									 c,
-									 *c->reg16[i->modrm.rm])
+									 CPU_REG16(c, i->modrm.rm))
 
 		}
 		else
@@ -46,18 +46,8 @@ INSTR_SET_FLAG_PF(cpu)											\
 INSTR_SET_FLAG_SF(cpu)											
 
 
-#define TRACK_INIT_ALL_FLAGS(instruction_p) \
-TRACK_INIT_EFLAG(instruction_p, f_of); \
-TRACK_INIT_EFLAG(instruction_p, f_cf); \
-TRACK_INIT_EFLAG(instruction_p, f_zf); \
-TRACK_INIT_EFLAG(instruction_p, f_pf); \
-TRACK_INIT_EFLAG(instruction_p, f_sf); 
-
-
 int32_t instr_or_08(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	/* 08 /r
 	 * r/m8 OR r8
 	 * OR r/m8,r8     
@@ -70,7 +60,7 @@ int32_t instr_or_08(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
 								 dst, 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
 								 dst, 
 								 |)
 		MEM_BYTE_WRITE(c, i->modrm.ea, dst);
@@ -79,9 +69,9 @@ int32_t instr_or_08(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	{
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.rm], 
-								 *c->reg8[i->modrm.opc], 
-								 *c->reg8[i->modrm.rm], 
+								 CPU_REG8(c, i->modrm.rm), 
+								 CPU_REG8(c, i->modrm.opc), 
+								 CPU_REG8(c, i->modrm.rm), 
 								 |)
 	}
 
@@ -90,8 +80,6 @@ int32_t instr_or_08(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_or_09(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -105,7 +93,7 @@ int32_t instr_or_09(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
 									 dst, 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.opc), 
 									 dst, 
 									 |)
 			MEM_WORD_WRITE(c, i->modrm.ea, dst);
@@ -138,9 +126,9 @@ int32_t instr_or_09(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
-									 *c->reg16[i->modrm.opc], 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
+									 CPU_REG16(c, i->modrm.opc), 
+									 CPU_REG16(c, i->modrm.rm), 
 									 |)
 		}
 		else
@@ -163,8 +151,6 @@ int32_t instr_or_09(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_or_0a(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	/* 0A /r
 	 * r8 OR r/m8
 	 * OR r8,r/m8     
@@ -178,17 +164,17 @@ int32_t instr_or_0a(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
 								 op, 
-								 *c->reg8[i->modrm.opc], 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
+								 CPU_REG8(c, i->modrm.opc), 
 								 |)
 	}
 	else
 	{
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.opc], 
-								 *c->reg8[i->modrm.rm], 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
+								 CPU_REG8(c, i->modrm.rm), 
+								 CPU_REG8(c, i->modrm.opc), 
 								 |)
 	}
 
@@ -197,8 +183,6 @@ int32_t instr_or_0a(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_or_0b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -213,8 +197,8 @@ int32_t instr_or_0b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
 									 op,
-									 *c->reg16[i->modrm.opc], 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.opc), 
+									 CPU_REG16(c, i->modrm.opc), 
 									 |)
 		}
 		else
@@ -243,9 +227,9 @@ int32_t instr_or_0b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
-									 *c->reg16[i->modrm.opc], 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.rm), 
+									 CPU_REG16(c, i->modrm.opc), 
+									 CPU_REG16(c, i->modrm.opc), 
 									 |)
 		}
 		else
@@ -269,8 +253,6 @@ int32_t instr_or_0b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_or_0c(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	/* 0C ib
 	 * AL OR imm8
 	 * OR AL,imm8
@@ -278,17 +260,15 @@ int32_t instr_or_0c(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 	INSTR_CALC_AND_SET_FLAGS(8, 
 							 c, 
-							 *c->reg8[al], 
+							 CPU_REG8(c, al), 
 							 *i->imm8, 
-							 *c->reg8[al], 
+							 CPU_REG8(c, al), 
 							 |)
 	return 0;
 }
 
 int32_t instr_or_0d(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 
 	if ( i->prefixes & PREFIX_OPSIZE )
 	{
@@ -298,9 +278,9 @@ int32_t instr_or_0d(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */
 		INSTR_CALC_AND_SET_FLAGS(16, 
 								 c, 
-								 *c->reg16[ax], 
+								 CPU_REG16(c, ax), 
 								 *i->imm16, 
-								 *c->reg16[ax], 
+								 CPU_REG16(c, ax), 
 								 |)
 	}
 	else
@@ -323,8 +303,6 @@ int32_t instr_or_0d(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_1_80_or(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if( i->modrm.mod != 3 )
 	{
 		uint8_t dst;
@@ -345,9 +323,9 @@ int32_t instr_group_1_80_or(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		/* reg8[rm] <-- reg8[rm] <OPC> imm8 */
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.rm], 
+								 CPU_REG8(c, i->modrm.rm), 
 								 *i->imm8, 
-								 *c->reg8[i->modrm.rm],
+								 CPU_REG8(c, i->modrm.rm),
 								 |)
 	}
 
@@ -358,8 +336,6 @@ int32_t instr_group_1_80_or(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_1_81_or(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -412,9 +388,9 @@ int32_t instr_group_1_81_or(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 *i->imm16, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 |)
 
 		}
@@ -438,8 +414,6 @@ int32_t instr_group_1_81_or(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_1_83_or(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -494,9 +468,9 @@ int32_t instr_group_1_83_or(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			int16_t sexd = (int8_t)*i->imm8;
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 sexd, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 |)
 		}
 		else
@@ -99,7 +99,7 @@ int32_t instr_push_5x(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 * Push r16      
 		 * PUSH r16   
 		 */
-		PUSH_WORD(c, *c->reg16[i->opc & 7])
+		PUSH_WORD(c, CPU_REG16(c, i->opc & 7))
 	}else
 	{
         /* 50+rd 
@@ -265,7 +265,7 @@ int32_t instr_group_5_ff_push(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 * Push r/m16    
 			 * PUSH r/m16 
 			 */
-			PUSH_WORD(c, *c->reg16[i->modrm.rm]);
+			PUSH_WORD(c, CPU_REG16(c, i->modrm.rm));
 		}
 		else
 		{
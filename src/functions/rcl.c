@@ -96,7 +96,7 @@ int32_t instr_group_2_c0_rcl(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */
 		INSTR_CALC_AND_SET_FLAGS(8,
 								 c,
-								 *c->reg8[i->modrm.rm],
+								 CPU_REG8(c, i->modrm.rm),
 								 *i->imm8);
 	}
 
@@ -148,7 +148,7 @@ int32_t instr_group_2_c1_rcl(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16,
 									 c,
-									 *c->reg16[i->modrm.rm],
+									 CPU_REG16(c, i->modrm.rm),
 									 *i->imm8);
 
 		}
@@ -194,7 +194,7 @@ int32_t instr_group_2_d0_rcl(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */
 		INSTR_CALC_AND_SET_FLAGS(8,
 								 c,
-								 *c->reg8[i->modrm.rm],
+								 CPU_REG8(c, i->modrm.rm),
 								 1);
 
 	}
@@ -247,7 +247,7 @@ int32_t instr_group_2_d1_rcl(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16,
 									 c,
-									 *c->reg16[i->modrm.rm],
+									 CPU_REG16(c, i->modrm.rm),
 									 1);
 
 		}
@@ -281,7 +281,7 @@ int32_t instr_group_2_d2_rcl(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC_AND_SET_FLAGS(8,
 								 c,
 								 m8,
-								 *c->reg8[cl]);
+								 CPU_REG8(c, cl));
 
 		MEM_BYTE_WRITE(c, i->modrm.ea, m8);     
 	}
@@ -293,8 +293,8 @@ int32_t instr_group_2_d2_rcl(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */
 		INSTR_CALC_AND_SET_FLAGS(8,
 								 c,
-								 *c->reg8[i->modrm.rm],
-								 *c->reg8[cl]);
+								 CPU_REG8(c, i->modrm.rm),
+								 CPU_REG8(c, cl));
 	}
 
 	return 0;
@@ -315,7 +315,7 @@ int32_t instr_group_2_d3_rcl(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(16,
 									 c,
 									 m16,
-									 *c->reg8[cl]);
+									 CPU_REG8(c, cl));
 
 			MEM_WORD_WRITE(c, i->modrm.ea, m16);        
 		}
@@ -330,7 +330,7 @@ int32_t instr_group_2_d3_rcl(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(32,
 									 c,
 									 m32,
-									 *c->reg8[cl]);
+									 CPU_REG8(c, cl));
 
 			MEM_DWORD_WRITE(c, i->modrm.ea, m32);       
 		}
@@ -345,8 +345,8 @@ int32_t instr_group_2_d3_rcl(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16,
 									 c,
-									 *c->reg16[i->modrm.rm],
-									 *c->reg8[cl]);
+									 CPU_REG16(c, i->modrm.rm),
+									 CPU_REG8(c, cl));
 		}
 		else
 		{
@@ -357,7 +357,7 @@ int32_t instr_group_2_d3_rcl(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(32,
 									 c,
 									 c->reg[i->modrm.rm],
-									 *c->reg8[cl]);
+									 CPU_REG8(c, cl));
 		}
 	}
 
@@ -95,7 +95,7 @@ int32_t instr_group_2_c0_rol(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */
 		INSTR_CALC_AND_SET_FLAGS(8,
 								 c,
-								 *c->reg8[i->modrm.rm],
+								 CPU_REG8(c, i->modrm.rm),
 								 *i->imm8);
 
 	}
@@ -150,7 +150,7 @@ int32_t instr_group_2_c1_rol(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16,
 									 c,
-									 *c->reg16[i->modrm.rm],
+									 CPU_REG16(c, i->modrm.rm),
 									 *i->imm8);
 
 		}
@@ -197,7 +197,7 @@ int32_t instr_group_2_d0_rol(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */
 		INSTR_CALC_AND_SET_FLAGS(8,
 								 c,
-								 *c->reg8[i->modrm.rm],
+								 CPU_REG8(c, i->modrm.rm),
 								 1);
 
 	}
@@ -250,7 +250,7 @@ int32_t instr_group_2_d1_rol(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16,
 									 c,
-									 *c->reg16[i->modrm.rm],
+									 CPU_REG16(c, i->modrm.rm),
 									 1);
 
 		}
@@ -284,7 +284,7 @@ int32_t instr_group_2_d2_rol(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC_AND_SET_FLAGS(8,
 								 c,
 								 m8,
-								 *c->reg8[cl]);
+								 CPU_REG8(c, cl));
 
 		MEM_BYTE_WRITE(c, i->modrm.ea, m8);     
 	}
@@ -296,8 +296,8 @@ int32_t instr_group_2_d2_rol(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */
 		INSTR_CALC_AND_SET_FLAGS(8,
 								 c,
-								 *c->reg8[i->modrm.rm],
-								 *c->reg8[cl]);
+								 CPU_REG8(c, i->modrm.rm),
+								 CPU_REG8(c, cl));
 	}
 
 	return 0;
@@ -319,7 +319,7 @@ int32_t instr_group_2_d3_rol(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(16,
 									 c,
 									 m16,
-									 *c->reg8[cl]);
+									 CPU_REG8(c, cl));
 
 			MEM_WORD_WRITE(c, i->modrm.ea, m16);        
 		}
@@ -334,7 +334,7 @@ int32_t instr_group_2_d3_rol(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(32,
 									 c,
 									 m32,
-									 *c->reg8[cl]);
+									 CPU_REG8(c, cl));
 
 			MEM_DWORD_WRITE(c, i->modrm.ea, m32);       
 		}
@@ -349,8 +349,8 @@ int32_t instr_group_2_d3_rol(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16,
 									 c,
-									 *c->reg16[i->modrm.rm],
-									 *c->reg8[cl]);
+									 CPU_REG16(c, i->modrm.rm),
+									 CPU_REG8(c, cl));
 		}
 		else
 		{
@@ -361,7 +361,7 @@ int32_t instr_group_2_d3_rol(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(32,
 									 c,
 									 c->reg[i->modrm.rm],
-									 *c->reg8[cl]);
+									 CPU_REG8(c, cl));
 		}
 	}
 
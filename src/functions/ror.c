@@ -93,7 +93,7 @@ int32_t instr_group_2_c0_ror(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */
 		INSTR_CALC_AND_SET_FLAGS(8,
 								 c,
-								 *c->reg8[i->modrm.rm],
+								 CPU_REG8(c, i->modrm.rm),
 								 *i->imm8);
 
 	}
@@ -146,7 +146,7 @@ int32_t instr_group_2_c1_ror(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16,
 									 c,
-									 *c->reg16[i->modrm.rm],
+									 CPU_REG16(c, i->modrm.rm),
 									 *i->imm8);
 
 		}
@@ -192,7 +192,7 @@ int32_t instr_group_2_d0_ror(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */
 		INSTR_CALC_AND_SET_FLAGS(8,
 								 c,
-								 *c->reg8[i->modrm.rm],
+								 CPU_REG8(c, i->modrm.rm),
 								 1);
 
 	}
@@ -245,7 +245,7 @@ int32_t instr_group_2_d1_ror(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */                                                                     
 			INSTR_CALC_AND_SET_FLAGS(16,
 									 c,
-									 *c->reg16[i->modrm.rm],
+									 CPU_REG16(c, i->modrm.rm),
 									 1);
 
 		}
@@ -279,7 +279,7 @@ int32_t instr_group_2_d2_ror(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC_AND_SET_FLAGS(8,
 								 c,
 								 m8,
-								 *c->reg8[cl]);
+								 CPU_REG8(c, cl));
 
 		MEM_BYTE_WRITE(c, i->modrm.ea, m8);     
 	}
@@ -291,8 +291,8 @@ int32_t instr_group_2_d2_ror(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */
 		INSTR_CALC_AND_SET_FLAGS(8,
 								 c,
-								 *c->reg8[i->modrm.rm],
-								 *c->reg8[cl]);
+								 CPU_REG8(c, i->modrm.rm),
+								 CPU_REG8(c, cl));
 	}
 	return 0;
 }
@@ -313,7 +313,7 @@ int32_t instr_group_2_d3_ror(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(16,
 									 c,
 									 m16,
-									 *c->reg8[cl]);
+									 CPU_REG8(c, cl));
 
 			MEM_WORD_WRITE(c, i->modrm.ea, m16);        
 		}
@@ -328,7 +328,7 @@ int32_t instr_group_2_d3_ror(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(32,
 									 c,
 									 m32,
-									 *c->reg8[cl]);
+									 CPU_REG8(c, cl));
 
 			MEM_DWORD_WRITE(c, i->modrm.ea, m32);       
 		}
@@ -343,8 +343,8 @@ int32_t instr_group_2_d3_ror(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16,
 									 c,
-									 *c->reg16[i->modrm.rm],
-									 *c->reg8[cl]);
+									 CPU_REG16(c, i->modrm.rm),
+									 CPU_REG8(c, cl));
 		}
 		else
 		{
@@ -355,7 +355,7 @@ int32_t instr_group_2_d3_ror(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(32,
 									 c,
 									 c->reg[i->modrm.rm],
-									 *c->reg8[cl]);
+									 CPU_REG8(c, cl));
 		}
 	}
 	return 0;
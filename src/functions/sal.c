@@ -100,7 +100,7 @@ int32_t instr_group_2_c0_sal(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */      
 		INSTR_CALC_AND_SET_FLAGS(8,
 								 c,
-								 *c->reg8[i->modrm.rm],
+								 CPU_REG8(c, i->modrm.rm),
 								 *i->imm8);
 
 	}
@@ -153,7 +153,7 @@ int32_t instr_group_2_c1_sal(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16,
 									 c,
-									 *c->reg16[i->modrm.rm],
+									 CPU_REG16(c, i->modrm.rm),
 									 *i->imm8);
 
 		}
@@ -201,7 +201,7 @@ int32_t instr_group_2_d0_sal(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */
 		INSTR_CALC_AND_SET_FLAGS(8,
 								 c,
-								 *c->reg8[i->modrm.rm],
+								 CPU_REG8(c, i->modrm.rm),
 								 1);
 
 	}
@@ -254,7 +254,7 @@ int32_t instr_group_2_d1_sal(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16,
 									 c,
-									 *c->reg16[i->modrm.rm],
+									 CPU_REG16(c, i->modrm.rm),
 									 1);
 
 		}
@@ -288,7 +288,7 @@ int32_t instr_group_2_d2_sal(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC_AND_SET_FLAGS(8,
 								 c,
 								 m8,
-								 *c->reg8[cl]);
+								 CPU_REG8(c, cl));
 
 		MEM_BYTE_WRITE(c, i->modrm.ea, m8);     
 	}
@@ -300,8 +300,8 @@ int32_t instr_group_2_d2_sal(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */
 		INSTR_CALC_AND_SET_FLAGS(8,
 								 c,
-								 *c->reg8[i->modrm.rm],
-								 *c->reg8[cl]);
+								 CPU_REG8(c, i->modrm.rm),
+								 CPU_REG8(c, cl));
 	}
 
 	return 0;
@@ -323,7 +323,7 @@ int32_t instr_group_2_d3_sal(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(16,
 									 c,
 									 m16,
-									 *c->reg8[cl]);
+									 CPU_REG8(c, cl));
 
 			MEM_WORD_WRITE(c, i->modrm.ea, m16);        
 		}
@@ -338,7 +338,7 @@ int32_t instr_group_2_d3_sal(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(32,
 									 c,
 									 m32,
-									 *c->reg8[cl]);
+									 CPU_REG8(c, cl));
 
 			MEM_DWORD_WRITE(c, i->modrm.ea, m32);       
 		}
@@ -353,8 +353,8 @@ int32_t instr_group_2_d3_sal(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16,
 									 c,
-									 *c->reg16[i->modrm.rm],
-									 *c->reg8[cl]);
+									 CPU_REG16(c, i->modrm.rm),
+									 CPU_REG8(c, cl));
 		}
 		else
 		{
@@ -365,7 +365,7 @@ int32_t instr_group_2_d3_sal(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(32,
 									 c,
 									 c->reg[i->modrm.rm],
-									 *c->reg8[cl]);
+									 CPU_REG8(c, cl));
 		}
 	}
 
@@ -91,18 +91,8 @@ INSTR_SET_FLAG_CF(cpu, operation)
 
 
 
-#define TRACK_INIT_ALL_FLAGS(instruction_p) \
-TRACK_INIT_EFLAG(instruction_p, f_zf); \
-TRACK_INIT_EFLAG(instruction_p, f_pf); \
-TRACK_INIT_EFLAG(instruction_p, f_sf); \
-TRACK_INIT_EFLAG(instruction_p, f_of); \
-TRACK_INIT_EFLAG(instruction_p, f_cf); 
-
-
 int32_t instr_sbb_18(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	/* 18 /r
 	 * Subtract with borrow r8 from r/m8
 	 * SBB r/m8,r8 
@@ -115,7 +105,7 @@ int32_t instr_sbb_18(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
 								 dst, 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
 								 dst, 
 								 -)
 		MEM_BYTE_WRITE(c, i->modrm.ea, dst);
@@ -124,9 +114,9 @@ int32_t instr_sbb_18(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	{
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.rm], 
-								 *c->reg8[i->modrm.opc], 
-								 *c->reg8[i->modrm.rm], 
+								 CPU_REG8(c, i->modrm.rm), 
+								 CPU_REG8(c, i->modrm.opc), 
+								 CPU_REG8(c, i->modrm.rm), 
 								 -)
 	}
 
@@ -135,8 +125,6 @@ int32_t instr_sbb_18(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_sbb_19(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -152,7 +140,7 @@ int32_t instr_sbb_19(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
 									 dst, 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.opc), 
 									 dst, 
 									 -)
 			MEM_WORD_WRITE(c, i->modrm.ea, dst);
@@ -186,9 +174,9 @@ int32_t instr_sbb_19(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
-									 *c->reg16[i->modrm.opc], 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
+									 CPU_REG16(c, i->modrm.opc), 
+									 CPU_REG16(c, i->modrm.rm), 
 									 -)
 		}
 		else
@@ -212,8 +200,6 @@ int32_t instr_sbb_19(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_sbb_1a(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	/* 1A /r
 	 * Subtract with borrow r/m8 from r8
 	 * SBB r8,r/m8 
@@ -226,18 +212,18 @@ int32_t instr_sbb_1a(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
 								 op, 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
 								 -)
 	}
 	else
 	{
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.opc], 
-								 *c->reg8[i->modrm.rm], 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
+								 CPU_REG8(c, i->modrm.rm), 
+								 CPU_REG8(c, i->modrm.opc), 
 								 -)
 	}
 
@@ -246,8 +232,6 @@ int32_t instr_sbb_1a(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_sbb_1b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {	
-	TRACK_INIT_ALL_FLAGS(c->instr); 
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -262,9 +246,9 @@ int32_t instr_sbb_1b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.opc), 
 									 op,
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.opc), 
 									 -)
 		}
 		else
@@ -294,9 +278,9 @@ int32_t instr_sbb_1b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.opc], 
-									 *c->reg16[i->modrm.rm], 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.opc), 
+									 CPU_REG16(c, i->modrm.rm), 
+									 CPU_REG16(c, i->modrm.opc), 
 									 -)
 		}
 		else
@@ -320,8 +304,6 @@ int32_t instr_sbb_1b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_sbb_1c(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	/* 1C ib
 	 * Subtract with borrow imm8 from AL
 	 * SBB AL,imm8
@@ -329,17 +311,15 @@ int32_t instr_sbb_1c(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 	INSTR_CALC_AND_SET_FLAGS(8, 
 							 c, 
-							 *c->reg8[al], 
+							 CPU_REG8(c, al), 
 							 *i->imm8, 
-							 *c->reg8[al], 
+							 CPU_REG8(c, al), 
 							 -)
 	return 0;
 }
 
 int32_t instr_sbb_1d(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);	
-
 	if ( i->prefixes & PREFIX_OPSIZE )
 	{
 		/* 1D iw               
@@ -348,9 +328,9 @@ int32_t instr_sbb_1d(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */
 		INSTR_CALC_AND_SET_FLAGS(16, 
 								 c, 
-								 *c->reg16[ax], 
+								 CPU_REG16(c, ax), 
 								 *i->imm16, 
-								 *c->reg16[ax], 
+								 CPU_REG16(c, ax), 
 								 -)
 	}
 	else
@@ -374,8 +354,6 @@ int32_t instr_sbb_1d(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_1_80_sbb(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if( i->modrm.mod != 3 )
 	{
 		uint8_t dst;
@@ -396,9 +374,9 @@ int32_t instr_group_1_80_sbb(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		/* reg8[rm] <-- reg8[rm] <OPC> imm8 */
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.rm], 
+								 CPU_REG8(c, i->modrm.rm), 
 								 *i->imm8, 
-								 *c->reg8[i->modrm.rm],
+								 CPU_REG8(c, i->modrm.rm),
 								 -)
 	}
 
@@ -408,8 +386,6 @@ int32_t instr_group_1_80_sbb(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_1_81_sbb(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -465,9 +441,9 @@ int32_t instr_group_1_81_sbb(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 *i->imm16, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 -)
 
 		}
@@ -493,8 +469,6 @@ int32_t instr_group_1_81_sbb(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_1_83_sbb(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -553,9 +527,9 @@ int32_t instr_group_1_83_sbb(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			int16_t sexd = (int8_t)*i->imm8;
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 sexd, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 -)
 
 		}
@@ -92,7 +92,7 @@ int32_t instr_scas_ae(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 		INSTR_CALC_AND_SET_FLAGS(8,
 								 c,
-								 *c->reg8[al],
+								 CPU_REG8(c, al),
 								 m8)
 		INSTR_CALC_EDI(c, 8)
 		
@@ -148,7 +148,7 @@ int32_t instr_scas_af(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 			INSTR_CALC_AND_SET_FLAGS(8,
 									 c,
-									 *c->reg16[ax],
+									 CPU_REG16(c, ax),
 									 m16)
 
 			INSTR_CALC_EDI(c, 16)
@@ -50,7 +50,7 @@ int32_t instr_stos_aa(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 	if ( i->prefixes & PREFIX_ADSIZE )
 	{
-//		MEM_BYTE_WRITE(c,c->reg16[si],*c->reg8[al]);
+//		MEM_BYTE_WRITE(c,&CPU_REG16(c, si),CPU_REG8(c, al));
 		UNIMPLEMENTED(c, SST);
 	}
 	else
@@ -67,7 +67,7 @@ int32_t instr_stos_aa(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			{
 				c->reg[ecx]--;
 				c->repeat_current_instr = true;
-				MEM_BYTE_WRITE(c,c->reg[edi],*c->reg8[al]);
+				MEM_BYTE_WRITE(c,c->reg[edi],CPU_REG8(c, al));
 				if ( !CPU_FLAG_ISSET(c,f_df) )
 				{ /* increment */
 					c->reg[edi] += 1;
@@ -82,7 +82,7 @@ int32_t instr_stos_aa(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			
 		}else
 		{
-			MEM_BYTE_WRITE(c,c->reg[edi],*c->reg8[al]);
+			MEM_BYTE_WRITE(c,c->reg[edi],CPU_REG8(c, al));
 			if ( !CPU_FLAG_ISSET(c,f_df) )
 			{ /* increment */
 				c->reg[edi] += 1;
@@ -112,12 +112,12 @@ int32_t instr_stos_ab(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */
 		if ( i->prefixes & PREFIX_ADSIZE )
 		{
-//			MEM_WORD_WRITE(c,c->reg16[si],*c->reg16[ax]);
+//			MEM_WORD_WRITE(c,&CPU_REG16(c, si),CPU_REG16(c, ax));
 			UNIMPLEMENTED(c, SST);
 		}
 		else
 		{
-			MEM_WORD_WRITE(c,c->reg[edi],*c->reg16[ax]);
+			MEM_WORD_WRITE(c,c->reg[edi],CPU_REG16(c, ax));
 
 			if ( !CPU_FLAG_ISSET(c,f_df) )
 			{ /* increment */
@@ -142,7 +142,7 @@ int32_t instr_stos_ab(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */
 		if ( i->prefixes & PREFIX_ADSIZE )
 		{
-//			MEM_DWORD_WRITE(c,c->reg16[si],c->reg[eax]);
+//			MEM_DWORD_WRITE(c,&CPU_REG16(c, si),c->reg[eax]);
 			UNIMPLEMENTED(c, SST);
 		}
 		else
@@ -48,19 +48,8 @@ INSTR_SET_FLAG_CF(cpu, operation)								\
 INSTR_SET_FLAG_OF(cpu, operation, bits)								
 
 
-#define TRACK_INIT_ALL_FLAGS(instruction_p) \
-TRACK_INIT_EFLAG(instruction_p, f_zf); \
-TRACK_INIT_EFLAG(instruction_p, f_pf); \
-TRACK_INIT_EFLAG(instruction_p, f_sf); \
-TRACK_INIT_EFLAG(instruction_p, f_cf); \
-TRACK_INIT_EFLAG(instruction_p, f_of); 
-
-
-
 int32_t instr_sub_28(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	/*
 	 * 28 /r
 	 * Subtract r8 from r/m8
@@ -75,7 +64,7 @@ int32_t instr_sub_28(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
 								 dst, 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
 								 dst, 
 								 -)
 		MEM_BYTE_WRITE(c, i->modrm.ea, dst);
@@ -84,9 +73,9 @@ int32_t instr_sub_28(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	{
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.rm], 
-								 *c->reg8[i->modrm.opc], 
-								 *c->reg8[i->modrm.rm], 
+								 CPU_REG8(c, i->modrm.rm), 
+								 CPU_REG8(c, i->modrm.opc), 
+								 CPU_REG8(c, i->modrm.rm), 
 								 -)
 	}
 
@@ -95,8 +84,6 @@ int32_t instr_sub_28(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_sub_29(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {      
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -111,7 +98,7 @@ int32_t instr_sub_29(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
 									 dst, 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.opc), 
 									 dst, 
 									 -)
 			MEM_WORD_WRITE(c, i->modrm.ea, dst);
@@ -145,9 +132,9 @@ int32_t instr_sub_29(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
-									 *c->reg16[i->modrm.opc], 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
+									 CPU_REG16(c, i->modrm.opc), 
+									 CPU_REG16(c, i->modrm.rm), 
 									 -)
 		}
 		else
@@ -163,15 +150,6 @@ int32_t instr_sub_29(struct emu_cpu *c, struct emu_cpu_instruction *i)
 									 c->reg[i->modrm.opc], 
 									 c->reg[i->modrm.rm], 
 									 -)
-			if (i->modrm.opc == i->modrm.rm)
-			{
-				TRACK_INIT_REG32(c->instr, i->modrm.opc);
-			}else
-			{
-				TRACK_NEED_REG32(c->instr, i->modrm.rm);
-				TRACK_NEED_REG32(c->instr, i->modrm.opc);
-			}
-
 		}
 	}
 
@@ -180,8 +158,6 @@ int32_t instr_sub_29(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_sub_2a(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	 /* 2A /r
 	  * Subtract r/m8 from r8
 	  * SUB r8,r/m8 
@@ -196,17 +172,17 @@ int32_t instr_sub_2a(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
 								 op, 
-								 *c->reg8[i->modrm.opc], 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
+								 CPU_REG8(c, i->modrm.opc), 
 								 -)
 	}
 	else
 	{
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.opc], 
-								 *c->reg8[i->modrm.rm], 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
+								 CPU_REG8(c, i->modrm.rm), 
+								 CPU_REG8(c, i->modrm.opc), 
 								 -)
 	}
 
@@ -215,8 +191,6 @@ int32_t instr_sub_2a(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_sub_2b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -232,9 +206,9 @@ int32_t instr_sub_2b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.opc), 
 									 op,
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.opc), 
 									 -)
 		}
 		else
@@ -268,9 +242,9 @@ int32_t instr_sub_2b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.opc], 
-									 *c->reg16[i->modrm.rm], 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.opc), 
+									 CPU_REG16(c, i->modrm.rm), 
+									 CPU_REG16(c, i->modrm.opc), 
 									 -)
 		}
 		else
@@ -287,11 +261,6 @@ int32_t instr_sub_2b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 									 c->reg[i->modrm.rm], 
 									 c->reg[i->modrm.opc], 
 									 -)
-
-			if ( i->modrm.opc == i->modrm.rm )
-			{
-				TRACK_INIT_REG32(c->instr, i->modrm.opc);
-			}
 		}
 	}
 
@@ -300,8 +269,6 @@ int32_t instr_sub_2b(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_sub_2c(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	/* 2C ib
 	 * Subtract imm8 from AL
      * SUB AL,imm8
@@ -309,17 +276,15 @@ int32_t instr_sub_2c(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 	INSTR_CALC_AND_SET_FLAGS(8, 
 							 c, 
-							 *c->reg8[al], 
+							 CPU_REG8(c, al), 
 							 *i->imm8, 
-							 *c->reg8[al], 
+							 CPU_REG8(c, al), 
 							 -)
 	return 0;
 }
 
 int32_t instr_sub_2d(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->prefixes & PREFIX_OPSIZE )
 	{ 
 		/* 2D iw
@@ -329,9 +294,9 @@ int32_t instr_sub_2d(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	  
 		INSTR_CALC_AND_SET_FLAGS(16, 
 								 c, 
-								 *c->reg16[ax], 
+								 CPU_REG16(c, ax), 
 								 *i->imm16, 
-								 *c->reg16[ax], 
+								 CPU_REG16(c, ax), 
 								 -)
 	}
 	else
@@ -355,8 +320,6 @@ int32_t instr_sub_2d(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_1_80_sub(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if( i->modrm.mod != 3 )
 	{
 		uint8_t dst;
@@ -377,9 +340,9 @@ int32_t instr_group_1_80_sub(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		/* reg8[rm] <-- reg8[rm] <OPC> imm8 */
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.rm], 
+								 CPU_REG8(c, i->modrm.rm), 
 								 *i->imm8, 
-								 *c->reg8[i->modrm.rm],
+								 CPU_REG8(c, i->modrm.rm),
 								 -)
 	}
 
@@ -389,8 +352,6 @@ int32_t instr_group_1_80_sub(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_1_81_sub(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -444,9 +405,9 @@ int32_t instr_group_1_81_sub(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 *i->imm16, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 -)
 		}
 		else
@@ -469,8 +430,6 @@ int32_t instr_group_1_81_sub(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_1_83_sub(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -527,9 +486,9 @@ int32_t instr_group_1_83_sub(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			int16_t sexd = (int8_t)*i->imm8;
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 sexd, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 -)
 		}
 		else
@@ -65,7 +65,7 @@ int32_t instr_test_84(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		MEM_BYTE_READ(c, i->modrm.ea, &m8);
 		INSTR_CALC_AND_SET_FLAGS(8,
 								 c,
-								 *c->reg8[i->modrm.opc],
+								 CPU_REG8(c, i->modrm.opc),
 								 m8)
 	}else
 	{
@@ -75,8 +75,8 @@ int32_t instr_test_84(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */
 		INSTR_CALC_AND_SET_FLAGS(8,
 								 c,
-								 *c->reg8[i->modrm.opc],
-								 *c->reg8[i->modrm.rm])
+								 CPU_REG8(c, i->modrm.opc),
+								 CPU_REG8(c, i->modrm.rm))
 	}
 	return 0;
 }
@@ -96,7 +96,7 @@ int32_t instr_test_85(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			MEM_WORD_READ(c, i->modrm.ea, &m16);
 			INSTR_CALC_AND_SET_FLAGS(16,
 									 c,
-									 *c->reg16[i->modrm.opc],
+									 CPU_REG16(c, i->modrm.opc),
 									 m16)
 
 		}
@@ -127,8 +127,8 @@ int32_t instr_test_85(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16,
 									 c,
-									 *c->reg16[i->modrm.opc],
-									 *c->reg16[i->modrm.rm])
+									 CPU_REG16(c, i->modrm.opc),
+									 CPU_REG16(c, i->modrm.rm))
 
 		}
 		else
@@ -156,7 +156,7 @@ int32_t instr_test_a8(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	INSTR_CALC_AND_SET_FLAGS(8,
 							 c,
 							 *i->imm8,
-							 *c->reg8[al])
+							 CPU_REG8(c, al))
 
 	return 0;
 }
@@ -172,7 +172,7 @@ int32_t instr_test_a9(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC_AND_SET_FLAGS(16,
 								 c,
 								 *i->imm16,
-								 *c->reg16[ax])
+								 CPU_REG16(c, ax))
 
 	}
 	else
@@ -215,7 +215,7 @@ int32_t instr_group_3_f6_test(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC_AND_SET_FLAGS(8,
 								 c,
 								 *i->imm8,
-								 *c->reg8[i->modrm.rm])
+								 CPU_REG8(c, i->modrm.rm))
 
 	}
 	return 0;
@@ -266,7 +266,7 @@ int32_t instr_group_3_f7_test(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(16,
 									 c,
 									 *i->imm16,
-									 *c->reg16[i->modrm.rm])
+									 CPU_REG16(c, i->modrm.rm))
 		}
 		else
 		{
@@ -51,8 +51,8 @@ int32_t instr_xchg_86(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 */     
 		uint8_t m8;
 		MEM_BYTE_READ(c, i->modrm.ea, &m8);
-		MEM_BYTE_WRITE(c, i->modrm.ea, *c->reg8[i->modrm.opc]);
-		*c->reg8[i->modrm.opc] = m8;
+		MEM_BYTE_WRITE(c, i->modrm.ea, CPU_REG8(c, i->modrm.opc));
+		CPU_REG8(c, i->modrm.opc) = m8;
 	}
 	else
 	{
@@ -62,9 +62,9 @@ int32_t instr_xchg_86(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 * Exchange byte from r/m8 with r8 (byte register)
 		 * XCHG r8,r/m8   
 		 */     
-		uint8_t swap8 = *c->reg8[i->modrm.rm];
-		*c->reg8[i->modrm.rm] = *c->reg8[i->modrm.opc];
-		*c->reg8[i->modrm.opc] = swap8;
+		uint8_t swap8 = CPU_REG8(c, i->modrm.rm);
+		CPU_REG8(c, i->modrm.rm) = CPU_REG8(c, i->modrm.opc);
+		CPU_REG8(c, i->modrm.opc) = swap8;
 	}
 	return 0;
 }
@@ -84,8 +84,8 @@ int32_t instr_xchg_87(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */     
 			uint16_t m16;
 			MEM_WORD_READ(c, i->modrm.ea, &m16);
-			MEM_WORD_WRITE(c, i->modrm.ea, *c->reg16[i->modrm.opc]);
-			*c->reg16[i->modrm.opc] = m16;
+			MEM_WORD_WRITE(c, i->modrm.ea, CPU_REG16(c, i->modrm.opc));
+			CPU_REG16(c, i->modrm.opc) = m16;
 
 		}
 		else
@@ -113,9 +113,9 @@ int32_t instr_xchg_87(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 * Exchange word from r/m16 with r16
 			 * XCHG r16,r/m16 
 			 */     
-			uint16_t swap16 = *c->reg16[i->modrm.rm];
-			*c->reg16[i->modrm.rm] = *c->reg16[i->modrm.opc];
-			*c->reg16[i->modrm.opc] = swap16;
+			uint16_t swap16 = CPU_REG16(c, i->modrm.rm);
+			CPU_REG16(c, i->modrm.rm) = CPU_REG16(c, i->modrm.opc);
+			CPU_REG16(c, i->modrm.opc) = swap16;
 
 		}
 		else
@@ -146,9 +146,9 @@ int32_t instr_xchg_9x(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		 * Exchange AX with r16
 		 * XCHG r16,AX    
 		 */     
-		uint16_t swap16 = *c->reg16[ax];
-		*c->reg16[ax] = *c->reg16[i->opc & 7];
-		*c->reg16[i->opc & 7] = swap16;
+		uint16_t swap16 = CPU_REG16(c, ax);
+		CPU_REG16(c, ax) = CPU_REG16(c, i->opc & 7);
+		CPU_REG16(c, i->opc & 7) = swap16;
 
 
 	}
@@ -49,18 +49,8 @@ INSTR_SET_FLAG_SF(cpu)
 
 
 
-#define TRACK_INIT_ALL_FLAGS(instruction_p) \
-TRACK_INIT_EFLAG(instruction_p, f_of); \
-TRACK_INIT_EFLAG(instruction_p, f_cf); \
-TRACK_INIT_EFLAG(instruction_p, f_zf); \
-TRACK_INIT_EFLAG(instruction_p, f_pf); \
-TRACK_INIT_EFLAG(instruction_p, f_sf); 
-
-
 int32_t instr_xor_30(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	/* 30 /r
 	 * r/m8 XOR r8
 	 * XOR r/m8,r8     
@@ -72,7 +62,7 @@ int32_t instr_xor_30(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
 								 dst, 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
 								 dst, 
 								 ^)
 		MEM_BYTE_WRITE(c, i->modrm.ea, dst);
@@ -81,14 +71,11 @@ int32_t instr_xor_30(struct emu_cpu *c, struct emu_cpu_instruction *i)
 	{
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.rm], 
-								 *c->reg8[i->modrm.opc], 
-								 *c->reg8[i->modrm.rm], 
+								 CPU_REG8(c, i->modrm.rm), 
+								 CPU_REG8(c, i->modrm.opc), 
+								 CPU_REG8(c, i->modrm.rm), 
 								 ^)
 
-		TRACK_NEED_REG8(c->instr, i->modrm.rm);
-		TRACK_INIT_REG8(c->instr, i->modrm.rm);
-
 	}
 
 	return 0;
@@ -96,8 +83,6 @@ int32_t instr_xor_30(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_xor_31(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -112,10 +97,9 @@ int32_t instr_xor_31(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
 									 dst, 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.opc), 
 									 dst, 
 									 ^)
-			TRACK_NEED_REG16(c->instr, i->modrm.opc);
 			MEM_WORD_WRITE(c, i->modrm.ea, dst);
 		}
 		else
@@ -133,7 +117,6 @@ int32_t instr_xor_31(struct emu_cpu *c, struct emu_cpu_instruction *i)
 									 c->reg[i->modrm.opc], 
 									 dst, 
 									 ^)
-			TRACK_NEED_REG32(c->instr, i->modrm.opc);
 			MEM_DWORD_WRITE(c, i->modrm.ea, dst);
 		}
 	}
@@ -148,13 +131,10 @@ int32_t instr_xor_31(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
-									 *c->reg16[i->modrm.opc], 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
+									 CPU_REG16(c, i->modrm.opc), 
+									 CPU_REG16(c, i->modrm.rm), 
 									 ^)
-			TRACK_NEED_REG16(c->instr, i->modrm.rm);
-			TRACK_NEED_REG16(c->instr, i->modrm.opc);
-			TRACK_INIT_REG16(c->instr, i->modrm.rm);
 		}
 		else
 		{
@@ -169,16 +149,6 @@ int32_t instr_xor_31(struct emu_cpu *c, struct emu_cpu_instruction *i)
 									 c->reg[i->modrm.opc], 
 									 c->reg[i->modrm.rm], 
 									 ^)
-
-			if (i->modrm.opc == i->modrm.rm)
-			{
-				TRACK_INIT_REG32(c->instr, i->modrm.opc);
-			}
-
-/*			TRACK_NEED_REG32(c->instr, i->modrm.rm);
-			TRACK_NEED_REG32(c->instr, i->modrm.opc);
-			TRACK_INIT_REG32(c->instr, i->modrm.rm);
-*/
 		}
 	}
 
@@ -187,8 +157,6 @@ int32_t instr_xor_31(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_xor_32(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	/* 32 /r
 	 * r8 XOR r/m8
 	 * XOR r8,r/m8     
@@ -202,25 +170,18 @@ int32_t instr_xor_32(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
 								 op, 
-								 *c->reg8[i->modrm.opc], 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
+								 CPU_REG8(c, i->modrm.opc), 
 								 ^)
-
-		TRACK_NEED_REG8(c->instr, i->modrm.opc);
-		TRACK_INIT_REG8(c->instr, i->modrm.opc);
 	}
 	else
 	{
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.opc], 
-								 *c->reg8[i->modrm.rm], 
-								 *c->reg8[i->modrm.opc], 
+								 CPU_REG8(c, i->modrm.opc), 
+								 CPU_REG8(c, i->modrm.rm), 
+								 CPU_REG8(c, i->modrm.opc), 
 								 ^)
-
-		TRACK_NEED_REG8(c->instr, i->modrm.opc);
-		TRACK_NEED_REG8(c->instr, i->modrm.rm);
-		TRACK_INIT_REG8(c->instr, i->modrm.opc);
 	}
 
 	return 0;
@@ -228,8 +189,6 @@ int32_t instr_xor_32(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_xor_33(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -246,12 +205,9 @@ int32_t instr_xor_33(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
 									 op,
-									 *c->reg16[i->modrm.opc], 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.opc), 
+									 CPU_REG16(c, i->modrm.opc), 
 									 ^)
-
-			TRACK_NEED_REG16(c->instr, i->modrm.opc);
-			TRACK_INIT_REG16(c->instr, i->modrm.opc);
 		}
 		else
 		{
@@ -269,14 +225,12 @@ int32_t instr_xor_33(struct emu_cpu *c, struct emu_cpu_instruction *i)
 									 c->reg[i->modrm.opc], 
 									 ^)
 
+			/* the register is known only if the result is zero,
+			 * the rest of the track information is static */
 			if (operation_result == 0)
 			{
-				TRACK_INIT_REG32(c->instr, i->modrm.opc);			
+				TRACK_INIT_REG32(c->instr, i->modrm.opc);
 			}
-
-/*			TRACK_NEED_REG32(c->instr, i->modrm.opc);
-
-*/
 		}
 	}
 	else
@@ -289,20 +243,10 @@ int32_t instr_xor_33(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
-									 *c->reg16[i->modrm.opc], 
-									 *c->reg16[i->modrm.opc], 
+									 CPU_REG16(c, i->modrm.rm), 
+									 CPU_REG16(c, i->modrm.opc), 
+									 CPU_REG16(c, i->modrm.opc), 
 									 ^)
-
-			if (i->modrm.opc == i->modrm.rm)
-			{
-				TRACK_INIT_REG16(c->instr, i->modrm.opc);
-			}
-
-/*			TRACK_NEED_REG16(c->instr, i->modrm.rm);
-			TRACK_NEED_REG16(c->instr, i->modrm.opc);
-			TRACK_INIT_REG16(c->instr, i->modrm.opc);
-*/
 		}
 		else
 		{
@@ -316,17 +260,6 @@ int32_t instr_xor_33(struct emu_cpu *c, struct emu_cpu_instruction *i)
 									 c->reg[i->modrm.opc], 
 									 c->reg[i->modrm.opc], 
 									 ^)
-
-			if (i->modrm.opc == i->modrm.rm)
-			{
-				TRACK_INIT_REG32(c->instr, i->modrm.opc);
-			}
-			
-/*
-			TRACK_NEED_REG32(c->instr, i->modrm.rm);
-			TRACK_NEED_REG32(c->instr, i->modrm.opc);
-			TRACK_INIT_REG32(c->instr, i->modrm.opc);
-*/
 		}
 	}
 
@@ -335,8 +268,6 @@ int32_t instr_xor_33(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_xor_34(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	/* 34 ib
 	 * AL XOR imm8
 	 * XOR AL,imm8
@@ -344,21 +275,16 @@ int32_t instr_xor_34(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 	INSTR_CALC_AND_SET_FLAGS(8, 
 							 c, 
-							 *c->reg8[al], 
+							 CPU_REG8(c, al), 
 							 *i->imm8, 
-							 *c->reg8[al], 
+							 CPU_REG8(c, al), 
 							 ^)
 
-	TRACK_NEED_REG8(c->instr, al);
-	TRACK_INIT_REG8(c->instr, al);
-
 	return 0;
 }
 
 int32_t instr_xor_35(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->prefixes & PREFIX_OPSIZE )
 	{
 
@@ -369,14 +295,11 @@ int32_t instr_xor_35(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 		INSTR_CALC_AND_SET_FLAGS(16, 
 								 c, 
-								 *c->reg16[ax], 
+								 CPU_REG16(c, ax), 
 								 *i->imm16, 
-								 *c->reg16[ax], 
+								 CPU_REG16(c, ax), 
 								 ^)
 
-		TRACK_NEED_REG16(c->instr, ax);
-		TRACK_INIT_REG16(c->instr, ax);
-
 	}
 	else
 	{
@@ -391,9 +314,6 @@ int32_t instr_xor_35(struct emu_cpu *c, struct emu_cpu_instruction *i)
 								 c->reg[eax], 
 								 ^)
 
-		TRACK_NEED_REG32(c->instr, eax);
-		TRACK_INIT_REG32(c->instr, eax);
-
 	}
 
 	return 0;
@@ -402,8 +322,6 @@ int32_t instr_xor_35(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_1_80_xor(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if( i->modrm.mod != 3 )
 	{
 		uint8_t dst;
@@ -424,13 +342,10 @@ int32_t instr_group_1_80_xor(struct emu_cpu *c, struct emu_cpu_instruction *i)
 		/* reg8[rm] <-- reg8[rm] <OPC> imm8 */
 		INSTR_CALC_AND_SET_FLAGS(8, 
 								 c, 
-								 *c->reg8[i->modrm.rm], 
+								 CPU_REG8(c, i->modrm.rm), 
 								 *i->imm8, 
-								 *c->reg8[i->modrm.rm],
+								 CPU_REG8(c, i->modrm.rm),
 								 ^)
-
-		TRACK_INIT_REG8(c->instr, i->modrm.rm);
-		TRACK_NEED_REG8(c->instr, i->modrm.rm);
 	}
 
 	return 0;
@@ -439,8 +354,6 @@ int32_t instr_group_1_80_xor(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_1_81_xor(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 		if ( i->prefixes & PREFIX_OPSIZE )
@@ -493,13 +406,10 @@ int32_t instr_group_1_81_xor(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			 */
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 *i->imm16, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 ^)
-
-			TRACK_NEED_REG16(c->instr, i->modrm.rm);
-			TRACK_INIT_REG16(c->instr, i->modrm.rm);
 		}
 		else
 		{
@@ -514,9 +424,6 @@ int32_t instr_group_1_81_xor(struct emu_cpu *c, struct emu_cpu_instruction *i)
 									 c->reg[i->modrm.rm], 
 									 ^)
 
-			TRACK_NEED_REG32(c->instr, i->modrm.rm);
-			TRACK_INIT_REG32(c->instr, i->modrm.rm);
-
 
 		}
 	}
@@ -525,8 +432,6 @@ int32_t instr_group_1_81_xor(struct emu_cpu *c, struct emu_cpu_instruction *i)
 
 int32_t instr_group_1_83_xor(struct emu_cpu *c, struct emu_cpu_instruction *i)
 {
-	TRACK_INIT_ALL_FLAGS(c->instr);
-
 	if ( i->modrm.mod != 3 )
 	{
 
@@ -583,14 +488,11 @@ int32_t instr_group_1_83_xor(struct emu_cpu *c, struct emu_cpu_instruction *i)
 			int16_t sexd = (int8_t)*i->imm8;
 			INSTR_CALC_AND_SET_FLAGS(16, 
 									 c, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 sexd, 
-									 *c->reg16[i->modrm.rm], 
+									 CPU_REG16(c, i->modrm.rm), 
 									 ^)
 
-			TRACK_NEED_REG16(c->instr, i->modrm.rm);
-			TRACK_INIT_REG16(c->instr, i->modrm.rm);
-
 		}
 		else
 		{
@@ -607,9 +509,6 @@ int32_t instr_group_1_83_xor(struct emu_cpu *c, struct emu_cpu_instruction *i)
 									 c->reg[i->modrm.rm], 
 									 ^)
 
-			TRACK_NEED_REG32(c->instr, i->modrm.rm);
-			TRACK_INIT_REG32(c->instr, i->modrm.rm);
-
 		}
 	}
 	return 0;
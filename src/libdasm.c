@@ -286,7 +286,7 @@ int get_real_instruction(BYTE *addr, int *index, int *flags) {
  *   figure out the operand members and fill the struct
  *
  */
-int get_operand(PINST inst, int oflags, PINSTRUCTION instruction,
+int get_operand(const INST *inst, int oflags, PINSTRUCTION instruction,
 	POPERAND op, BYTE *data, int offset, enum Mode mode, int iflags) {
 	BYTE *addr = data + offset;
 	int index = 0, sib = 0, scale = 0;
@@ -832,7 +832,7 @@ int get_operand_string(INSTRUCTION *inst, OPERAND *op,
  *
  */
 int get_instruction(PINSTRUCTION inst, BYTE *addr, enum Mode mode) {
-	PINST ptr = NULL;
+	const INST *ptr = NULL;
 	int index = 0;
 	int flags = 0;
 
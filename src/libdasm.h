@@ -315,7 +315,7 @@ typedef struct _INSTRUCTION {
 	OPERAND op1;		// First operand (if any)
 	OPERAND op2;		// Second operand (if any)
 	OPERAND op3;		// Additional operand (if any)
-	PINST ptr;		// Pointer to instruction table
+	const INST *ptr;	// Pointer to instruction table
 	int flags;		// Instruction flags
 } INSTRUCTION, *PINSTRUCTION;
 
@@ -12,12 +12,12 @@
 
 
 // lock/rep prefix name table
-const char *rep_table[] = {
+const char *const rep_table[] = {
 	 "lock ", "repne ", "rep "
 };
 
 // Register name table (also includes Jcc branch hint prefixes)
-const char *reg_table[11][8] = {
+const char *const reg_table[11][8] = {
 	{ "eax",  "ecx",  "edx",  "ebx",  "esp",  "ebp",  "esi",  "edi"  },
 	{ "ax",   "cx",   "dx",   "bx",   "sp",   "bp",   "si",   "di"   },
 	{ "al",   "cl",   "dl",   "bl",   "ah",   "ch",   "dh",   "bh"   },
@@ -45,7 +45,7 @@ const char *reg_table[11][8] = {
 #define REG_BRANCH    10	// Not registers strictly speaking..
 
 // 1-byte opcodes
-INST inst_table1[256] = {
+const INST inst_table1[256] = {
 	{ INSTRUCTION_TYPE_ADD,    "add",       AM_E|OT_b|P_w,               AM_G|OT_b|P_r,             FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_ADD,    "add",       AM_E|OT_v|P_w,               AM_G|OT_v|P_r,             FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_ADD,    "add",       AM_G|OT_b|P_w,               AM_E|OT_b|P_r,             FLAGS_NONE,   1 },
@@ -316,7 +316,7 @@ INST inst_table1[256] = {
 
 // 2-byte instructions
 
-INST inst_table2[256] = {
+const INST inst_table2[256] = {
         { INSTRUCTION_TYPE_OTHER,  "g6",        AM_E|OT_w,                   FLAGS_NONE,                FLAGS_NONE,   1 },
         { INSTRUCTION_TYPE_OTHER,  "g7",        AM_M|OT_w,                   FLAGS_NONE,                FLAGS_NONE,   1 },
         { INSTRUCTION_TYPE_PRIV,   "lar",       AM_G|OT_v|P_w,               AM_E|OT_w|P_r,             FLAGS_NONE,   1 },
@@ -584,7 +584,7 @@ INST inst_table2[256] = {
 // Yeah, I know, it's waste to use a full 256-instruction table but now
 // I'm prepared for future Intel extensions ;-)
 
-INST inst_table3_66[256] = {
+const INST inst_table3_66[256] = {
         { INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 },
         { INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 },
         { INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 },
@@ -846,7 +846,7 @@ INST inst_table3_66[256] = {
 
 // 3-byte instructions, prefix 0xf2
 
-INST inst_table3_f2[256] = {
+const INST inst_table3_f2[256] = {
         { INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 },
         { INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 },
         { INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 },
@@ -1107,7 +1107,7 @@ INST inst_table3_f2[256] = {
 
 // 3-byte instructions, prefix 0xf3
 
-INST inst_table3_f3[256] = {
+const INST inst_table3_f3[256] = {
         { INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 },
         { INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 },
         { INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 },
@@ -1368,7 +1368,7 @@ INST inst_table3_f3[256] = {
 
 // Extension tables
 
-INST inst_table_ext1_1[8] = {
+const INST inst_table_ext1_1[8] = {
 	{ INSTRUCTION_TYPE_ADD,   "add",        AM_E|OT_b|P_w,               AM_I|OT_b|P_r,             FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_OR,    "or",         AM_E|OT_b|P_w,               AM_I|OT_b|P_r,             FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_ADC,   "adc",        AM_E|OT_b|P_w,               AM_I|OT_b|P_r,             FLAGS_NONE,   1 },
@@ -1378,7 +1378,7 @@ INST inst_table_ext1_1[8] = {
 	{ INSTRUCTION_TYPE_XOR,   "xor",        AM_E|OT_b|P_w,               AM_I|OT_b|P_r,             FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_CMP,   "cmp",        AM_E|OT_b|P_r,               AM_I|OT_b|P_r,             FLAGS_NONE,   1 },
 };
-INST inst_table_ext1_2[8] = {
+const INST inst_table_ext1_2[8] = {
 	{ INSTRUCTION_TYPE_ADD,   "add",        AM_E|OT_v|P_w,               AM_I|OT_v|P_r,             FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_OR,    "or",         AM_E|OT_v|P_w,               AM_I|OT_v|P_r,             FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_ADC,   "adc",        AM_E|OT_v|P_w,               AM_I|OT_v|P_r,             FLAGS_NONE,   1 },
@@ -1388,7 +1388,7 @@ INST inst_table_ext1_2[8] = {
 	{ INSTRUCTION_TYPE_XOR,   "xor",        AM_E|OT_v|P_w,               AM_I|OT_v|P_r,             FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_CMP,   "cmp",        AM_E|OT_v|P_r,               AM_I|OT_v|P_r,             FLAGS_NONE,   1 },
 };
-INST inst_table_ext1_3[8] = {
+const INST inst_table_ext1_3[8] = {
 	{ INSTRUCTION_TYPE_ADD,   "add",        AM_E|OT_v|P_w,               AM_I|OT_b|F_s|P_r,         FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_OR,    "or",         AM_E|OT_v|P_w,               AM_I|OT_b|F_s|P_r,         FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_ADC,   "adc",        AM_E|OT_v|P_w,               AM_I|OT_b|F_s|P_r,         FLAGS_NONE,   1 },
@@ -1399,7 +1399,7 @@ INST inst_table_ext1_3[8] = {
 	{ INSTRUCTION_TYPE_CMP,   "cmp",        AM_E|OT_v|P_r,               AM_I|OT_b|F_s|P_r,         FLAGS_NONE,   1 },
 };
 
-INST inst_table_ext2_1[8] = {
+const INST inst_table_ext2_1[8] = {
 	{ INSTRUCTION_TYPE_ROX,   "rol",        AM_E|OT_b|P_w,               AM_I|OT_b|P_r,             FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_ROX,   "ror",        AM_E|OT_b|P_w,               AM_I|OT_b|P_r,             FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_ROX,   "rcl",        AM_E|OT_b|P_w,               AM_I|OT_b|P_r,             FLAGS_NONE,   1 },
@@ -1409,7 +1409,7 @@ INST inst_table_ext2_1[8] = {
 	{ INSTRUCTION_TYPE_OTHER, NULL,         FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_SHX,   "sar",        AM_E|OT_b|P_w,               AM_I|OT_b|P_r,             FLAGS_NONE,   1 },
 };
-INST inst_table_ext2_2[8] = {
+const INST inst_table_ext2_2[8] = {
 	{ INSTRUCTION_TYPE_ROX,   "rol",        AM_E|OT_v|P_w,               AM_I|OT_b|P_r,             FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_ROX,   "ror",        AM_E|OT_v|P_w,               AM_I|OT_b|P_r,             FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_ROX,   "rcl",        AM_E|OT_v|P_w,               AM_I|OT_b|P_r,             FLAGS_NONE,   1 },
@@ -1419,7 +1419,7 @@ INST inst_table_ext2_2[8] = {
 	{ INSTRUCTION_TYPE_OTHER, NULL,         FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_SHX,   "sar",        AM_E|OT_v|P_w,               AM_I|OT_b|P_r,             FLAGS_NONE,   1 },
 };
-INST inst_table_ext2_3[8] = {
+const INST inst_table_ext2_3[8] = {
 	{ INSTRUCTION_TYPE_ROX,   "rol",        AM_E|OT_b|P_w,               AM_I1|OT_b|P_r,            FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_ROX,   "ror",        AM_E|OT_b|P_w,               AM_I1|OT_b|P_r,            FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_ROX,   "rcl",        AM_E|OT_b|P_w,               AM_I1|OT_b|P_r,            FLAGS_NONE,   1 },
@@ -1429,7 +1429,7 @@ INST inst_table_ext2_3[8] = {
 	{ INSTRUCTION_TYPE_OTHER, NULL,         FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_SHX,   "sar",        AM_E|OT_b|P_w,               AM_I1|OT_b|P_r,            FLAGS_NONE,   1 },
 };
-INST inst_table_ext2_4[8] = {
+const INST inst_table_ext2_4[8] = {
 	{ INSTRUCTION_TYPE_ROX,   "rol",        AM_E|OT_v|P_w,               AM_I1|OT_b|P_r,            FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_ROX,   "ror",        AM_E|OT_v|P_w,               AM_I1|OT_b|P_r,            FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_ROX,   "rcl",        AM_E|OT_v|P_w,               AM_I1|OT_b|P_r,            FLAGS_NONE,   1 },
@@ -1439,7 +1439,7 @@ INST inst_table_ext2_4[8] = {
 	{ INSTRUCTION_TYPE_OTHER, NULL,         FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_SHX,   "sar",        AM_E|OT_v|P_w,               AM_I1|OT_b|P_r,            FLAGS_NONE,   1 },
 };
-INST inst_table_ext2_5[8] = {
+const INST inst_table_ext2_5[8] = {
 	{ INSTRUCTION_TYPE_ROX,   "rol",        AM_E|OT_b|P_w,               AM_REG|REG_CL|OT_b|P_r,    FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_ROX,   "ror",        AM_E|OT_b|P_w,               AM_REG|REG_CL|OT_b|P_r,    FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_ROX,   "rcl",        AM_E|OT_b|P_w,               AM_REG|REG_CL|OT_b|P_r,    FLAGS_NONE,   1 },
@@ -1449,7 +1449,7 @@ INST inst_table_ext2_5[8] = {
 	{ INSTRUCTION_TYPE_OTHER, NULL,         FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_SHX,   "sar",        AM_E|OT_b|P_w,               AM_REG|REG_CL|OT_b|P_r,    FLAGS_NONE,   1 },
 };
-INST inst_table_ext2_6[8] = {
+const INST inst_table_ext2_6[8] = {
 	{ INSTRUCTION_TYPE_ROX,   "rol",        AM_E|OT_v|P_w,               AM_REG|REG_CL|OT_b|P_r,    FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_ROX,   "ror",        AM_E|OT_v|P_w,               AM_REG|REG_CL|OT_b|P_r,    FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_ROX,   "rcl",        AM_E|OT_v|P_w,               AM_REG|REG_CL|OT_b|P_r,    FLAGS_NONE,   1 },
@@ -1460,7 +1460,7 @@ INST inst_table_ext2_6[8] = {
 	{ INSTRUCTION_TYPE_SHX,   "sar",        AM_E|OT_v|P_w,               AM_REG|REG_CL|OT_b|P_r,    FLAGS_NONE,   1 },
 };
 
-INST inst_table_ext3_1[8] = {
+const INST inst_table_ext3_1[8] = {
 	{ INSTRUCTION_TYPE_TEST,   "test",      AM_E|OT_b|P_r,               AM_I|OT_b|P_r,             FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_NOT,    "not",       AM_E|OT_b|P_w,               FLAGS_NONE,                FLAGS_NONE,   1 },
@@ -1470,7 +1470,7 @@ INST inst_table_ext3_1[8] = {
 	{ INSTRUCTION_TYPE_DIV,    "div",       AM_E|OT_b|P_w,               FLAGS_NONE|P_r,            FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_IDIV,   "idiv",      AM_E|OT_b|P_w,               FLAGS_NONE|P_r,            FLAGS_NONE,   1 },
 };
-INST inst_table_ext3_2[8] = {
+const INST inst_table_ext3_2[8] = {
 	{ INSTRUCTION_TYPE_TEST,   "test",      AM_E|OT_v|P_r,               AM_I|OT_v|P_r,             FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_NOT,    "not",       AM_E|OT_v|P_w,               FLAGS_NONE,                FLAGS_NONE,   1 },
@@ -1481,7 +1481,7 @@ INST inst_table_ext3_2[8] = {
 	{ INSTRUCTION_TYPE_IDIV,   "idiv",      AM_E|OT_v|P_w,               FLAGS_NONE|P_r,            FLAGS_NONE,   1 },
 };
 
-INST inst_table_ext4[8] = {
+const INST inst_table_ext4[8] = {
 	{ INSTRUCTION_TYPE_INC,    "inc",       AM_E|OT_b|P_r,               FLAGS_NONE,                FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_DEC,    "dec",       AM_E|OT_b,                   FLAGS_NONE,                FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
@@ -1492,7 +1492,7 @@ INST inst_table_ext4[8] = {
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 };
 
-INST inst_table_ext5[8] = {
+const INST inst_table_ext5[8] = {
 	{ INSTRUCTION_TYPE_INC,    "inc",       AM_E|OT_v|P_r,               FLAGS_NONE,                FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_DEC,    "dec",       AM_E|OT_v,                   FLAGS_NONE,                FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_CALL,   "call",      AM_E|OT_v|P_x,               FLAGS_NONE,                FLAGS_NONE,   1 },
@@ -1503,7 +1503,7 @@ INST inst_table_ext5[8] = {
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 };
 
-INST inst_table_ext6[8] = {
+const INST inst_table_ext6[8] = {
         { INSTRUCTION_TYPE_SLDT,   "sldt",      AM_E|OT_w|P_r,               FLAGS_NONE,                FLAGS_NONE,   1 },
         { INSTRUCTION_TYPE_PRIV,   "str",       AM_E|OT_w|P_w,               FLAGS_NONE,                FLAGS_NONE,   1 },
         { INSTRUCTION_TYPE_PRIV,   "lldt",      AM_E|OT_w|P_w,               FLAGS_NONE,                FLAGS_NONE,   1 },
@@ -1514,7 +1514,7 @@ INST inst_table_ext6[8] = {
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 };
 
-INST inst_table_ext7[8] = {
+const INST inst_table_ext7[8] = {
         { INSTRUCTION_TYPE_SGDT,  "sgdt",       AM_M|OT_d|P_w,               FLAGS_NONE,                FLAGS_NONE,   1 },
         { INSTRUCTION_TYPE_SIDT,  "sidt",       AM_M|OT_d|P_w,               FLAGS_NONE,                FLAGS_NONE,   1 },
         { INSTRUCTION_TYPE_PRIV,  "lgdt",       AM_M|OT_d|P_w,               FLAGS_NONE,                FLAGS_NONE,   1 },
@@ -1524,12 +1524,12 @@ INST inst_table_ext7[8] = {
         { INSTRUCTION_TYPE_PRIV,  "lmsw",       AM_E|OT_w|P_w,               FLAGS_NONE,                FLAGS_NONE,   1 },
         { INSTRUCTION_TYPE_PRIV,  "invlpg",     AM_M|OT_b|P_r,               FLAGS_NONE,                FLAGS_NONE,   1 },
 };
-INST inst_monitor =
+const INST inst_monitor =
 	{ INSTRUCTION_TYPE_OTHER,  "monitor",   FLAGS_NONE|P_w,              FLAGS_NONE|P_r,            FLAGS_NONE,   0 };
-INST inst_mwait =
+const INST inst_mwait =
 	{ INSTRUCTION_TYPE_OTHER,  "mwait",     FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 };
 
-INST inst_table_ext8[8] = {
+const INST inst_table_ext8[8] = {
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
@@ -1540,7 +1540,7 @@ INST inst_table_ext8[8] = {
         { INSTRUCTION_TYPE_BTC,    "btc",       AM_E|OT_v|P_r,               AM_I|OT_b|P_r,             FLAGS_NONE,   1 },
 };
 
-INST inst_table_ext9[8] = {
+const INST inst_table_ext9[8] = {
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_SSE,   "cmpxch8b",   AM_M|OT_q,                   FLAGS_NONE,                FLAGS_NONE,   1 }, 
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
@@ -1551,7 +1551,7 @@ INST inst_table_ext9[8] = {
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 };
 
-INST inst_table_ext10[8] = {
+const INST inst_table_ext10[8] = {
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
@@ -1563,7 +1563,7 @@ INST inst_table_ext10[8] = {
 };
 
 // XXX: not used yet
-INST inst_table_ext11[8] = {
+const INST inst_table_ext11[8] = {
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
@@ -1575,7 +1575,7 @@ INST inst_table_ext11[8] = {
 };
 
 // XXX: intel manual says AM_P.. but that seems to produce wrong disasm
-INST inst_table_ext12[8] = {
+const INST inst_table_ext12[8] = {
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
         { INSTRUCTION_TYPE_MMX,    "psrlw",     AM_Q|OT_q|P_w,               AM_I|OT_b|P_r,             FLAGS_NONE,   1 },
@@ -1586,7 +1586,7 @@ INST inst_table_ext12[8] = {
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 };
 // XXX: intel manual says AM_P.. but that seems to produce wrong disasm
-INST inst_table_ext12_66[8] = {
+const INST inst_table_ext12_66[8] = {
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
         { INSTRUCTION_TYPE_SSE,    "psrlw",     AM_W|OT_dq|P_w,              AM_I|OT_b|P_r,             FLAGS_NONE,   1 },
@@ -1598,7 +1598,7 @@ INST inst_table_ext12_66[8] = {
 };
 
 // XXX: intel manual says AM_P.. but that seems to produce wrong disasm
-INST inst_table_ext13[8] = {
+const INST inst_table_ext13[8] = {
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
         { INSTRUCTION_TYPE_MMX,    "psrld",     AM_Q|OT_q|P_w,               AM_I|OT_b|P_r,             FLAGS_NONE,   1 },
@@ -1609,7 +1609,7 @@ INST inst_table_ext13[8] = {
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 };
 // XXX: intel manual says AM_P.. but that seems to produce wrong disasm
-INST inst_table_ext13_66[8] = {
+const INST inst_table_ext13_66[8] = {
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
         { INSTRUCTION_TYPE_SSE,    "psrld",     AM_W|OT_dq|P_w,              AM_I|OT_b|P_r,             FLAGS_NONE,   1 },
@@ -1621,7 +1621,7 @@ INST inst_table_ext13_66[8] = {
 };
 
 // XXX: intel manual says AM_P.. but that seems to produce wrong disasm
-INST inst_table_ext14[8] = {
+const INST inst_table_ext14[8] = {
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
         { INSTRUCTION_TYPE_MMX,    "psrlq",     AM_Q|OT_q|P_w,               AM_I|OT_b|P_r,             FLAGS_NONE,   1 },
@@ -1632,7 +1632,7 @@ INST inst_table_ext14[8] = {
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 };
 // XXX: intel manual says AM_P.. but that seems to produce wrong disasm
-INST inst_table_ext14_66[8] = {
+const INST inst_table_ext14_66[8] = {
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
         { INSTRUCTION_TYPE_SSE,    "psrlq",     AM_W|OT_dq|P_w,              AM_I|OT_b|P_r,             FLAGS_NONE,   1 },
@@ -1643,7 +1643,7 @@ INST inst_table_ext14_66[8] = {
         { INSTRUCTION_TYPE_SSE,    "pslldq",    AM_W|OT_dq|P_w,              AM_I|OT_b|P_r,             FLAGS_NONE,   1 },
 };
 
-INST inst_table_ext15[8] = {
+const INST inst_table_ext15[8] = {
         { INSTRUCTION_TYPE_OTHER, "fxsave",     AM_E|OT_v,                   FLAGS_NONE,                FLAGS_NONE,   1 },
         { INSTRUCTION_TYPE_OTHER, "fxrstor",    AM_E|OT_v,                   FLAGS_NONE,                FLAGS_NONE,   1 },
         { INSTRUCTION_TYPE_OTHER, "ldmxcsr",    AM_E|OT_v,                   FLAGS_NONE,                FLAGS_NONE,   1 },
@@ -1654,7 +1654,7 @@ INST inst_table_ext15[8] = {
         { INSTRUCTION_TYPE_OTHER, "sfence",     AM_E|OT_v,                   FLAGS_NONE,                FLAGS_NONE,   1 },
 };
 
-INST inst_table_ext16[8] = {
+const INST inst_table_ext16[8] = {
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_OTHER,  NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
@@ -1667,7 +1667,7 @@ INST inst_table_ext16[8] = {
 
 // Table of extension tables
 
-INST * inst_table_ext[25] = {
+const INST * inst_table_ext[25] = {
 	inst_table_ext1_1,
 	inst_table_ext1_2,
 	inst_table_ext1_3,
@@ -1706,7 +1706,7 @@ INST * inst_table_ext[25] = {
  *   the index can be calculated by "index = MODRM - 0xb8"
  *
  */
-INST inst_table_fpu_d8[72] = {
+const INST inst_table_fpu_d8[72] = {
 	{ INSTRUCTION_TYPE_FADD,   "fadds",     AM_E|OT_d|P_w,               FLAGS_NONE|P_r,            FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_FMUL,   "fmuls",     AM_E|OT_d|P_w,               FLAGS_NONE|P_r,            FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_FCOM,   "fcoms",     AM_E|OT_d|P_w,               FLAGS_NONE|P_r,            FLAGS_NONE,   1 },
@@ -1780,7 +1780,7 @@ INST inst_table_fpu_d8[72] = {
 	{ INSTRUCTION_TYPE_FDIVR,  "fdivr",     AM_REG|REG_ST0|F_f|P_w,      AM_REG|REG_ST6|F_f|P_r,    FLAGS_NONE,   0 },
 	{ INSTRUCTION_TYPE_FDIVR,  "fdivr",     AM_REG|REG_ST0|F_f|P_w,      AM_REG|REG_ST7|F_f|P_r,    FLAGS_NONE,   0 },
 };
-INST inst_table_fpu_d9[72] = {
+const INST inst_table_fpu_d9[72] = {
 	{ INSTRUCTION_TYPE_FLD,    "flds",      AM_E|OT_d,                   FLAGS_NONE,                FLAGS_NONE,   1 }, 
 	{ INSTRUCTION_TYPE_FPU,    NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_FST,    "fst",       AM_E|OT_d|P_w,               FLAGS_NONE,                FLAGS_NONE,   1 },
@@ -1851,7 +1851,7 @@ INST inst_table_fpu_d9[72] = {
 	{ INSTRUCTION_TYPE_FPU,    "fsin",      FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_FPU,    "fcos",      FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 },
 };
-INST inst_table_fpu_da[72] = {
+const INST inst_table_fpu_da[72] = {
 	{ INSTRUCTION_TYPE_FIADD,  "fiaddl",    AM_E|OT_d|P_w,               FLAGS_NONE,                FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_FIMUL,  "fimull",    AM_E|OT_d|P_w,               FLAGS_NONE,                FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_FICOM,  "ficoml",    AM_E|OT_d|P_w,               FLAGS_NONE,                FLAGS_NONE,   1 },
@@ -1927,7 +1927,7 @@ INST inst_table_fpu_da[72] = {
 };
 
 // XXX: fsetpm??
-INST inst_table_fpu_db[72] = {
+const INST inst_table_fpu_db[72] = {
 	{ INSTRUCTION_TYPE_FILD,   "fildl",     AM_E|OT_d|P_w,               FLAGS_NONE,                FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_FISTTP, "fisttp",    AM_E|OT_d|P_w,               FLAGS_NONE,                FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_FIST,   "fistl",     AM_E|OT_d|P_w,               FLAGS_NONE,                FLAGS_NONE,   1 },
@@ -2001,7 +2001,7 @@ INST inst_table_fpu_db[72] = {
 	{ INSTRUCTION_TYPE_FPU,    NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_FPU,    NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 };
-INST inst_table_fpu_dc[72] = {
+const INST inst_table_fpu_dc[72] = {
 	{ INSTRUCTION_TYPE_FADD,   "faddl",     AM_E|OT_q|P_w,               FLAGS_NONE|P_r,            FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_FMUL,   "fmull",     AM_E|OT_q|P_w,               FLAGS_NONE|P_r,            FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_FCOM,   "fcoml",     AM_E|OT_q|P_w,               FLAGS_NONE|P_r,            FLAGS_NONE,   1 },
@@ -2075,7 +2075,7 @@ INST inst_table_fpu_dc[72] = {
 	{ INSTRUCTION_TYPE_FDIV,   "fdiv",      AM_REG|REG_ST6|F_f|P_w,      AM_REG|REG_ST0|F_f|P_r,    FLAGS_NONE,   0 },
 	{ INSTRUCTION_TYPE_FDIV,   "fdiv",      AM_REG|REG_ST7|F_f|P_w,      AM_REG|REG_ST0|F_f|P_r,    FLAGS_NONE,   0 },
 };
-INST inst_table_fpu_dd[72] = {
+const INST inst_table_fpu_dd[72] = {
 	{ INSTRUCTION_TYPE_FLD,    "fldl",      AM_E|OT_q,                   FLAGS_NONE,                FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_FISTTP, "fisttp",    AM_E|OT_q|P_w,               FLAGS_NONE,                FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_FST,    "fstl",      AM_E|OT_q|P_w,               FLAGS_NONE,                FLAGS_NONE,   1 },
@@ -2152,7 +2152,7 @@ INST inst_table_fpu_dd[72] = {
 	{ INSTRUCTION_TYPE_FPU,    NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 	{ INSTRUCTION_TYPE_FPU,    NULL,        FLAGS_NONE,                  FLAGS_NONE,                FLAGS_NONE,   0 }, 
 };
-INST inst_table_fpu_de[72] = {
+const INST inst_table_fpu_de[72] = {
 	{ INSTRUCTION_TYPE_FIADD,  "fiadd",     AM_E|OT_w|P_w,               FLAGS_NONE,                FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_FIMUL,  "fimul",     AM_E|OT_w|P_w,               FLAGS_NONE,                FLAGS_NONE,   1 },
 	{ INSTRUCTION_TYPE_FICOM,  "ficom",     AM_E|OT_w|P_w,               FLAGS_NONE,                FLAGS_NONE,   1 },
@@ -2227,7 +2227,7 @@ INST inst_table_fpu_de[72] = {
 	{ INSTRUCTION_TYPE_FDIVP,  "fdivp",     AM_REG|REG_ST7|F_f|P_w,      AM_REG|REG_ST0|F_f|P_r,    FLAGS_NONE,   0 },
 };
 
-INST inst_table_fpu_df[72] = {
+const INST inst_table_fpu_df[72] = {
 	{ INSTRUCTION_TYPE_FILD,   "fild",      AM_E|OT_w|P_w,               FLAGS_NONE,                FLAGS_NONE,   1 },
 	// fisttp: IA-32 2004
 	{ INSTRUCTION_TYPE_FISTTP, "fisttp",    AM_E|OT_w|P_w,               FLAGS_NONE,                FLAGS_NONE,   1 },
@@ -2313,7 +2313,7 @@ INST inst_table_fpu_df[72] = {
  * where index is determined by the MODRM byte.
  *
  */
-INST * inst_table4[8] = {
+const INST * inst_table4[8] = {
 	inst_table_fpu_d8,
 	inst_table_fpu_d9,
 	inst_table_fpu_da,
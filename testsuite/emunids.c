@@ -31,6 +31,15 @@
 struct emu *emu;
 struct ip;
 
+/* the bytes of a half stream kept for the next packet */
+#define STREAM_WINDOW 2048
+
+struct connection
+{
+	struct emu_shellcode_stream *client;
+	struct emu_shellcode_stream *server;
+};
+
 char *adres (struct tuple4 addr)
 {
 	static char buf[256];
@@ -42,11 +51,13 @@ char *adres (struct tuple4 addr)
 }
 
 
-void tcp_callback (struct tcp_stream *a_tcp, void ** this_time_not_needed)
+void tcp_callback (struct tcp_stream *a_tcp, void **param)
 {
 //	char buf[1024];
 //	strcpy (buf, adres (a_tcp->addr)); // we put conn params into buf
 
+	struct connection *conn = *param;
+
 	if ( a_tcp->nids_state == NIDS_JUST_EST )
 	{
 		a_tcp->client.collect++; 
@@ -55,49 +66,59 @@ void tcp_callback (struct tcp_stream *a_tcp, void ** this_time_not_needed)
 		a_tcp->server.collect++; 						  
 		a_tcp->server.collect_urg++; 
 
+		conn = malloc(sizeof(struct connection));
+		conn->client = emu_shellcode_stream_new(emu, STREAM_WINDOW);
+		conn->server = emu_shellcode_stream_new(emu, STREAM_WINDOW);
+		*param = conn;
+
 //		fprintf (stderr, "%s established\n", buf);
-	}/* else
-	if ( a_tcp->nids_state == NIDS_CLOSE )
-	{
-		fprintf (stderr, "%s closing\n", buf);
 	}else
-	if ( a_tcp->nids_state == NIDS_RESET )
+	if ( a_tcp->nids_state == NIDS_CLOSE || 
+		 a_tcp->nids_state == NIDS_RESET || 
+		 a_tcp->nids_state == NIDS_TIMED_OUT )
 	{
-		fprintf (stderr, "%s reset\n", buf);
-	} */ else
+		if ( conn != NULL )
+		{
+			emu_shellcode_stream_finish(conn->client);
+			emu_shellcode_stream_finish(conn->server);
+			free(conn);
+			*param = NULL;
+		}
+	}else
 	if ( a_tcp->nids_state == NIDS_DATA )
 	{
 
 		struct half_stream *hlf;
+		struct emu_shellcode_stream *stream;
 		char *data;
 		int size;
 
 		if ( a_tcp->server.count_new_urg || a_tcp->server.count_new )
 		{
 			hlf = &a_tcp->server;
+			stream = conn->server;
 		}else
 		if ( a_tcp->client.count_new_urg ||  a_tcp->client.count_new )
 		{
 			hlf = &a_tcp->client;
+			stream = conn->client;
 		}else
 		{
 			return;
 		}
 
-        size = hlf->count - hlf->offset;
-		data = hlf->data;
+		/* only the new data, the stream keeps what it needs of the old */
+		size = hlf->count_new;
+		data = hlf->data + (hlf->count - hlf->offset) - size;
 
 //		printf("size is %i\n", size);
 //		printf("count %i offset %i size %i\n",hlf->count, hlf->offset, size);
 
-		if ( emu_shellcode_test(emu, (uint8_t *)data, size) >= 0 )
+		if ( emu_shellcode_stream_feed(stream, (uint8_t *)data, size) >= 0 )
 		{
 			fprintf(stderr, "suspecting shellcode in connection %s\n", adres(a_tcp->addr));
 		}
 
-		if (size > 2048)
-			nids_discard(a_tcp, abs(2048-size));
-		
 		emu_memory_clear(emu_memory_get(emu));
 	}
 
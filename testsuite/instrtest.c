@@ -45,6 +45,7 @@
 #include "emu/emu_cpu.h"
 #include "emu/emu_log.h"
 #include "emu/emu_cpu_data.h"
+#include "emu/emu_cpu_decode.h"
 
 #define CODE_OFFSET 0x417001
 
@@ -1030,6 +1031,94 @@ void dump_export_table(void)
 */
 }
 
+/* decode buf with both decoders, 0 if they agree */
+static int decode_compare(const uint8_t *buf, size_t len)
+{
+	struct emu_decoded a, b;
+	int32_t ra, rb;
+
+	ra = emu_cpu_decode_instruction(buf, len, &a);
+	rb = emu_cpu_decode_reference(buf, len, &b);
+
+	/* pointers into the structs themselves */
+	a.instr.cpu.imm8 = b.instr.cpu.imm8 = NULL;
+	a.instr.cpu.imm16 = b.instr.cpu.imm16 = NULL;
+
+	/* the track tables against the switch they are generated from */
+	if( ra > 0 && rb > 0 )
+	{
+		emu_cpu_decode_track(&a);
+		emu_cpu_decode_track_reference(&b);
+	}
+
+	if( ra == rb && memcmp(&a, &b, sizeof(struct emu_decoded)) == 0 &&
+		emu_cpu_decode_length(buf, len) == ra )
+		return 0;
+
+	printf("decoder "FAILED" %i vs %i for", ra, rb);
+	for( ra = 0; ra < len; ra++ )
+		printf(" %02x", buf[ra]);
+	printf("\n");
+	return -1;
+}
+
+/**
+ * check the table driven decoder and the track tables against the
+ * references for every opcode, every modrm byte and every sib byte, with a
+ * few prefixes and with the instruction cut short
+ */
+int test_decoder(void)
+{
+	static const uint8_t prefixes[][2] = {
+		{0, 0}, {1, 0x66}, {1, 0xf3}, {1, 0xf2}, {2, 0x2e}, {1, 0x64}, {1, 0x67}
+	};
+	uint8_t buf[16];
+	int p, esc, opc, modrm, sib, fill, n;
+	int tested = 0;
+
+	for( p = 0; p < sizeof(prefixes) / sizeof(prefixes[0]); p++ )
+	for( esc = 0; esc < 2; esc++ )
+	for( opc = 0; opc < 0x100; opc++ )
+	for( modrm = 0; modrm < 0x100; modrm++ )
+	for( sib = 0; sib < 0x100; sib++ )
+	{
+		/* the sib byte only matters for memory operands with rm 4 */
+		if( sib != 0 && ((modrm & 7) != 4 || (modrm >> 6) == 3) )
+			break;
+
+		n = 0;
+		if( prefixes[p][0] == 2 )
+			buf[n++] = 0x66;
+		if( prefixes[p][0] != 0 )
+			buf[n++] = prefixes[p][1];
+		if( esc )
+			buf[n++] = 0x0f;
+		buf[n++] = opc;
+		buf[n++] = modrm;
+		buf[n++] = sib;
+		for( fill = 0; n < sizeof(buf); n++, fill++ )
+			buf[n] = 0x80 + fill * 0x11;
+
+		/* the whole buffer and the buffer ending within the instruction */
+		for( n = sizeof(buf); n > 0; n-- )
+		{
+			struct emu_decoded d;
+			int32_t ret = emu_cpu_decode_reference(buf, n, &d);
+
+			if( decode_compare(buf, n) != 0 )
+				return -1;
+			tested++;
+
+			if( ret <= 0 )
+				break;
+			n = ret;
+		}
+	}
+
+	printf("decoder "SUCCESS" %i decodes match the reference\n", tested);
+	return 0;
+}
+
 int main(int argc, char *argv[])
 {
 	memset(&opts,0,sizeof(struct run_time_options));
@@ -1086,6 +1175,9 @@ int main(int argc, char *argv[])
 	if ( test(opts.testnumber) != 0 )
 		return -1;
 
+	if ( opts.testnumber == -1 && test_decoder() != 0 )
+		return -1;
+
 	cleanup();
 
 //	dump_export_table();
@@ -0,0 +1,247 @@
+/********************************************************************************
+ *                               libemu
+ *
+ *                    - x86 shellcode emulation -
+ *
+ *
+ * Copyright (C) 2007  Paul Baecher & Markus Koetter
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ * 
+ * 
+ *             contact nepenthesdev@users.sourceforge.net  
+ *
+ *******************************************************************************/
+
+
+/*
+ * loop fast forwarding
+ *
+ * runs decoder loops with and without the loop_fastforward option and
+ * checks both runs end in the same registers, flags and memory, and that
+ * the fast forwarded run took fewer steps where the loop can be fast
+ * forwarded.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "emu/emu.h"
+#include "emu/emu_memory.h"
+#include "emu/emu_cpu.h"
+#include "emu/emu_cpu_data.h"
+
+#define CODE_OFFSET 0x1000
+#define DATA_OFFSET 0x2000
+#define DATA_SIZE   0x800
+#define STEPS       100000
+
+struct loop_test
+{
+	const char *name;
+	const char *code;
+	uint32_t size;
+	uint32_t reg[8];
+	bool forwarded;		/* the fast forwarded run needs fewer steps */
+};
+
+#define D DATA_OFFSET
+#define C CODE_OFFSET
+
+static struct loop_test tests[] =
+{
+	{
+		"xor byte imm8, inc, loop",
+		"\x80\x36\x99"			/* xor byte [esi],0x99 */
+		"\x46"					/* inc esi */
+		"\xe2\xfa",				/* loop -6 */
+		6,
+		{0, 0x100, 0, 0, 0, 0, D, 0}, true
+	},
+	{
+		"add dword imm32 disp8, sub -4, dec/jnz",
+		"\x81\x43\x13\x44\x33\x22\x11"	/* add dword [ebx+0x13],0x11223344 */
+		"\x83\xeb\xfc"			/* sub ebx,-4 */
+		"\x49"					/* dec ecx */
+		"\x75\xf3",				/* jnz -13 */
+		13,
+		{0, 0x1f0, 0, D, 0, 0, 0, 0}, true
+	},
+	{
+		"sub byte reg8, dec, loop",
+		"\x28\x1f"				/* sub [edi],bl */
+		"\x4f"					/* dec edi */
+		"\xe2\xfb",				/* loop -5 */
+		5,
+		{0, 0x300, 0, 0x37, 0, 0, 0, D + 0x2ff}, true
+	},
+	{
+		"xor dword reg32, add 4, dec ebp/jnz",
+		"\x31\x10"				/* xor [eax],edx */
+		"\x83\xc0\x04"			/* add eax,4 */
+		"\x4d"					/* dec ebp */
+		"\x75\xf8",				/* jnz -8 */
+		8,
+		{D, 0, 0xdeadbeef, 0, 0, 0x180, 0, 0}, true
+	},
+	{
+		"inc, xor byte imm8, loop",
+		"\x46"					/* inc esi */
+		"\x80\x36\x5a"			/* xor byte [esi],0x5a */
+		"\xe2\xfa",				/* loop -6 */
+		6,
+		{0, 0x200, 0, 0, 0, 0, D, 0}, true
+	},
+	{
+		"sub dword imm8 disp8, sub 4, loop",
+		"\x83\x6e\x10\x81"		/* sub dword [esi+0x10],-0x7f */
+		"\x83\xee\x04"			/* sub esi,4 */
+		"\xe2\xf7",				/* loop -9 */
+		9,
+		{0, 0x100, 0, 0, 0, 0, D + 0x3f0, 0}, true
+	},
+	{
+		"few iterations",
+		"\x80\x36\x99"			/* xor byte [esi],0x99 */
+		"\x46"					/* inc esi */
+		"\xe2\xfa",				/* loop -6 */
+		6,
+		{0, 3, 0, 0, 0, 0, D, 0}, false
+	},
+	{
+		/* the loop runs into itself and turns into xor [edi],ebx */
+		"overwrites itself",
+		"\x30\x1e"				/* xor [esi],bl */
+		"\x46"					/* inc esi */
+		"\xe2\xfb",				/* loop -5 */
+		5,
+		{0, 0x48, 0, 1, 0, 0, C - 0x40, D}, false
+	},
+};
+
+#undef C
+#undef D
+
+struct loop_state
+{
+	uint32_t reg[8];
+	uint32_t eflags;
+	uint32_t eip;
+	uint32_t steps;
+	uint8_t code[0x100];
+	uint8_t data[DATA_SIZE];
+};
+
+static int run(struct loop_test *t, bool forward, struct loop_state *s)
+{
+	struct emu *e = emu_new();
+	struct emu_cpu *cpu = emu_cpu_get(e);
+	struct emu_memory *mem = emu_memory_get(e);
+	uint8_t fill[0x100 + DATA_SIZE];
+	uint32_t end = CODE_OFFSET + t->size;
+	uint32_t i;
+	int ret = 0;
+
+	memset(s, 0, sizeof(struct loop_state));
+
+	for( i = 0; i < sizeof(fill); i++ )
+		fill[i] = i * 7 + 3;
+
+	/* some bytes in front of the code, for the loop running into itself */
+	emu_memory_write_block(mem, CODE_OFFSET - 0x80, fill, 0x80);
+	emu_memory_write_block(mem, CODE_OFFSET, (void *)t->code, t->size);
+	emu_memory_write_block(mem, DATA_OFFSET, fill + 0x100, DATA_SIZE);
+
+	for( i = 0; i < 8; i++ )
+		emu_cpu_reg32_set(cpu, i, t->reg[i]);
+
+	emu_cpu_eflags_set(cpu, 0);
+	emu_cpu_eip_set(cpu, CODE_OFFSET);
+
+	if( forward == true )
+		emu_cpu_option_set(cpu, loop_fastforward);
+
+	for( i = 0; i < STEPS && emu_cpu_eip_get(cpu) != end; i++ )
+	{
+		if( emu_cpu_parse(cpu) != 0 || emu_cpu_step(cpu) != 0 )
+		{
+			printf("%s: %s\n", t->name, emu_strerror(e));
+			ret = -1;
+			break;
+		}
+	}
+
+	s->steps = i;
+
+	if( i == STEPS )
+	{
+		printf("%s: did not leave the loop\n", t->name);
+		ret = -1;
+	}
+
+	for( i = 0; i < 8; i++ )
+		s->reg[i] = emu_cpu_reg32_get(cpu, i);
+
+	s->eflags = emu_cpu_eflags_get(cpu);
+	s->eip = emu_cpu_eip_get(cpu);
+	emu_memory_read_block(mem, CODE_OFFSET - 0x80, s->code, sizeof(s->code));
+	emu_memory_read_block(mem, DATA_OFFSET, s->data, DATA_SIZE);
+
+	emu_free(e);
+	return ret;
+}
+
+int main(void)
+{
+	struct loop_state slow, fast;
+	int failed = 0;
+	int i;
+
+	for( i = 0; i < sizeof(tests) / sizeof(struct loop_test); i++ )
+	{
+		struct loop_test *t = &tests[i];
+		uint32_t slow_steps, fast_steps;
+		int result = 0;
+
+		if( run(t, false, &slow) != 0 || run(t, true, &fast) != 0 )
+			result = -1;
+
+		slow_steps = slow.steps;
+		fast_steps = fast.steps;
+		slow.steps = fast.steps = 0;
+
+		if( result == 0 && memcmp(&slow, &fast, sizeof(struct loop_state)) != 0 )
+		{
+			printf("%s: the fast forwarded run ends in a different state\n", t->name);
+			result = -1;
+		}
+
+		if( result == 0 && t->forwarded == true && fast_steps >= slow_steps )
+		{
+			printf("%s: the loop was not fast forwarded\n", t->name);
+			result = -1;
+		}
+
+		printf("%-40s %s (%i/%i steps)\n", t->name, result == 0 ? "ok" : "failed", fast_steps, slow_steps);
+
+		if( result != 0 )
+			failed++;
+	}
+
+	return failed != 0;
+}
@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <malloc.h>
 #include "emu/emu.h"
 #include "emu/emu_memory.h"
 
@@ -25,15 +26,139 @@ void test_alloc(struct emu *e)
 }
 
 
+int test_checkpoint(struct emu *e)
+{
+	struct emu_memory *m = emu_memory_get(e);
+	uint32_t dword;
+	uint8_t byte;
+	int failed = 0;
+
+	emu_memory_write_dword(m, 0x1000, 0x11223344);
+	emu_memory_checkpoint(m);
+
+	/* a page which existed, one which did not, and a block across both */
+	emu_memory_write_dword(m, 0x1000, 0xdeadbeef);
+	emu_memory_write_byte(m, 0x5000, 0x42);
+	emu_memory_write_dword(m, 0x1ffe, 0xcafebabe);
+
+	emu_memory_rollback(m);
+
+	if( emu_memory_read_dword(m, 0x1000, &dword) != 0 || dword != 0x11223344 )
+	{
+		printf("checkpoint: 0x1000 is 0x%08x, not restored\n", dword);
+		failed++;
+	}
+
+	if( emu_memory_read_byte(m, 0x5000, &byte) == 0 || emu_memory_read_byte(m, 0x2000, &byte) == 0 )
+	{
+		printf("checkpoint: pages written after the checkpoint are still mapped\n");
+		failed++;
+	}
+
+	/* the checkpoint stays, roll back a second time */
+	emu_memory_write_dword(m, 0x1000, 0);
+	emu_memory_rollback(m);
+	emu_memory_read_dword(m, 0x1000, &dword);
+	if( dword != 0x11223344 )
+	{
+		printf("checkpoint: second rollback failed\n");
+		failed++;
+	}
+
+	emu_memory_checkpoint_drop(m);
+	if( emu_memory_rollback(m) != -1 )
+	{
+		printf("checkpoint: rollback without a checkpoint succeeded\n");
+		failed++;
+	}
+
+	printf("checkpoint %s\n", failed == 0 ? "ok" : "failed");
+	return failed;
+}
+
+int test_reset(struct emu *e)
+{
+	struct emu_memory *m = emu_memory_get(e);
+	uint32_t dword = 0;
+	uint8_t byte;
+	int failed = 0;
+
+	emu_memory_write_dword(m, 0x1000, 0xdeadbeef);
+	emu_memory_checkpoint(m);
+	emu_memory_write_dword(m, 0x9000, 0xdeadbeef);
+
+	emu_reset(e);
+
+	if( emu_memory_read_byte(m, 0x1000, &byte) == 0 || emu_memory_read_byte(m, 0x9000, &byte) == 0 )
+	{
+		printf("reset: pages are still mapped\n");
+		failed++;
+	}
+
+	if( emu_memory_rollback(m) != -1 )
+	{
+		printf("reset: the checkpoint survived\n");
+		failed++;
+	}
+
+	/* the pages are reused, they have to come back empty */
+	emu_memory_write_byte(m, 0x2000, 0x42);
+	emu_memory_read_dword(m, 0x2ffc, &dword);
+	if( dword != 0 )
+	{
+		printf("reset: reused page is not empty\n");
+		failed++;
+	}
+
+	printf("reset %s\n", failed == 0 ? "ok" : "failed");
+	return failed;
+}
+
+/* a reset keeps a few pages only, not everything a large run mapped */
+int test_reset_large(struct emu *e)
+{
+	int failed = 0;
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+	struct emu_memory *m = emu_memory_get(e);
+	size_t before, after;
+	uint32_t addr;
+
+	emu_reset(e);
+	before = mallinfo2().uordblks;
+
+	/* 8 MB */
+	for( addr = 0x100000; addr < 0x900000; addr += 0x1000 )
+		emu_memory_write_byte(m, addr, 0x42);
+
+	emu_reset(e);
+	after = mallinfo2().uordblks;
+
+	if( after > before + 1024 * 1024 )
+	{
+		printf("reset large: %zu kb kept\n", (after - before) / 1024);
+		failed++;
+	}
+
+	printf("reset large %s\n", failed == 0 ? "ok" : "failed");
+#endif
+
+	return failed;
+}
+
 int main(int argc, char **argv)
 {
 	struct emu *e;
+	int failed;
 	
 	e = emu_new();
 	
 	test_alloc(e);
+	failed = test_checkpoint(e);
+	failed += test_reset(e);
+	failed += test_reset_large(e);
 	
 	emu_free(e);
 	
-	return 0;
+	return failed != 0;
 }
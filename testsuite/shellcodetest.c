@@ -0,0 +1,521 @@
+/********************************************************************************
+ *                               libemu
+ *
+ *                    - x86 shellcode emulation -
+ *
+ *
+ * Copyright (C) 2007  Paul Baecher & Markus Koetter
+ * 
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ * 
+ * 
+ *             contact nepenthesdev@users.sourceforge.net  
+ *
+ *******************************************************************************/
+
+
+/*
+ * the shellcode test apis against emu_shellcode_test
+ *
+ * emu_shellcode_test_batch has to return for each buffer what
+ * emu_shellcode_test on a new emu returns, for the sctest shellcodes,
+ * empty buffers and random data, and what emu_shellcode_test_windowed
+ * returns for buffers larger than EMU_SHELLCODE_WINDOW.
+ * The memory it needs for a large buffer must not depend on the size of
+ * the buffer. Cancelled part way, it has to return the number of buffers
+ * tested and leave the results behind alone.
+ *
+ * emu_shellcode_test_windowed has to find what emu_shellcode_test finds
+ * in a buffer just over a window, with the shellcode across the end of
+ * the candidates of the first window or across the end of the window.
+ *
+ * emu_triage has to score text below EMU_TRIAGE_THRESHOLD and the sctest
+ * shellcodes emu_shellcode_test detects at or above it, and must not read
+ * behind short buffers.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/mman.h>
+
+#include "emu/emu.h"
+#include "emu/emu_shellcode.h"
+#include "emu/emu_triage.h"
+
+#include "../tools/sctest/tests.h"
+
+#define RANDOM_SIZE 0x600
+
+/* a buffer just over a window */
+#define WINDOWED_SIZE (EMU_SHELLCODE_WINDOW + 0x1000)
+
+/* the size of the large buffer and the most memory its test may take */
+#define LARGE_SIZE (8 * 1024 * 1024)
+#define LARGE_RSS_MAX (48 * 1024)
+
+struct buffers
+{
+	uint8_t **bufs;
+	uint32_t *lens;
+	int32_t *expected;
+	uint32_t n;
+};
+
+static uint32_t seed = 4711;
+
+static uint32_t lcg(void)
+{
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+static void buffers_add(struct buffers *b, const uint8_t *data, uint32_t len)
+{
+	b->bufs = realloc(b->bufs, (b->n + 1) * sizeof(uint8_t *));
+	b->lens = realloc(b->lens, (b->n + 1) * sizeof(uint32_t));
+	b->bufs[b->n] = malloc(len + 1);
+	if( data != NULL )
+		memcpy(b->bufs[b->n], data, len);
+	b->lens[b->n] = len;
+	b->n++;
+}
+
+/* random bytes, many of them the first bytes of GetPC patterns and
+ * short jumps, with the shellcode of test sc copied in if sc >= 0 */
+static void buffers_add_random(struct buffers *b, uint32_t len, int sc)
+{
+	static const uint8_t often[] = { 0xe8, 0xd9, 0x74, 0xeb, 0x31, 0xc9, 0x5e, 0x80, 0xe2, 0xfc };
+	uint8_t *data = malloc(len);
+	uint32_t i;
+
+	for( i = 0; i < len; i++ )
+		data[i] = lcg() % 10 < 3 ? often[lcg() % sizeof(often)] : lcg();
+
+	if( sc >= 0 && tests[sc].codesize < len )
+		memcpy(data + lcg() % (len - tests[sc].codesize), tests[sc].code, tests[sc].codesize);
+
+	buffers_add(b, data, len);
+	free(data);
+}
+
+/* larger than a window, mostly zeros, with random bytes at both ends and
+ * the shellcode of test sc in the second window */
+static void buffers_add_large(struct buffers *b, uint32_t len, int sc)
+{
+	static const uint8_t often[] = { 0xe8, 0xd9, 0x74, 0xeb, 0x31, 0xc9, 0x5e, 0x80, 0xe2, 0xfc };
+	uint8_t *data = calloc(1, len);
+	uint32_t i;
+
+	for( i = 0; i < RANDOM_SIZE; i++ )
+	{
+		data[i] = lcg() % 10 < 3 ? often[lcg() % sizeof(often)] : lcg();
+		data[len - RANDOM_SIZE + i] = lcg() % 10 < 3 ? often[lcg() % sizeof(often)] : lcg();
+	}
+
+	memcpy(data + EMU_SHELLCODE_WINDOW + 0x1234, tests[sc].code, tests[sc].codesize);
+
+	buffers_add(b, data, len);
+	free(data);
+}
+
+static void buffers_expect(struct buffers *b)
+{
+	uint32_t i;
+
+	b->expected = malloc(b->n * sizeof(int32_t));
+
+	for( i = 0; i < b->n; i++ )
+	{
+		struct emu *e = emu_new();
+		if( b->lens[i] > EMU_SHELLCODE_WINDOW )
+			b->expected[i] = emu_shellcode_test_windowed(e, b->bufs[i], b->lens[i], EMU_SHELLCODE_WINDOW, 1);
+		else
+			b->expected[i] = emu_shellcode_test(e, b->bufs[i], b->lens[i]);
+		if( b->expected[i] < 0 )
+			b->expected[i] = -1;
+		emu_free(e);
+	}
+}
+
+static void buffers_free(struct buffers *b)
+{
+	uint32_t i;
+
+	for( i = 0; i < b->n; i++ )
+		free(b->bufs[i]);
+
+	free(b->bufs);
+	free(b->lens);
+	free(b->expected);
+}
+
+static int test_batch(struct buffers *b)
+{
+	struct emu_shellcode_result *results = malloc(b->n * sizeof(struct emu_shellcode_result));
+	struct emu *e = emu_new();
+	int failed = 0;
+	uint32_t found = 0;
+	uint32_t i;
+
+	int32_t tested = emu_shellcode_test_batch(e, b->bufs, b->lens, b->n, results);
+
+	if( tested != b->n )
+	{
+		printf("batch: tested %i of %i buffers\n", tested, b->n);
+		failed++;
+	}
+
+	for( i = 0; i < tested; i++ )
+	{
+		if( results[i].offset != b->expected[i] )
+		{
+			printf("batch: buffer %i of %i bytes, offset %i instead of %i\n", i, b->lens[i], results[i].offset, b->expected[i]);
+			failed++;
+		}
+
+		if( results[i].offset >= 0 )
+			found++;
+	}
+
+	printf("batch: %i buffers, %i shellcodes found %s\n", b->n, found, failed == 0 ? "ok" : "failed");
+
+	emu_free(e);
+	free(results);
+	return failed;
+}
+
+static int test_windowed(void)
+{
+	static const uint8_t often[] = { 0xe8, 0xd9, 0x74, 0xeb, 0x31, 0xc9, 0x5e, 0x80, 0xe2, 0xfc };
+	static const uint32_t across[] = { EMU_SHELLCODE_WINDOW / 2, EMU_SHELLCODE_WINDOW };
+	uint8_t *data = malloc(WINDOWED_SIZE);
+	int failed = 0;
+	int compared = 0;
+	int i, j;
+	uint32_t at, k;
+
+	for( i = 0; i < numtests(); i++ )
+	{
+		for( j = 0; j < sizeof(across) / sizeof(across[0]); j++ )
+		{
+			/* random bytes in front, the first window starts there */
+			memset(data, 0, WINDOWED_SIZE);
+			for( k = 0; k < RANDOM_SIZE; k++ )
+				data[k] = lcg() % 10 < 3 ? often[lcg() % sizeof(often)] : lcg();
+			at = across[j] - tests[i].codesize / 2;
+			if( at + tests[i].codesize > WINDOWED_SIZE )
+				at = WINDOWED_SIZE - tests[i].codesize;
+			memcpy(data + at, tests[i].code, tests[i].codesize);
+
+			struct emu *e = emu_new();
+			int32_t whole = emu_shellcode_test(e, data, WINDOWED_SIZE);
+			emu_free(e);
+
+			e = emu_new();
+			int32_t windowed = emu_shellcode_test_windowed(e, data, WINDOWED_SIZE, EMU_SHELLCODE_WINDOW, 1);
+			emu_free(e);
+
+			e = emu_new();
+			int32_t threaded = emu_shellcode_test_windowed(e, data, WINDOWED_SIZE, EMU_SHELLCODE_WINDOW, 2);
+			emu_free(e);
+
+			if( whole < 0 )
+				whole = -1;
+			if( windowed < 0 )
+				windowed = -1;
+			if( threaded < 0 )
+				threaded = -1;
+
+			if( windowed != whole || threaded != whole )
+			{
+				printf("windowed: test %i across 0x%x, offset %i, %i with 2 threads, instead of %i\n", 
+					   i, across[j], windowed, threaded, whole);
+				failed++;
+			}
+
+			if( whole >= 0 )
+				compared++;
+		}
+	}
+
+	free(data);
+
+	printf("windowed: %i shellcodes found %s\n", compared, failed == 0 ? "ok" : "failed");
+
+	return failed;
+}
+
+static long maxrss(void)
+{
+	struct rusage ru;
+	getrusage(RUSAGE_SELF, &ru);
+	return ru.ru_maxrss;
+}
+
+static int test_batch_large(void)
+{
+	struct buffers b;
+	struct emu_shellcode_result result;
+	int failed = 0;
+
+	memset(&b, 0, sizeof(struct buffers));
+	buffers_add_large(&b, LARGE_SIZE, 1);
+
+	long before = maxrss();
+
+	struct emu *e = emu_new();
+	if( emu_shellcode_test_batch(e, b.bufs, b.lens, 1, &result) != 1 )
+		failed++;
+	emu_free(e);
+
+	long used = maxrss() - before;
+
+	buffers_expect(&b);
+	if( result.offset != b.expected[0] || result.offset < 0 )
+	{
+		printf("batch large: offset %i instead of %i\n", result.offset, b.expected[0]);
+		failed++;
+	}
+
+	if( used > LARGE_RSS_MAX )
+	{
+		printf("batch large: %li kb used for a buffer of %i kb\n", used, LARGE_SIZE / 1024);
+		failed++;
+	}
+
+	printf("batch large: %i kb, %li kb used %s\n", LARGE_SIZE / 1024, used, failed == 0 ? "ok" : "failed");
+
+	buffers_free(&b);
+	return failed;
+}
+
+struct cancel_arg
+{
+	struct emu *e;
+	uint32_t usec;
+};
+
+static void *cancel_thread(void *arg)
+{
+	struct cancel_arg *ca = arg;
+
+	usleep(ca->usec);
+	emu_cancel(ca->e);
+	return NULL;
+}
+
+static int test_batch_cancel(struct buffers *b)
+{
+	struct emu_shellcode_result *results = malloc(b->n * sizeof(struct emu_shellcode_result));
+	struct emu *e = emu_new();
+	struct cancel_arg ca = { e, 5000 };
+	pthread_t thread;
+	int failed = 0;
+	uint32_t i;
+
+	memset(results, 0xff, b->n * sizeof(struct emu_shellcode_result));
+
+	if( pthread_create(&thread, NULL, cancel_thread, &ca) != 0 )
+	{
+		printf("batch cancel: could not create a thread\n");
+		return 1;
+	}
+
+	int32_t tested = emu_shellcode_test_batch(e, b->bufs, b->lens, b->n, results);
+	pthread_join(thread, NULL);
+
+	if( tested >= b->n || emu_interrupted(e) != ECANCELED )
+	{
+		printf("batch cancel: tested %i of %i buffers, not cancelled\n", tested, b->n);
+		failed++;
+		tested = b->n;
+	}
+
+	for( i = 0; i < tested; i++ )
+	{
+		if( results[i].offset != b->expected[i] )
+		{
+			printf("batch cancel: buffer %i, offset %i instead of %i\n", i, results[i].offset, b->expected[i]);
+			failed++;
+		}
+	}
+
+	/* the one interrupted may be set, the ones behind are not */
+	for( i = tested + 1; i < b->n; i++ )
+	{
+		if( results[i].offset != -1 || results[i].candidates != 0xffffffff )
+		{
+			printf("batch cancel: buffer %i behind the %i tested got a result\n", i, tested);
+			failed++;
+			break;
+		}
+	}
+
+	printf("batch cancel: %i of %i buffers tested %s\n", tested, b->n, failed == 0 ? "ok" : "failed");
+
+	emu_free(e);
+	free(results);
+	return failed;
+}
+
+static const char text[] =
+	"This program is free software; you can redistribute it and/or\n"
+	"modify it under the terms of the GNU General Public License\n"
+	"as published by the Free Software Foundation; either version 2\n"
+	"of the License, or (at your option) any later version.\n"
+	"\n"
+	"This program is distributed in the hope that it will be useful,\n"
+	"but WITHOUT ANY WARRANTY; without even the implied warranty of\n"
+	"MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the\n"
+	"GNU General Public License for more details.\n";
+
+static int test_triage(void)
+{
+	struct emu_triage t;
+	struct emu *e;
+	int failed = 0;
+	uint32_t detected = 0;
+	int i;
+
+	if( emu_triage((uint8_t *)text, sizeof(text) - 1, &t) >= EMU_TRIAGE_THRESHOLD )
+	{
+		printf("triage: text scores %u\n", t.score);
+		failed++;
+	}
+
+	e = emu_new();
+	if( emu_shellcode_test_triaged(e, (uint8_t *)text, sizeof(text) - 1, EMU_TRIAGE_THRESHOLD, &t) != -1 )
+	{
+		printf("triage: text tested\n");
+		failed++;
+	}
+	emu_free(e);
+
+	for( i = 0; i < numtests(); i++ )
+	{
+		e = emu_new();
+		int32_t offset = emu_shellcode_test(e, (uint8_t *)tests[i].code, tests[i].codesize);
+		emu_free(e);
+
+		if( offset < 0 )
+			continue;
+
+		detected++;
+
+		if( emu_triage((uint8_t *)tests[i].code, tests[i].codesize, &t) < EMU_TRIAGE_THRESHOLD )
+		{
+			printf("triage: test %i scores %u\n", i, t.score);
+			failed++;
+		}
+
+		e = emu_new();
+		if( emu_shellcode_test_triaged(e, (uint8_t *)tests[i].code, tests[i].codesize, EMU_TRIAGE_THRESHOLD, &t) != offset )
+		{
+			printf("triage: test %i not found by emu_shellcode_test_triaged\n", i);
+			failed++;
+		}
+		emu_free(e);
+	}
+
+	/* short buffers at the end of a page, the next page is not mapped */
+	long page = sysconf(_SC_PAGESIZE);
+	uint8_t *pages = mmap(NULL, page * 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if( pages == MAP_FAILED || mprotect(pages + page, page, PROT_NONE) != 0 )
+	{
+		printf("triage: could not map the pages\n");
+		return failed + 1;
+	}
+
+	for( i = 1; i < 4; i++ )
+	{
+		uint8_t *data = pages + page - i;
+
+		memset(data, 0x90, i);
+		data[i - 1] = 0xd9;
+
+		if( emu_triage(data, i, &t) >= EMU_TRIAGE_THRESHOLD || t.getpc != 0 || emu_triage_getpc(data, i) != 0 )
+		{
+			printf("triage: %i bytes ending in 0xd9 score %u\n", i, t.score);
+			failed++;
+		}
+
+		e = emu_new();
+		if( emu_shellcode_test_triaged(e, data, i, EMU_TRIAGE_THRESHOLD, NULL) != -1 )
+		{
+			printf("triage: %i bytes ending in 0xd9 detected\n", i);
+			failed++;
+		}
+		emu_free(e);
+	}
+
+	munmap(pages, page * 2);
+
+	printf("triage: %u shellcodes detected %s\n", detected, failed == 0 ? "ok" : "failed");
+
+	return failed;
+}
+
+int main(void)
+{
+	struct buffers b;
+	int failed = 0;
+	int i, j;
+
+	failed += test_windowed();
+	failed += test_batch_large();
+	failed += test_triage();
+
+	memset(&b, 0, sizeof(struct buffers));
+
+	for( i = 0; i < numtests(); i++ )
+	{
+		buffers_add(&b, (uint8_t *)tests[i].code, tests[i].codesize);
+		buffers_add(&b, NULL, 0);
+		buffers_add_random(&b, RANDOM_SIZE, i);
+		buffers_add_random(&b, RANDOM_SIZE, -1);
+	}
+
+	buffers_add_large(&b, EMU_SHELLCODE_WINDOW * 3 / 2, 1);
+
+	buffers_expect(&b);
+	failed += test_batch(&b);
+
+	/* long enough to be cancelled part way */
+	struct buffers many = b;
+	many.n = b.n * 32;
+	many.bufs = malloc(many.n * sizeof(uint8_t *));
+	many.lens = malloc(many.n * sizeof(uint32_t));
+	many.expected = malloc(many.n * sizeof(int32_t));
+	for( j = 0; j < 32; j++ )
+	{
+		memcpy(many.bufs + j * b.n, b.bufs, b.n * sizeof(uint8_t *));
+		memcpy(many.lens + j * b.n, b.lens, b.n * sizeof(uint32_t));
+		memcpy(many.expected + j * b.n, b.expected, b.n * sizeof(int32_t));
+	}
+	failed += test_batch_cancel(&many);
+	free(many.bufs);
+	free(many.lens);
+	free(many.expected);
+
+	buffers_free(&b);
+
+	return failed != 0;
+}
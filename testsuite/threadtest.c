@@ -0,0 +1,329 @@
+/********************************************************************************
+ *                               libemu
+ *
+ *                    - x86 shellcode emulation -
+ *
+ *
+ * Copyright (C) 2007  Paul Baecher & Markus Koetter
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *
+ *             contact nepenthesdev@users.sourceforge.net
+ *
+ *******************************************************************************/
+
+/*
+ * one emu per thread
+ *
+ * runs the same shellcode detection and emulation in N threads, each with
+ * its own emu, and checks every thread gets exactly the result a single
+ * thread got. the throughput of 1 and N threads is printed for comparison.
+ *
+ * the threads take their emus from a shared emu_pool, so the emus are
+ * reset and reused, the single threaded reference run uses new emus.
+ *
+ * emu_shellcode_test_threads with N threads has to return what
+ * emu_shellcode_test returns, for buffers with many GetPC candidates.
+ *
+ * usage: threadtest [threads] [iterations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "emu/emu.h"
+#include "emu/emu_memory.h"
+#include "emu/emu_pool.h"
+#include "emu/emu_cpu.h"
+#include "emu/emu_cpu_data.h"
+#include "emu/emu_shellcode.h"
+#include "emu/environment/emu_env.h"
+#include "emu/environment/win32/emu_env_w32.h"
+#include "emu/environment/win32/emu_env_w32_dll_export.h"
+
+#define CODE_OFFSET 0x417000
+#define STEPS 1000000
+
+/* win32_bind -  EXITFUNC=seh LPORT=4444 Size=344 Encoder=Pex http://metasploit.com */
+static const uint8_t scode[] =
+	"\x33\xc9\x83\xe9\xb0\xe8\xff\xff\xff\xff\xc0\x5e\x81\x76\x0e\x47"
+	"\x13\x2b\xc0\x83\xee\xfc\xe2\xf4\xbb\x79\xc0\x8d\xaf\xea\xd4\x3f"
+	"\xb8\x73\xa0\xac\x63\x37\xa0\x85\x7b\x98\x57\xc5\x3f\x12\xc4\x4b"
+	"\x08\x0b\xa0\x9f\x67\x12\xc0\x89\xcc\x27\xa0\xc1\xa9\x22\xeb\x59"
+	"\xeb\x97\xeb\xb4\x40\xd2\xe1\xcd\x46\xd1\xc0\x34\x7c\x47\x0f\xe8"
+	"\x32\xf6\xa0\x9f\x63\x12\xc0\xa6\xcc\x1f\x60\x4b\x18\x0f\x2a\x2b"
+	"\x44\x3f\xa0\x49\x2b\x37\x37\xa1\x84\x22\xf0\xa4\xcc\x50\x1b\x4b"
+	"\x07\x1f\xa0\xb0\x5b\xbe\xa0\x80\x4f\x4d\x43\x4e\x09\x1d\xc7\x90"
+	"\xb8\xc5\x4d\x93\x21\x7b\x18\xf2\x2f\x64\x58\xf2\x18\x47\xd4\x10"
+	"\x2f\xd8\xc6\x3c\x7c\x43\xd4\x16\x18\x9a\xce\xa6\xc6\xfe\x23\xc2"
+	"\x12\x79\x29\x3f\x97\x7b\xf2\xc9\xb2\xbe\x7c\x3f\x91\x40\x78\x93"
+	"\x14\x40\x68\x93\x04\x40\xd4\x10\x21\x7b\x3a\x9c\x21\x40\xa2\x21"
+	"\xd2\x7b\x8f\xda\x37\xd4\x7c\x3f\x91\x79\x3b\x91\x12\xec\xfb\xa8"
+	"\xe3\xbe\x05\x29\x10\xec\xfd\x93\x12\xec\xfb\xa8\xa2\x5a\xad\x89"
+	"\x10\xec\xfd\x90\x13\x47\x7e\x3f\x97\x80\x43\x27\x3e\xd5\x52\x97"
+	"\xb8\xc5\x7e\x3f\x97\x75\x41\xa4\x21\x7b\x48\xad\xce\xf6\x41\x90"
+	"\x1e\x3a\xe7\x49\xa0\x79\x6f\x49\xa5\x22\xeb\x33\xed\xed\x69\xed"
+	"\xb9\x51\x07\x53\xca\x69\x13\x6b\xec\xb8\x43\xb2\xb9\xa0\x3d\x3f"
+	"\x32\x57\xd4\x16\x1c\x44\x79\x91\x16\x42\x41\xc1\x16\x42\x7e\x91"
+	"\xb8\xc3\x43\x6d\x9e\x16\xe5\x93\xb8\xc5\x41\x3f\xb8\x24\xd4\x10"
+	"\xcc\x44\xd7\x43\x83\x77\xd4\x16\x15\xec\xfb\xa8\xb7\x99\x2f\x9f"
+	"\x14\xec\xfd\x3f\x97\x13\x2b\xc0";
+
+struct run_result
+{
+	int32_t offset;
+	uint32_t steps;
+	uint32_t eip;
+	uint32_t reg[8];
+	uint32_t hash;
+};
+
+struct worker
+{
+	pthread_t thread;
+	int iterations;
+	struct run_result result;
+	int failed;
+};
+
+static struct run_result reference;
+static struct emu_pool *pool;
+
+/* new emus without a pool */
+static struct emu *take(struct emu_pool *p)
+{
+	return p != NULL ? emu_pool_get(p) : emu_new();
+}
+
+static void give_back(struct emu_pool *p, struct emu *e)
+{
+	if( p != NULL )
+		emu_pool_put(p, e);
+	else
+		emu_free(e);
+}
+
+static void run(struct run_result *r, struct emu_pool *p)
+{
+	struct emu *e;
+	struct emu_cpu *cpu;
+	struct emu_env *env;
+	uint32_t j;
+
+	memset(r, 0, sizeof(struct run_result));
+
+	e = take(p);
+	r->offset = emu_shellcode_test(e, (uint8_t *)scode, sizeof(scode) - 1);
+	give_back(p, e);
+
+	e = take(p);
+	cpu = emu_cpu_get(e);
+	env = emu_env_new(e);
+
+	static const uint32_t in[8] = {0,0xfffffe6c,0,0,0x12fe98,0x12ff74,0x12fe9c,0x12ff74};
+	for( j = 0; j < 8; j++ )
+		emu_cpu_reg32_set(cpu, j, in[j]);
+
+	emu_memory_write_block(emu_memory_get(e), CODE_OFFSET, (void *)scode, sizeof(scode) - 1);
+	emu_cpu_eip_set(cpu, CODE_OFFSET + (r->offset >= 0 ? r->offset : 0));
+
+	/* fnv-1a over the addresses of the api calls */
+	r->hash = 2166136261U;
+
+	for( j = 0; j < STEPS; j++ )
+	{
+		struct emu_env_hook *hook = emu_env_w32_eip_check(env);
+
+		if( hook != NULL )
+		{
+			if( hook->hook.win->fnhook == NULL )
+				break;
+
+			r->hash = (r->hash ^ emu_cpu_eip_get(cpu)) * 16777619U;
+			continue;
+		}
+
+		if( emu_cpu_parse(cpu) == -1 || emu_cpu_step(cpu) == -1 )
+			break;
+	}
+
+	r->steps = j;
+	r->eip = emu_cpu_eip_get(cpu);
+	for( j = 0; j < 8; j++ )
+		r->reg[j] = emu_cpu_reg32_get(cpu, j);
+
+	emu_env_free(env);
+	give_back(p, e);
+}
+
+static void *worker_main(void *arg)
+{
+	struct worker *w = arg;
+	int i;
+
+	for( i = 0; i < w->iterations; i++ )
+	{
+		run(&w->result, pool);
+		if( memcmp(&w->result, &reference, sizeof(struct run_result)) != 0 )
+			w->failed++;
+	}
+
+	return NULL;
+}
+
+/**
+ * compare emu_shellcode_test_threads to emu_shellcode_test on buffers of
+ * random bytes, with many call/fnstenv/jmp bytes, some with the
+ * shellcode in it
+ *
+ * @return the number of buffers which differ
+ */
+static int compare_threads(int nthreads)
+{
+	static uint8_t buf[0x4000];
+	static const uint8_t often[] = { 0xe8, 0xd9, 0x74, 0xeb, 0x31, 0xc9, 0x5e, 0x80, 0xe2, 0xfc };
+	uint32_t seed = 4711;
+	int failed = 0;
+	int i;
+
+	for( i = 0; i < 24; i++ )
+	{
+		uint32_t size = 0x400 + (i * 0x1f3) % (sizeof(buf) - 0x400);
+		uint32_t j;
+
+		for( j = 0; j < size; j++ )
+		{
+			seed = seed * 1103515245 + 12345;
+			buf[j] = (seed >> 16) % 10 < 3 ? often[(seed >> 8) % sizeof(often)] : seed >> 24;
+		}
+
+		if( i % 3 != 0 )
+			memcpy(buf + (seed >> 8) % (size - sizeof(scode)), scode, sizeof(scode) - 1);
+
+		struct emu *e = emu_new();
+		int32_t single = emu_shellcode_test(e, buf, size);
+		emu_free(e);
+
+		e = emu_new();
+		int32_t multi = emu_shellcode_test_threads(e, buf, size, nthreads);
+		emu_free(e);
+
+		if( single != multi )
+		{
+			printf("buffer %i: %i threads found %i, one thread %i\n", i, nthreads, multi, single);
+			failed++;
+		}
+	}
+
+	return failed;
+}
+
+static double now(void)
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/**
+ * run iterations emulations in each of nthreads threads
+ *
+ * @return the number of emulations per second, -1 if a thread failed
+ */
+static double bench(int nthreads, int iterations)
+{
+	struct worker *workers = malloc(nthreads * sizeof(struct worker));
+	double start = now();
+	int failed = 0;
+	int i;
+
+	memset(workers, 0, nthreads * sizeof(struct worker));
+
+	for( i = 0; i < nthreads; i++ )
+	{
+		workers[i].iterations = iterations;
+		if( pthread_create(&workers[i].thread, NULL, worker_main, &workers[i]) != 0 )
+		{
+			printf("could not create thread %i\n", i);
+			exit(1);
+		}
+	}
+
+	for( i = 0; i < nthreads; i++ )
+	{
+		pthread_join(workers[i].thread, NULL);
+		if( workers[i].failed != 0 )
+		{
+			printf("thread %i: %i of %i results differ from the single threaded run\n", i, workers[i].failed, iterations);
+			failed++;
+		}
+	}
+
+	double elapsed = now() - start;
+	free(workers);
+
+	if( failed != 0 )
+		return -1;
+
+	return (nthreads * iterations) / elapsed;
+}
+
+int main(int argc, char *argv[])
+{
+	int nthreads = sysconf(_SC_NPROCESSORS_ONLN);
+	int iterations = 20;
+
+	if( argc > 1 )
+		nthreads = atoi(argv[1]);
+
+	if( argc > 2 )
+		iterations = atoi(argv[2]);
+
+	if( nthreads < 1 )
+		nthreads = 1;
+
+	run(&reference, NULL);
+	printf("offset %i, %i steps, eip 0x%08x, api hash 0x%08x\n", reference.offset, reference.steps, reference.eip, reference.hash);
+
+	if( reference.offset < 0 || reference.hash == 2166136261U )
+	{
+		printf("reference run failed\n");
+		return 1;
+	}
+
+	if( compare_threads(nthreads) != 0 )
+		return 1;
+
+	pool = emu_pool_new(nthreads);
+
+	double single = bench(1, iterations);
+	double multi = bench(nthreads, iterations);
+
+	emu_pool_free(pool);
+
+	if( single < 0 || multi < 0 )
+		return 1;
+
+	printf(" 1 thread : %8.1f runs/s\n", single);
+	printf("%2i threads: %8.1f runs/s (%.2fx)\n", nthreads, multi, multi / single);
+
+	return 0;
+}
@@ -96,6 +96,7 @@ struct instr_vertex *instr_vertex_copy(struct instr_vertex *from)
 	iv->instr_string = emu_string_new();
 	iv->dll = from->dll;
 	iv->syscall = from->syscall;
+	iv->hook = from->hook;
 
 	emu_string_append_char(iv->instr_string, from->instr_string->data);
 	return iv;
@@ -150,13 +151,13 @@ int graph_draw(struct emu_graph *graph)
 
 		// find the first in a chain
 		iv = (struct instr_vertex *)ev->data;
-		while ( emu_edges_length(ev->backedges) == 1 && emu_edges_length(ev->edges) <= 1 && ev->color == white && iv->dll == NULL && iv->syscall == NULL )
+		while ( emu_edges_length(ev->backedges) == 1 && emu_edges_length(ev->edges) <= 1 && ev->color == white && iv->dll == NULL && iv->syscall == NULL && iv->hook == false )
 		{
 			ev->color = grey;
 
 			struct emu_vertex *xev = emu_edges_first(ev->backedges)->destination;
 			iv = (struct instr_vertex *)xev->data;
-			if ( emu_edges_length(xev->backedges) > 1 || emu_edges_length(xev->edges) > 1 || iv->dll != NULL || iv->syscall != NULL )
+			if ( emu_edges_length(xev->backedges) > 1 || emu_edges_length(xev->edges) > 1 || iv->dll != NULL || iv->syscall != NULL || iv->hook == true )
 				break;
 
 			ev = xev;
@@ -173,14 +174,14 @@ int graph_draw(struct emu_graph *graph)
 		iv = (struct instr_vertex *)ev->data;
 
 		printf("going forwards from %p\n", (void *)ev);
-		while ( emu_edges_length(ev->edges) == 1 && emu_edges_length(ev->backedges) <= 1 && ev->color != black && iv->dll == NULL && iv->syscall == NULL )
+		while ( emu_edges_length(ev->edges) == 1 && emu_edges_length(ev->backedges) <= 1 && ev->color != black && iv->dll == NULL && iv->syscall == NULL && iv->hook == false )
 		{
 			ev->color = black;
 			struct emu_vertex *xev = emu_edges_first(ev->edges)->destination;
 			iv = (struct instr_vertex *)xev->data;
 
 			if ( emu_edges_length(xev->backedges) > 1 || emu_edges_length(xev->edges) > 1 ||
-				 iv->dll != NULL || iv->syscall != NULL )
+				 iv->dll != NULL || iv->syscall != NULL || iv->hook == true )
 				break;
 
 			ev = xev;
@@ -252,7 +253,7 @@ int graph_draw(struct emu_graph *graph)
 		if ( iv->dll != NULL )
 			continue;
 #endif // 0
-		if ( iv->dll != NULL || iv->syscall != NULL )
+		if ( iv->dll != NULL || iv->syscall != NULL || iv->hook == true )
 			fprintf(f, "\t \"%p\" [shape=box, style=filled, color=\".7 .3 1.0\", label = \"%s\"]\n",(void *)iv, emu_string_char(iv->instr_string));
 		else
 			fprintf(f, "\t \"%p\" [shape=box, label = \"%s\"]\n",(void *)iv, emu_string_char(iv->instr_string));
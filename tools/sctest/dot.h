@@ -4,6 +4,7 @@ struct instr_vertex
 	struct emu_string  *instr_string;
 	struct emu_env_w32_dll *dll;
 	struct emu_env_linux_syscall *syscall;
+	bool hook;	/* an api call replayed from a trace, no dll or syscall known */
 };
 
 
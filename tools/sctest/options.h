@@ -13,6 +13,15 @@ struct run_time_options
 	int offset;
 	char *profile_file;
 	bool interactive;
+	bool fastforward;
+	bool livelock;
+	int blockcache;
+	int opcodestats;
+	bool coverage;
+	char *tracefile;
+	char *replayfile;
+	uint32_t deadline;
+	uint32_t threads;
 
 	struct 
 	{
@@ -64,6 +64,7 @@
 #include <sys/select.h>
 
 #include <sys/wait.h>
+#include <signal.h>
 
 
 #include "emu/emu.h"
@@ -81,6 +82,8 @@
 #include "emu/environment/linux/emu_env_linux.h"
 #include "emu/emu_getpc.h"
 #include "emu/emu_graph.h"
+#include "emu/emu_coverage.h"
+#include "emu/emu_trace.h"
 #include "emu/emu_string.h"
 #include "emu/emu_hashtable.h"
 
@@ -104,6 +107,20 @@
 
 struct run_time_options opts;
 
+/* the emu running the getpc test or the shellcode, ^C cancels it */
+static struct emu * volatile running;
+
+static void sigint_cancel(int sig)
+{
+	if ( running != NULL )
+		emu_cancel(running);
+	else
+	{
+		signal(sig, SIG_DFL);
+		raise(sig);
+	}
+}
+
 /*
 static const char *regm[] = {
 	"eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi"
@@ -125,6 +142,78 @@ static const char *flags[] = { "CF", "  ", "PF", "  " , "AF"  , "    ", "ZF", "S
 
 int graph_draw(struct emu_graph *graph);
 
+struct opcode_count
+{
+	uint16_t opcode;	/* 0x0fxx for the twobyte opcodes */
+	uint64_t count;
+	uint64_t cycles;
+	uint64_t samples;
+};
+
+static int opcode_count_cmp(const void *a, const void *b)
+{
+	const struct opcode_count *x = a, *y = b;
+
+	if ( x->count != y->count )
+		return x->count < y->count ? 1 : -1;
+
+	return x->opcode - y->opcode;
+}
+
+void print_opcode_stats(struct emu_cpu *cpu)
+{
+	const struct emu_cpu_stats *s = emu_cpu_stats_get(cpu);
+	struct opcode_count counts[0x200];
+	int i, n = 0;
+
+	if ( s == NULL )
+		return;
+
+	for ( i=0;i<0x100;i++ )
+	{
+		if ( s->onebyte[i] != 0 )
+		{
+			counts[n].opcode = i;
+			counts[n].count = s->onebyte[i];
+			counts[n].cycles = s->onebyte_cycles[i];
+			counts[n].samples = s->onebyte_samples[i];
+			n++;
+		}
+
+		if ( s->twobyte[i] != 0 )
+		{
+			counts[n].opcode = 0x0f00 | i;
+			counts[n].count = s->twobyte[i];
+			counts[n].cycles = s->twobyte_cycles[i];
+			counts[n].samples = s->twobyte_samples[i];
+			n++;
+		}
+	}
+
+	qsort(counts, n, sizeof(struct opcode_count), opcode_count_cmp);
+
+	printf("opcode stats: %llu steps, %llu faults, %llu hook calls\n",
+		   (unsigned long long)s->steps, (unsigned long long)s->faults, (unsigned long long)s->hooks);
+
+	for ( i=0;i<n;i++ )
+	{
+		const char *name = emu_cpu_opcode_name(counts[i].opcode);
+
+		if ( counts[i].opcode > 0xff )
+			printf("  %04x", counts[i].opcode);
+		else
+			printf("    %02x", counts[i].opcode);
+
+		printf(" %-8s %12llu %6.2f%%", name != NULL ? name : "-",
+			   (unsigned long long)counts[i].count, 100.0 * counts[i].count / s->steps);
+
+		if ( counts[i].samples != 0 )
+			printf(" %10.1f cycles", (double)counts[i].cycles / counts[i].samples);
+
+		printf("\n");
+	}
+}
+
 int test(struct emu *e)
 {
 //	int i=0;
@@ -216,6 +305,38 @@ int test(struct emu *e)
 	if( opts.verbose != 0 )
 		emu_cpu_debugflag_set(cpu, instruction_string);
 
+	if( opts.fastforward == true )
+		emu_cpu_option_set(cpu, loop_fastforward);
+
+	if( opts.livelock == true )
+		emu_cpu_option_set(cpu, livelock_detect);
+
+	if( opts.blockcache > 0 )
+		emu_cpu_option_set(cpu, block_cache);
+
+	if( opts.blockcache > 1 )
+		emu_cpu_option_set(cpu, block_cache_verify);
+
+	if( opts.opcodestats > 0 )
+		emu_cpu_option_set(cpu, opcode_stats);
+
+	if( opts.opcodestats > 1 )
+		emu_cpu_option_set(cpu, opcode_stats_cycles);
+
+	struct emu_coverage *coverage = NULL;
+	if( opts.coverage == true && (coverage = emu_coverage_new(CODE_OFFSET, opts.size)) != NULL )
+		emu_cpu_coverage_set(cpu, coverage);
+
+	FILE *tracefile = NULL;
+	struct emu_trace *trace = NULL;
+	if ( opts.tracefile != NULL )
+	{
+		if ( (tracefile = fopen(opts.tracefile, "wb")) == NULL || (trace = emu_trace_new(tracefile)) == NULL )
+			printf("could not write trace %s\n", opts.tracefile);
+		else
+			emu_cpu_trace_set(cpu, trace);
+	}
+
 	if ( opts.verbose >= 2 )
 	{
 		emu_log_level_set(emu_logging_get(e),EMU_LOG_DEBUG);
@@ -240,6 +361,9 @@ int test(struct emu *e)
 
 
 
+	running = e;
+	emu_deadline_set(e, opts.deadline);
+
 	uint32_t eipsave = 0;
 	for ( j=0;j<opts.steps;j++ )
 	{
@@ -326,7 +450,7 @@ int test(struct emu *e)
 			if ( opts.verbose > 1 )
 			{
 				emu_log_level_set(emu_logging_get(e),EMU_LOG_DEBUG);
-				logDebug(e, "%s\n", cpu->instr_string);
+				logDebug(e, "%s\n", emu_cpu_instruction_string(cpu));
 				emu_log_level_set(emu_logging_get(e),EMU_LOG_NONE);
 			}
 
@@ -348,7 +472,7 @@ int test(struct emu *e)
 
 					if ( opts.graphfile != NULL && ev->data == NULL )
 					{
-						iv = instr_vertex_new(eipsave, emu_cpu_get(e)->instr_string);
+						iv = instr_vertex_new(eipsave, emu_cpu_instruction_string(emu_cpu_get(e)));
 						emu_vertex_data_set(ev, iv);
 					}
 				}
@@ -394,6 +518,12 @@ int test(struct emu *e)
 
 			if ( ret == -1 )
 			{
+				if ( emu_interrupted(e) != 0 )
+					break;
+
+				if ( emu_errno(e) == ELOOP )
+					break;
+
 				/* step failed - maybe SEH */
 				if( emu_env_w32_step_failed(env) != 0 )
 				{
@@ -421,6 +551,34 @@ int test(struct emu *e)
 
 	printf("stepcount %i\n",j);
 
+	if ( emu_interrupted(e) != 0 )
+		printf("interrupted, %s", emu_strerror(e));
+	else
+	if ( emu_errno(e) == ELOOP )
+		printf("livelock, %s", emu_strerror(e));
+
+	running = NULL;
+
+	if ( opts.opcodestats > 0 )
+		print_opcode_stats(cpu);
+
+	if ( coverage != NULL )
+	{
+		printf("coverage: %i of %i bytes are instruction starts, %i edges, %i instructions outside\n",
+			   emu_coverage_count(coverage), opts.size, emu_coverage_edge_count(coverage), coverage->outside);
+		emu_cpu_coverage_set(cpu, NULL);
+		emu_coverage_free(coverage);
+	}
+
+	if ( trace != NULL )
+	{
+		emu_cpu_trace_set(cpu, NULL);
+		emu_trace_free(trace);
+	}
+
+	if ( tracefile != NULL )
+		fclose(tracefile);
+
 
 	if ( opts.graphfile != NULL )
 	{
@@ -455,6 +613,119 @@ int test(struct emu *e)
 
 
 
+/**
+ * the post processing of a run, from a trace written with -T
+ */
+int replay(void)
+{
+	struct emu_trace_reader *r = emu_trace_reader_open(opts.replayfile);
+	struct emu_trace_record rec;
+	char instr_string[EMU_TRACE_STRING_SIZE];
+	int steps = 0, hooks = 0;
+	int ret;
+
+	if ( r == NULL )
+	{
+		printf("could not read trace %s\n", opts.replayfile);
+		return 1;
+	}
+
+	struct emu_vertex *last_vertex = NULL;
+	struct emu_graph *graph = NULL;
+	struct emu_hashtable *eh = NULL;
+
+	if ( opts.graphfile != NULL )
+	{
+		graph = emu_graph_new();
+		eh = emu_hashtable_new(2047, emu_hashtable_ptr_hash, emu_hashtable_ptr_cmp);
+	}
+
+	while ( (ret = emu_trace_reader_next(r, &rec)) == 1 )
+	{
+		if ( rec.type == EMU_TRACE_STATE )
+			continue;
+
+		if ( rec.type == EMU_TRACE_STEP )
+			steps++;
+
+		if ( rec.type == EMU_TRACE_HOOK )
+		{
+			printf("0x%08x %s = 0x%08x\n", rec.eip, rec.name, rec.reg[eax]);
+			hooks++;
+		}
+
+		if ( opts.verbose > 1 && rec.type == EMU_TRACE_STEP )
+		{
+			emu_trace_record_string(&rec, instr_string);
+			printf("%s\n", instr_string);
+		}
+
+		if ( graph == NULL )
+			continue;
+
+		struct emu_vertex *ev = NULL;
+		struct emu_hashtable_item *ehi = emu_hashtable_search(eh, (void *)(uintptr_t)rec.eip);
+		if ( ehi != NULL )
+			ev = (struct emu_vertex *)ehi->value;
+
+		if ( ev == NULL )
+		{
+			ev = emu_vertex_new();
+			emu_graph_vertex_add(graph, ev);
+			emu_hashtable_insert(eh, (void *)(uintptr_t)rec.eip, ev);
+		}
+
+		if ( ev->data == NULL )
+		{
+			struct instr_vertex *iv;
+
+			if ( rec.type == EMU_TRACE_HOOK )
+			{
+				iv = instr_vertex_new(rec.eip, rec.name);
+				iv->hook = true;
+			}
+			else
+			if ( rec.type == EMU_TRACE_FAULT )
+				iv = instr_vertex_new(rec.eip, "ERROR");
+			else
+			{
+				emu_trace_record_string(&rec, instr_string);
+				iv = instr_vertex_new(rec.eip, instr_string);
+			}
+
+			emu_vertex_data_set(ev, iv);
+		}
+
+		if ( last_vertex != NULL )
+			emu_vertex_edge_add(last_vertex, ev);
+
+		last_vertex = ev;
+	}
+
+	if ( ret == -1 )
+		printf("trace %s is broken\n", opts.replayfile);
+
+	printf("stepcount %i, %i hooks\n", steps, hooks);
+
+	if ( opts.verbose >= 1 )
+	{
+		printf("eax 0x%08x ecx 0x%08x edx 0x%08x ebx 0x%08x\n", rec.reg[eax], rec.reg[ecx], rec.reg[edx], rec.reg[ebx]);
+		printf("esp 0x%08x ebp 0x%08x esi 0x%08x edi 0x%08x\n", rec.reg[esp], rec.reg[ebp], rec.reg[esi], rec.reg[edi]);
+		printf("eip 0x%08x eflags 0x%08x\n", rec.next_eip, rec.eflags);
+	}
+
+	if ( graph != NULL )
+	{
+		graph_draw(graph);
+		emu_hashtable_free(eh);
+		emu_graph_free(graph);
+	}
+
+	emu_trace_reader_free(r);
+	free(opts.replayfile);
+	return ret == -1;
+}
+
 int getpctest(void)
 {
 	struct emu *e = emu_new();
@@ -465,11 +736,22 @@ int getpctest(void)
 		emu_log_level_set(emu_logging_get(e),EMU_LOG_DEBUG);
 	}
 
-	if ( (opts.offset = emu_shellcode_test(e, (uint8_t *)opts.scode, opts.size)) >= 0 )
+	if ( opts.livelock == true )
+		emu_cpu_option_set(emu_cpu_get(e), livelock_detect);
+
+	running = e;
+	emu_deadline_set(e, opts.deadline);
+
+	if ( (opts.offset = emu_shellcode_test_threads(e, (uint8_t *)opts.scode, opts.size, opts.threads)) >= 0 )
 		printf("%s offset = 0x%08x\n",SUCCESS, opts.offset);
 	else
 		printf(FAILED"\n");
 
+	if ( emu_interrupted(e) != 0 )
+		printf("interrupted, %s", emu_strerror(e));
+
+	running = NULL;
+
 	emu_free(e);
 
 	return 0;
@@ -761,19 +1043,28 @@ void print_help(void)
 	{
 		{"a", "argos-csi"   , "PATH"    , "use this argos csi files as input"},
 		{"b", "bind"        , "IP:PORT" , "bind this ip:port"},
+		{"B", "blockcache"  , NULL      , "cache decoded hot blocks, -BB to verify the cache against the decoder"},
 		{"c", "connect"     , "IP:PORT" , "redirect connects to this ip:port"},
 		{"C", "cmd"         , "CMD"     , "command to execute for \"cmd\" in shellcode (default: cmd=\"/bin/sh -c \\\"cd ~/.wine/drive_c/; wine 'c:\\windows\\system32\\cmd_orig.exe' \\\"\")"},
 		{"d", "dump"        , "INTEGER" , "dump the shellcode (binary) to stdout"},
+		{"D", "deadline"    , "MSEC"    , "stop the getpc test and the run after MSEC milliseconds each"},
+		{"e", "coverage"    , NULL      , "count the instruction starts and control transfers in the shellcode"},
+		{"f", "fastforward" , NULL      , "fast forward xor/add/sub decoder loops"},
 		{"g", "getpc"       , NULL      , "run getpc mode, try to detect a shellcode"},
 		{"G", "graph"       , "FILEPATH", "save a dot formatted callgraph in filepath"},
 		{"h", "help"        , NULL      , "show this help"},
 		{"i", "interactive" , NULL      , "proxy api calls to the host operating system"},
+		{"j", "threads"     , "INTEGER" , "test the getpc candidates using this many threads"},
 		{"l", "listtests"   , NULL      , "list all tests"},
+		{"L", "livelock"    , NULL      , "stop loops which make no progress, like jmp $"},
 		{"o", "offset"      , "[INT|HEX]", "manual offset for shellcode, accepts int and hexvalues"},
+		{"O", "opcode-stats", NULL      , "count the steps per opcode, -OO to sample the cycles spent too"},
 		{"p", "profile"     , "PATH"    , "write shellcode profile to this file"},
+		{"R", "replay"      , "PATH"    , "read a trace written by -T instead of emulating, works with -G"},
 		{"S", "stdin"       , NULL      , "read shellcode/buffer from stdin, works with -g"},
 		{"s", "steps"       , "INTEGER" , "max number of steps to run"},
 		{"t", "testnumber"  , "INTEGER" , "the test to run"},
+		{"T", "trace"       , "PATH"    , "write an execution trace to this file"},
 		{"v", "verbose"     , NULL              , "be verbose, can be used multiple times, f.e. -vv"},
 	};
 
@@ -812,24 +1103,33 @@ int main(int argc, char *argv[])
 		static struct option long_options[] = {
 			{"argos-csi"        , 1, 0, 'a'},
 			{"bind"             , 1, 0, 'b'},
+			{"blockcache"       , 0, 0, 'B'},
 			{"connect"          , 1, 0, 'c'},
 			{"cmd"              , 1, 0, 'C'},
+			{"coverage"         , 0, 0, 'e'},
 			{"dump"             , 1, 0, 'd'},
+			{"deadline"         , 1, 0, 'D'},
+			{"fastforward"      , 0, 0, 'f'},
 			{"getpc"            , 0, 0, 'g'},
 			{"graph"            , 1, 0, 'G'},
 			{"help"             , 0, 0, 'h'},
 			{"interactive"      , 0, 0, 'i'},
+			{"threads"          , 1, 0, 'j'},
 			{"listtests"        , 0, 0, 'l'},
+			{"livelock"         , 0, 0, 'L'},
 			{"offset"           , 1, 0, 'o'},
+			{"opcode-stats"     , 0, 0, 'O'},
 			{"profile"          , 1, 0, 'p'},
+			{"replay"           , 1, 0, 'R'},
 			{"steps"            , 1, 0, 's'},
 			{"stdin"            , 0, 0, 'S'},
 			{"testnumber"       , 1, 0, 't'},
+			{"trace"            , 1, 0, 'T'},
 			{"verbose"          , 0, 0, 'v'},
 			{0, 0, 0, 0}
 		};
 
-		c = getopt_long (argc, argv, "a:b:c:C:d:gG:hilo:p:s:St:v", long_options, &option_index);
+		c = getopt_long (argc, argv, "a:b:Bc:C:d:D:efgG:hij:lLo:Op:R:s:St:T:v", long_options, &option_index);
 		if ( c == -1 )
 			break;
 
@@ -862,6 +1162,10 @@ int main(int argc, char *argv[])
 			}
 			break;
 
+		case 'B':
+			opts.blockcache++;
+			break;
+
 		case 'c':
 			{
 				opts.override.connect.host = strdup(optarg);
@@ -901,6 +1205,18 @@ int main(int argc, char *argv[])
 			return 0;
 			break;
 
+		case 'D':
+			opts.deadline = atoi(optarg);
+			break;
+
+		case 'e':
+			opts.coverage = true;
+			break;
+
+		case 'f':
+			opts.fastforward = true;
+			break;
+
 		case 'g':
 			opts.getpc = 1;
 			break;
@@ -919,11 +1235,19 @@ int main(int argc, char *argv[])
 			opts.interactive = true;
 			break;
 
+		case 'j':
+			opts.threads = atoi(optarg);
+			break;
+
 		case 'l':
 			list_tests();
 			return 0;
 			break;
 
+		case 'L':
+			opts.livelock = true;
+			break;
+
 		case 'o':
 			if (strncasecmp(optarg, "0x", 2) == 0)
 				opts.offset = strtol(optarg+2, NULL, 16); // hex vvalue
@@ -933,11 +1257,19 @@ int main(int argc, char *argv[])
 			break;
 
 
+		case 'O':
+			opts.opcodestats++;
+			break;
+
 		case 'p':
 			opts.profile_file = strdup(optarg);
 			printf("profile %s\n", opts.profile_file);
 			break;
 
+		case 'R':
+			opts.replayfile = strdup(optarg);
+			break;
+
 		case 's':
 			opts.steps = atoi(optarg);
 			break;
@@ -951,6 +1283,10 @@ int main(int argc, char *argv[])
 			opts.testnumber = atoi(optarg);
 			break;
 
+		case 'T':
+			opts.tracefile = strdup(optarg);
+			break;
+
 		case 'v':
 			opts.verbose++;
 			break;
@@ -968,6 +1304,11 @@ int main(int argc, char *argv[])
 	}
 	printf("verbose = %i\n", opts.verbose);
 
+	if ( opts.replayfile != NULL )
+		return replay();
+
+	signal(SIGINT, sigint_cancel);
+
 	struct emu *e = emu_new();
 	if ( prepare(e) == 0 )
 	{
@@ -996,6 +1337,9 @@ int main(int argc, char *argv[])
 	if (opts.profile_file)
 		free(opts.profile_file);
 
+	if (opts.tracefile)
+		free(opts.tracefile);
+
 	if (opts.scode)
 		free(opts.scode);
 